@@ -91,7 +91,8 @@ void convert(const uint8_t* eeprom, const size_t size) {
         config.bssid[ei] = *dp++;
         Serial.printf(":%02x", config.bssid[ei]);
       }
-      config.dhcp = *dp++;
+      config.dhcp = AC_CREDT_DHCP(*dp);
+      config.channel = AC_CREDT_CHANNEL(*dp++);
       if (config.dhcp == STA_STATIC) {
         for (uint8_t e = 0; e < sizeof(station_config_t::_config::addr) / sizeof(uint32_t); e++) {
           uint32_t* ip = &config.config.addr[e];
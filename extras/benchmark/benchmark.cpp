@@ -0,0 +1,509 @@
+/**
+ *  The host benchmark of AutoConnect. It builds the library with the
+ *  real PageBuilder and ArduinoJson on the ESP8266 mock core, serves
+ *  the pages of the Elements, the FSBrowser and the Update examples
+ *  with the mock web server, and measures the time, the allocations and
+ *  the heap of each process. The results can be recorded into the CSV
+ *  file that is kept in the tree, and each run is compared with the
+ *  last record of the same options.
+ *  Usage: benchmark [-c] [-n iterations] [-b baseline.csv] [-r record.csv]
+ *         [-o options] [-v revision] [-p pagebuilder] [-j arduinojson]
+ *    -c  Run the checks only, exits with 1 if any check fails.
+ *  @file   benchmark.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include <getopt.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+#include <ESP8266HTTPClient.h>
+#include <EEPROM.h>
+#include <FS.h>
+#include <StreamString.h>
+#include <AutoConnect.h>
+#include <AutoConnectCredential.h>
+#include "MockHeap.h"
+#include "pages.h"
+
+#define BENCH_SSID        "ac-benchmark"
+#define BENCH_PSK         "password"
+#define BENCH_ITERATIONS  200
+#define BENCH_FLASH_ITERATIONS  20
+#define BENCH_UPDATE_HOST "192.168.1.10"
+#define BENCH_UPDATE_PORT 8000
+
+namespace {
+
+/** A result of a scenario */
+typedef struct {
+  std::string   name;       /**< Scenario name */
+  unsigned int  iterations; /**< Number of the iterations */
+  double  usec;             /**< Elapsed time per iteration [us] */
+  double  allocs;           /**< Allocations per iteration */
+  double  bytes;            /**< Bytes allocated per iteration */
+  size_t  peak;             /**< The highest heap in use above the start [bytes] */
+  long    leak;             /**< Heap left in use after all iterations [bytes] */
+  double  sent;             /**< Bytes sent to the client per iteration */
+} ResultST;
+
+/** The environment of a run that is recorded with the results */
+typedef struct {
+  std::string revision;     /**< Revision of the library */
+  std::string options;      /**< Compile options */
+  std::string pageBuilder;  /**< PageBuilder version */
+  std::string arduinoJson;  /**< ArduinoJson version */
+} RunST;
+
+// A sink that only counts the bytes to measure the generation of the
+// content without the cost of sending.
+class CountingPrint : public Print {
+ public:
+  CountingPrint() : count(0) {}
+  size_t  write(uint8_t c) override { (void)(c); count++; return 1; }
+  size_t  write(const uint8_t* buffer, size_t size) override { (void)(buffer); count += size; return size; }
+  size_t  count;
+};
+
+unsigned int  _failures = 0;
+
+void _check(const bool cond, const char* what) {
+  if (!cond) {
+    fprintf(stderr, "FAIL: %s\n", what);
+    _failures++;
+  }
+  else
+    fprintf(stderr, "ok: %s\n", what);
+}
+
+/**
+ *  Run the scenario after one warm-up, the first run settles the
+ *  caches of the library and the mock core.
+ */
+template<typename F>
+ResultST _measure(const char* name, const unsigned int iterations, F fn) {
+  fn();
+  const size_t  origin = MockHeap::stats().current;
+  MockHeap::reset();
+  size_t  sent = 0;
+  const std::chrono::steady_clock::time_point  start = std::chrono::steady_clock::now();
+  for (unsigned int n = 0; n < iterations; n++)
+    sent += fn();
+  const std::chrono::steady_clock::time_point  end = std::chrono::steady_clock::now();
+  const MockHeapST& st = MockHeap::stats();
+
+  ResultST  result;
+  result.name = name;
+  result.iterations = iterations;
+  result.usec = std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+  result.allocs = static_cast<double>(st.count) / iterations;
+  result.bytes = static_cast<double>(st.bytes) / iterations;
+  result.peak = st.peak > origin ? st.peak - origin : 0;
+  result.leak = static_cast<long>(st.current) - static_cast<long>(origin);
+  result.sent = static_cast<double>(sent) / iterations;
+  return result;
+}
+
+/**
+ *  Extract the body of the response captured, the chunked transfer is
+ *  decoded.
+ */
+std::string _body(const String& response) {
+  const std::string raw(response.c_str(), response.length());
+  const size_t  eoh = raw.find("\r\n\r\n");
+  if (eoh == std::string::npos)
+    return std::string();
+  std::string body = raw.substr(eoh + 4);
+  if (raw.substr(0, eoh).find("Transfer-Encoding: chunked") == std::string::npos)
+    return body;
+
+  std::string decoded;
+  size_t  pos = 0;
+  while (pos < body.size()) {
+    const size_t  eol = body.find("\r\n", pos);
+    if (eol == std::string::npos)
+      break;
+    const size_t  size = strtoul(body.substr(pos, eol - pos).c_str(), nullptr, 16);
+    if (!size)
+      break;
+    decoded += body.substr(eol + 2, size);
+    pos = eol + 2 + size + 2;
+  }
+  return decoded;
+}
+
+bool _contains(const std::string& content, const char* s) {
+  return content.find(s) != std::string::npos;
+}
+
+/** FSBrowser content type mapping */
+String _getContentType(const String& filename) {
+  if (filename.endsWith(".htm") || filename.endsWith(".html"))
+    return String(F("text/html"));
+  else if (filename.endsWith(".css"))
+    return String(F("text/css"));
+  else if (filename.endsWith(".js"))
+    return String(F("application/javascript"));
+  return String(F("text/plain"));
+}
+
+/**
+ *  The portal serving the pages of the examples.
+ */
+class Bench {
+ public:
+  Bench() : portal(server), FSBedit("/edit", "Edit"), FSBlist("/list?dir=\"/\"", "List") {}
+
+  bool  setup(void) {
+    // The access point and the update server around the mock station.
+    ESP8266WiFiClass::MockNetworkST network = { String(BENCH_SSID), String(BENCH_PSK), { 0x24, 0x0a, 0xc4, 0x01, 0x02, 0x03 }, -52, 6 };
+    WiFi.mockNetwork(network);
+    HTTPClient::mockServer = [](const String& host, uint16_t port, const String& uri, HTTPClient::MockReplyST& reply) {
+      if (host != BENCH_UPDATE_HOST || port != BENCH_UPDATE_PORT || !uri.startsWith(AUTOCONNECT_UPDATE_CATALOG))
+        return false;
+      reply.code = HTTP_CODE_OK;
+      reply.body = String(FPSTR(UPDATE_CATALOG));
+      reply.headers.push_back(std::make_pair(String(F("Content-Type")), String(F("application/json"))));
+      return true;
+    };
+
+    // examples/FSBrowser serves the files with the not found handler.
+    SPIFFS.begin();
+    File  index = SPIFFS.open("/index.htm", "w");
+    for (int n = 0; n < 64; n++)
+      index.print(F("<p>AutoConnect FSBrowser benchmark content line.</p>\n"));
+    index.close();
+    portal.onNotFound([this]() {
+      const String  path = server.uri();
+      if (SPIFFS.exists(path)) {
+        File  file = SPIFFS.open(path, "r");
+        server.streamFile(file, _getContentType(path));
+        file.close();
+      }
+      else
+        server.send(404, "text/plain", "FileNotFound");
+    });
+
+    // examples/Elements
+    elementsAux.load(FPSTR(PAGE_ELEMENTS));
+    saveAux.load(FPSTR(PAGE_SAVE));
+    saveAux.on([this](AutoConnectAux& aux, PageArgument& arg) {
+      (void)(arg);
+      StreamString  echo;
+      aux["caption"].value = String(F("Elements have been saved to /elements.json"));
+      elementsAux.saveElement(echo, { "text", "check", "input", "radio", "select" });
+      aux["echo"].value = echo;
+      return String();
+    });
+
+    // examples/Update
+    setupPage.load(FPSTR(PAGE_SETUP));
+    setupPage["server"].value = BENCH_UPDATE_HOST;
+    setupPage["port"].value = String(BENCH_UPDATE_PORT);
+    setupPage["path"].value = "bin";
+    applyPage.load(FPSTR(PAGE_APPLY));
+
+    config.title = "Benchmark";
+    config.ticker = false;
+    portal.config(config);
+    portal.join({ elementsAux, saveAux, FSBedit, FSBlist, setupPage, applyPage });
+    // The portal owns the attached update and deletes it with end.
+    AutoConnectUpdate*  update = new AutoConnectUpdate(BENCH_UPDATE_HOST, BENCH_UPDATE_PORT, "bin");
+    update->attach(portal);
+    return portal.begin(BENCH_SSID, BENCH_PSK);
+  }
+
+  size_t  request(const HTTPMethod method, const char* uri, const std::vector<std::pair<String, String>>& args = {}) {
+    ESP8266WebServer::MockRequestST request;
+    request.method = method;
+    request.uri = uri;
+    request.args = args;
+    request.headers.push_back(std::make_pair(String(F("Host")), WiFi.localIP().toString()));
+    request.remote = IPAddress(192, 168, 1, 2);
+    server.mockRequest(request);
+    portal.handleClient();
+    return server.mockResponse().bytes;
+  }
+
+  /** Request and return the body received with the status code */
+  std::string content(const HTTPMethod method, const char* uri, int* code, const std::vector<std::pair<String, String>>& args = {}) {
+    WiFiClient::mockCapture = true;
+    request(method, uri, args);
+    WiFiClient::mockCapture = false;
+    *code = server.mockResponse().code;
+    return _body(server.mockContent());
+  }
+
+  ESP8266WebServer  server;
+  AutoConnect       portal;
+  AutoConnectConfig config;
+  AutoConnectAux    elementsAux;
+  AutoConnectAux    saveAux;
+  AutoConnectAux    FSBedit;
+  AutoConnectAux    FSBlist;
+  AutoConnectAux    setupPage;
+  AutoConnectAux    applyPage;
+};
+
+// The submit of the Elements page posts its URI with the values.
+const std::vector<std::pair<String, String>>  _saveArgs = {
+  { String(AUTOCONNECT_AUXURI_PARAM), String("/elements") },
+  { String("check"), String("check") },
+  { String("input"), String("portal.local") },
+  { String("radio"), String("Button-3") },
+  { String("select"), String("Option-1") }
+};
+
+void _runChecks(Bench& bench) {
+  int code;
+  std::string body;
+
+  _check(WiFi.status() == WL_CONNECTED, "portal.begin connects to the mock access point");
+
+  body = bench.content(HTTP_GET, "/elements", &code);
+  _check(code == 200, "GET /elements responds 200");
+  _check(_contains(body, "Radio buttons") && _contains(body, "Option-3") && _contains(body, "name=\"input\""), "GET /elements contains the elements");
+
+  body = bench.content(HTTP_POST, "/save", &code, _saveArgs);
+  _check(code == 200, "POST /save responds 200");
+  _check(_contains(body, "Elements have been saved"), "POST /save contains the caption");
+  _check(_contains(body, "portal.local"), "POST /save echoes the stored input");
+  _check(bench.elementsAux["radio"].as<AutoConnectRadio>().value() == "Button-3", "POST /save stores the radio");
+
+  body = bench.content(HTTP_GET, AUTOCONNECT_URI, &code);
+  _check(code == 200, "GET " AUTOCONNECT_URI " responds 200");
+  _check(_contains(body, "/edit") && _contains(body, "List") && _contains(body, "Benchmark"), "GET " AUTOCONNECT_URI " menu contains the FSBrowser pages");
+
+  body = bench.content(HTTP_GET, "/index.htm", &code);
+  _check(code == 200 && _contains(body, "FSBrowser benchmark"), "GET /index.htm is served by the FSBrowser not found handler");
+
+  body = bench.content(HTTP_GET, "/setup", &code);
+  _check(code == 200 && _contains(body, "Update server"), "GET /setup responds the Update setup page");
+
+  body = bench.content(HTTP_GET, AUTOCONNECT_URI_UPDATE, &code);
+  _check(code == 200, "GET " AUTOCONNECT_URI_UPDATE " responds 200");
+  _check(_contains(body, "mqttRSSI.ino.bin") && _contains(body, "Elements.ino.bin.gz"), "GET " AUTOCONNECT_URI_UPDATE " lists the bin entries of the catalog");
+  _check(!_contains(body, "update.ino<") && !_contains(body, ">archives<"), "GET " AUTOCONNECT_URI_UPDATE " excludes the other entries");
+
+  {
+    AutoConnectAux  aux;
+    _check(aux.load(FPSTR(PAGE_ELEMENTS)) && aux.getElements().size() == 8, "aux.load loads all elements");
+    bool  html = true;
+    for (AutoConnectElement& element : aux.getElements()) {
+      CountingPrint sink;
+      const String  s = element.toHTML();
+      element.emit(sink);
+      html &= s.length() == sink.count;
+    }
+    _check(html, "element.emit writes the same length as element.toHTML");
+
+    // The items are converted to String on each read, which must not
+    // consume the stored item.
+    const AutoConnectRadio&  radio = aux["radio"].as<AutoConnectRadio>();
+    const AutoConnectSelect& select = aux["select"].as<AutoConnectSelect>();
+    const String  radioValue = radio.value();
+    const String  radioItem = radio.at(1);
+    const String  selectValue = select.value();
+    const String  selectItem = select[2];
+    _check(radioValue == "Button-1" && radio.value() == radioValue, "AutoConnectRadio::value read twice is unchanged");
+    _check(radioItem == "Button-2" && radio.at(1) == radioItem && radio[1] == radioItem, "AutoConnectRadio::at read twice is unchanged");
+    _check(selectValue == "Option-2" && select.value() == selectValue, "AutoConnectSelect::value read twice is unchanged");
+    _check(selectItem == "Option-3" && select[2] == selectItem && select.at(2) == selectItem, "AutoConnectSelect::operator[] read twice is unchanged");
+  }
+
+  {
+    AutoConnectCredential credential;
+    station_config_t  config;
+    memset(&config, 0x00, sizeof(config));
+    strncpy(reinterpret_cast<char*>(config.ssid), BENCH_SSID "-cred", sizeof(config.ssid));
+    strncpy(reinterpret_cast<char*>(config.password), BENCH_PSK, sizeof(config.password));
+    const size_t  commits = EEPROMClass::mockCommits();
+    _check(credential.save(&config), "credential.save saves to the mock EEPROM");
+    _check(EEPROMClass::mockCommits() > commits, "credential.save commits the mock EEPROM");
+    memset(config.password, 0x00, sizeof(config.password));
+    _check(credential.load(BENCH_SSID "-cred", &config) >= 0 && !strcmp(reinterpret_cast<const char*>(config.password), BENCH_PSK), "credential.load restores the saved entry");
+    _check(credential.del(BENCH_SSID "-cred") && credential.load(BENCH_SSID "-cred", &config) < 0, "credential.del removes the entry");
+  }
+}
+
+std::vector<ResultST> _runBench(Bench& bench, const unsigned int iterations) {
+  std::vector<ResultST> results;
+
+  results.push_back(_measure("aux.load", iterations, []() {
+    AutoConnectAux  aux;
+    aux.load(FPSTR(PAGE_ELEMENTS));
+    return static_cast<size_t>(0);
+  }));
+
+  AutoConnectElementVT& elements = bench.elementsAux.getElements();
+  results.push_back(_measure("element.toHTML", iterations, [&]() {
+    size_t  len = 0;
+    for (AutoConnectElement& element : elements)
+      len += element.toHTML().length();
+    return len;
+  }));
+  results.push_back(_measure("element.emit", iterations, [&]() {
+    CountingPrint sink;
+    for (AutoConnectElement& element : elements)
+      element.emit(sink);
+    return sink.count;
+  }));
+
+  results.push_back(_measure("page.elements", iterations, [&]() { return bench.request(HTTP_GET, "/elements"); }));
+  results.push_back(_measure("page.save", iterations, [&]() { return bench.request(HTTP_POST, "/save", _saveArgs); }));
+  results.push_back(_measure("page.menu", iterations, [&]() { return bench.request(HTTP_GET, AUTOCONNECT_URI); }));
+  results.push_back(_measure("page.fsbrowser", iterations, [&]() { return bench.request(HTTP_GET, "/index.htm"); }));
+  results.push_back(_measure("page.setup", iterations, [&]() { return bench.request(HTTP_GET, "/setup"); }));
+  results.push_back(_measure("page.update", iterations, [&]() { return bench.request(HTTP_GET, AUTOCONNECT_URI_UPDATE); }));
+
+  AutoConnectCredential credential;
+  station_config_t  config;
+  memset(&config, 0x00, sizeof(config));
+  strncpy(reinterpret_cast<char*>(config.ssid), BENCH_SSID "-cred", sizeof(config.ssid));
+  strncpy(reinterpret_cast<char*>(config.password), BENCH_PSK, sizeof(config.password));
+  const unsigned int  flashIterations = iterations < BENCH_FLASH_ITERATIONS ? iterations : BENCH_FLASH_ITERATIONS;
+  results.push_back(_measure("credential.save", flashIterations, [&]() {
+    credential.save(&config);
+    return static_cast<size_t>(0);
+  }));
+  results.push_back(_measure("credential.load", iterations, [&]() {
+    credential.load(BENCH_SSID "-cred", &config);
+    return static_cast<size_t>(0);
+  }));
+  credential.del(BENCH_SSID "-cred");
+  return results;
+}
+
+// The columns of the results file.
+const char  _csvHeader[] = "date,revision,options,pagebuilder,arduinojson,scenario,iterations,usec_op,allocs_op,bytes_op,peak,leak,sent_op";
+
+std::vector<std::string> _split(const std::string& line) {
+  std::vector<std::string>  fields;
+  std::string field;
+  std::istringstream  ss(line);
+  while (std::getline(ss, field, ','))
+    fields.push_back(field);
+  return fields;
+}
+
+/** The last record of each scenario with the same options */
+std::map<std::string, ResultST> _loadBaseline(const char* path, const RunST& run, std::string& revision) {
+  std::map<std::string, ResultST> baseline;
+  std::ifstream in(path);
+  std::string line;
+  while (std::getline(in, line)) {
+    const std::vector<std::string>  f = _split(line);
+    if (f.size() < 13 || f[0] == "date" || f[2] != run.options)
+      continue;
+    ResultST  r = { f[5], static_cast<unsigned int>(std::stoul(f[6])), std::stod(f[7]), std::stod(f[8]), std::stod(f[9]), std::stoul(f[10]), std::stol(f[11]), std::stod(f[12]) };
+    baseline[r.name] = r;
+    revision = f[1];
+  }
+  return baseline;
+}
+
+std::string _delta(const double now, const double base) {
+  char  s[16];
+  if (base == 0)
+    snprintf(s, sizeof(s), "%s", now == 0 ? "=" : "new");
+  else
+    snprintf(s, sizeof(s), "%+.1f%%", (now - base) * 100 / base);
+  return std::string(s);
+}
+
+void _report(const std::vector<ResultST>& results, const std::map<std::string, ResultST>& baseline, const std::string& baseRevision) {
+  printf("%-16s %6s %10s %9s %10s %7s %6s %9s", "scenario", "iter", "usec/op", "allocs/op", "bytes/op", "peak", "leak", "sent/op");
+  if (baseline.size())
+    printf("  vs %s: %8s %9s %8s", baseRevision.c_str(), "usec", "allocs", "peak");
+  printf("\n");
+  for (const ResultST& r : results) {
+    printf("%-16s %6u %10.2f %9.1f %10.1f %7zu %6ld %9.1f", r.name.c_str(), r.iterations, r.usec, r.allocs, r.bytes, r.peak, r.leak, r.sent);
+    auto  it = baseline.find(r.name);
+    if (it != baseline.end())
+      printf("  %*s  %8s %9s %8s", static_cast<int>(baseRevision.size() + 2), "", _delta(r.usec, it->second.usec).c_str(), _delta(r.allocs, it->second.allocs).c_str(), _delta(static_cast<double>(r.peak), static_cast<double>(it->second.peak)).c_str());
+    printf("\n");
+  }
+}
+
+bool _record(const char* path, const std::vector<ResultST>& results, const RunST& run) {
+  std::ifstream exists(path);
+  const bool  header = !exists.good() || exists.peek() == std::ifstream::traits_type::eof();
+  exists.close();
+  FILE* fp = fopen(path, "a");
+  if (!fp)
+    return false;
+  if (header)
+    fprintf(fp, "%s\n", _csvHeader);
+  char  date[16];
+  const time_t  now = time(nullptr);
+  strftime(date, sizeof(date), "%Y-%m-%d", gmtime(&now));
+  for (const ResultST& r : results)
+    fprintf(fp, "%s,%s,%s,%s,%s,%s,%u,%.2f,%.1f,%.1f,%zu,%ld,%.1f\n", date, run.revision.c_str(), run.options.c_str(), run.pageBuilder.c_str(), run.arduinoJson.c_str(), r.name.c_str(), r.iterations, r.usec, r.allocs, r.bytes, r.peak, r.leak, r.sent);
+  fclose(fp);
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  bool  checkOnly = false;
+  unsigned int  iterations = BENCH_ITERATIONS;
+  const char* baselinePath = nullptr;
+  const char* recordPath = nullptr;
+  RunST run = { "unknown", "default", "unknown", "unknown" };
+  int opt;
+  while ((opt = getopt(argc, argv, "cn:b:r:o:v:p:j:")) != -1) {
+    switch (opt) {
+    case 'c': checkOnly = true; break;
+    case 'n': iterations = static_cast<unsigned int>(atoi(optarg)); break;
+    case 'b': baselinePath = optarg; break;
+    case 'r': recordPath = optarg; break;
+    // A comma would break the column of the results.
+    case 'o': run.options = *optarg ? optarg : "default"; std::replace(run.options.begin(), run.options.end(), ',', ' '); break;
+    case 'v': run.revision = optarg; break;
+    case 'p': run.pageBuilder = optarg; break;
+    case 'j': run.arduinoJson = optarg; break;
+    default:
+      fprintf(stderr, "usage: %s [-c] [-n iterations] [-b baseline.csv] [-r record.csv] [-o options] [-v revision] [-p pagebuilder] [-j arduinojson]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!iterations)
+    iterations = 1;
+
+  std::unique_ptr<Bench>  bench(new Bench());
+  const bool  started = bench->setup();
+  MockHeap::base();
+  _check(started, "portal.begin returns true");
+  _runChecks(*bench);
+  if (_failures) {
+    fprintf(stderr, "%u check(s) failed\n", _failures);
+    return 1;
+  }
+  if (checkOnly)
+    return 0;
+
+  const std::vector<ResultST> results = _runBench(*bench, iterations);
+  std::string baseRevision;
+  std::map<std::string, ResultST> baseline;
+  if (baselinePath)
+    baseline = _loadBaseline(baselinePath, run, baseRevision);
+  printf("# revision %s, options %s, PageBuilder %s, ArduinoJson %s\n", run.revision.c_str(), run.options.c_str(), run.pageBuilder.c_str(), run.arduinoJson.c_str());
+  _report(results, baseline, baseRevision);
+  if (recordPath && !_record(recordPath, results, run)) {
+    fprintf(stderr, "%s cannot be written\n", recordPath);
+    return 1;
+  }
+  return 0;
+}
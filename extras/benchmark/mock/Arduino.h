@@ -0,0 +1,68 @@
+/**
+ *  The mock of the ESP8266 Arduino core for the host benchmark. It
+ *  provides only what AutoConnect, PageBuilder and ArduinoJson use on
+ *  the host, and is not a general emulation of the core.
+ *  @file   Arduino.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "pgmspace.h"
+
+#define HIGH          0x1
+#define LOW           0x0
+#define INPUT         0x00
+#define INPUT_PULLUP  0x02
+#define OUTPUT        0x01
+#define LED_BUILTIN   2
+#define SS            15
+
+#define ICACHE_FLASH_ATTR
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+#define _min(a, b)    ((a) < (b) ? (a) : (b))
+#define _max(a, b)    ((a) > (b) ? (a) : (b))
+
+void  pinMode(uint8_t pin, uint8_t mode);
+void  digitalWrite(uint8_t pin, uint8_t val);
+int   digitalRead(uint8_t pin);
+void  analogWrite(uint8_t pin, int val);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void  delay(unsigned long ms);
+void  delayMicroseconds(unsigned int us);
+void  yield(void);
+void  esp_yield(void);
+
+long  random(long howbig);
+long  random(long howsmall, long howbig);
+void  randomSeed(unsigned long seed);
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+
+#endif // !Arduino_h
@@ -0,0 +1,35 @@
+/**
+ *  DNSServer of the mock core. It replies nothing.
+ *  @file   DNSServer.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_DNSSERVER_H_
+#define _MOCK_DNSSERVER_H_
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+enum class DNSReplyCode {
+  NoError = 0,
+  FormError = 1,
+  ServerFailure = 2,
+  NonExistentDomain = 3,
+  NotImplemented = 4,
+  Refused = 5
+};
+
+class DNSServer {
+ public:
+  DNSServer() {}
+  bool  start(const uint16_t& port, const String& domainName, const IPAddress& resolvedIP) { (void)(port); (void)(domainName); (void)(resolvedIP); return true; }
+  void  processNextRequest(void) {}
+  void  setErrorReplyCode(const DNSReplyCode& replyCode) { (void)(replyCode); }
+  void  setTTL(const uint32_t& ttl) { (void)(ttl); }
+  void  stop(void) {}
+};
+
+#endif // !_MOCK_DNSSERVER_H_
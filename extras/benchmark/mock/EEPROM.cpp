@@ -0,0 +1,82 @@
+/**
+ *  EEPROM implementation of the mock core.
+ *  @file   EEPROM.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include <stdlib.h>
+#include "EEPROM.h"
+
+namespace {
+
+uint8_t _sector[MOCK_EEPROM_SECTOR_SIZE];
+size_t  _commits = 0;
+
+// Erase the sector before the first access as the flash erased.
+struct _SectorInit {
+  _SectorInit() { EEPROMClass::mockErase(); }
+} _sectorInit;
+
+} // namespace
+
+void EEPROMClass::begin(size_t size) {
+  if (size == 0 || size > MOCK_EEPROM_SECTOR_SIZE)
+    return;
+  size = (size + 3) & ~static_cast<size_t>(3);
+  if (_data && size != _size) {
+    free(_data);
+    _data = nullptr;
+  }
+  if (!_data)
+    _data = static_cast<uint8_t*>(malloc(size));
+  _size = size;
+  memcpy(_data, _sector, _size);
+  _dirty = false;
+}
+
+void EEPROMClass::write(int const address, uint8_t const val) {
+  if (address < 0 || static_cast<size_t>(address) >= _size)
+    return;
+  if (_data[address] != val) {
+    _data[address] = val;
+    _dirty = true;
+  }
+}
+
+bool EEPROMClass::commit(void) {
+  if (!_size)
+    return false;
+  if (!_dirty)
+    return true;
+  if (!_data)
+    return false;
+  memcpy(_sector, _data, _size);
+  _commits++;
+  _dirty = false;
+  return true;
+}
+
+bool EEPROMClass::end(void) {
+  bool  retval = commit();
+  if (_data)
+    free(_data);
+  _data = nullptr;
+  _size = 0;
+  _dirty = false;
+  return retval;
+}
+
+void EEPROMClass::mockErase(void) {
+  memset(_sector, 0xff, sizeof(_sector));
+}
+
+size_t EEPROMClass::mockCommits(void) {
+  return _commits;
+}
+
+#if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_EEPROM)
+EEPROMClass EEPROM;
+#endif
@@ -0,0 +1,68 @@
+/**
+ *  EEPROM of the mock core. All instances share one sector emulated in
+ *  the host memory, which is erased at the start of the process, so the
+ *  benchmark never touches a real credential store. As same as the core,
+ *  begin allocates the buffer from the heap and end writes it back.
+ *  @file   EEPROM.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_EEPROM_H_
+#define _MOCK_EEPROM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define MOCK_EEPROM_SECTOR_SIZE 4096
+
+class EEPROMClass {
+ public:
+  EEPROMClass() : _data(nullptr), _size(0), _dirty(false) {}
+  explicit EEPROMClass(uint32_t sector) : EEPROMClass() { (void)(sector); }
+  ~EEPROMClass() { end(); }
+
+  void  begin(size_t size);
+  uint8_t read(int const address) { return address >= 0 && static_cast<size_t>(address) < _size ? _data[address] : 0; }
+  void  write(int const address, uint8_t const val);
+  bool  commit(void);
+  bool  end(void);
+  uint8_t*  getDataPtr(void) { _dirty = true; return _data; }
+  uint8_t const*  getConstDataPtr(void) const { return _data; }
+  size_t  length(void) { return _size; }
+  uint8_t&  operator[](int const address) { return getDataPtr()[address]; }
+  uint8_t const&  operator[](int const address) const { return getConstDataPtr()[address]; }
+
+  template<typename T>
+  T&  get(int const address, T& t) {
+    if (address >= 0 && address + sizeof(T) <= _size)
+      memcpy(reinterpret_cast<uint8_t*>(&t), _data + address, sizeof(T));
+    return t;
+  }
+
+  template<typename T>
+  const T&  put(int const address, const T& t) {
+    if (address >= 0 && address + sizeof(T) <= _size) {
+      memcpy(_data + address, reinterpret_cast<const uint8_t*>(&t), sizeof(T));
+      _dirty = true;
+    }
+    return t;
+  }
+
+  static void mockErase(void);              /**< Erase the emulated sector */
+  static size_t mockCommits(void);          /**< Number of the sector writes */
+
+ protected:
+  uint8_t*  _data;
+  size_t    _size;
+  bool      _dirty;
+};
+
+#if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_EEPROM)
+extern EEPROMClass EEPROM;
+#endif
+
+#endif // !_MOCK_EEPROM_H_
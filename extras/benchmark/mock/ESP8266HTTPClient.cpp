@@ -0,0 +1,94 @@
+/**
+ *  HTTPClient implementation of the mock core.
+ *  @file   ESP8266HTTPClient.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include "ESP8266HTTPClient.h"
+
+HTTPClient::MockServerT HTTPClient::mockServer;
+
+bool HTTPClient::begin(WiFiClient& client, const String& host, uint16_t port, const String& uri, bool https) {
+  (void)(client);
+  (void)(https);
+  _host = host;
+  _port = port;
+  _uri = uri;
+  _code = 0;
+  return true;
+}
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+  String  host = url;
+  int     scheme = host.indexOf(F("://"));
+  if (scheme >= 0)
+    host = host.substring(scheme + 3);
+  String  uri = String('/');
+  int     path = host.indexOf('/');
+  if (path >= 0) {
+    uri = host.substring(path);
+    host = host.substring(0, path);
+  }
+  uint16_t  port = 80;
+  int     colon = host.indexOf(':');
+  if (colon >= 0) {
+    port = static_cast<uint16_t>(host.substring(colon + 1).toInt());
+    host = host.substring(0, colon);
+  }
+  return begin(client, host, port, uri);
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+  _headerKeys.clear();
+  for (size_t i = 0; i < headerKeysCount; i++)
+    _headerKeys.push_back(String(headerKeys[i]));
+}
+
+String HTTPClient::header(const char* name) {
+  for (const std::pair<String, String>& h : _reply.headers)
+    if (h.first.equalsIgnoreCase(name))
+      return h.second;
+  return String();
+}
+
+String HTTPClient::header(size_t i) {
+  return i < _reply.headers.size() ? _reply.headers[i].second : String();
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+  for (const std::pair<String, String>& h : _reply.headers)
+    if (h.first.equalsIgnoreCase(name))
+      return true;
+  return false;
+}
+
+int HTTPClient::GET(void) {
+  _reply.code = HTTPC_ERROR_CONNECTION_REFUSED;
+  _reply.body = String();
+  _reply.headers.clear();
+  if (!mockServer || !mockServer(_host, _port, _uri, _reply)) {
+    _code = HTTPC_ERROR_CONNECTION_REFUSED;
+    return _code;
+  }
+  _code = _reply.code;
+  _client = WiFiClient(WiFiClient::mockOpen(IPAddress(192, 168, 1, 1), _code > 0 ? _reply.body : String()));
+  return _code;
+}
+
+String HTTPClient::errorToString(int error) {
+  switch (error) {
+  case HTTPC_ERROR_CONNECTION_REFUSED:
+    return F("connection refused");
+  case HTTPC_ERROR_NOT_CONNECTED:
+    return F("not connected");
+  case HTTPC_ERROR_CONNECTION_LOST:
+    return F("connection lost");
+  case HTTPC_ERROR_READ_TIMEOUT:
+    return F("read Timeout");
+  default:
+    return String();
+  }
+}
@@ -0,0 +1,91 @@
+/**
+ *  HTTPClient of the mock core. The request is answered by the handler
+ *  which the benchmark placed with mockServer instead of the network.
+ *  @file   ESP8266HTTPClient.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_ESP8266HTTPCLIENT_H_
+#define _MOCK_ESP8266HTTPCLIENT_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED  (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_NO_STREAM           (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER      (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM        (-8)
+#define HTTPC_ERROR_ENCODING            (-9)
+#define HTTPC_ERROR_STREAM_WRITE        (-10)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+typedef enum {
+  HTTP_CODE_OK = 200,
+  HTTP_CODE_PARTIAL_CONTENT = 206,
+  HTTP_CODE_MOVED_PERMANENTLY = 301,
+  HTTP_CODE_FOUND = 302,
+  HTTP_CODE_NOT_MODIFIED = 304,
+  HTTP_CODE_BAD_REQUEST = 400,
+  HTTP_CODE_UNAUTHORIZED = 401,
+  HTTP_CODE_FORBIDDEN = 403,
+  HTTP_CODE_NOT_FOUND = 404,
+  HTTP_CODE_INTERNAL_SERVER_ERROR = 500
+} t_http_codes;
+
+class HTTPClient {
+ public:
+  /** A response of the mock server */
+  typedef struct {
+    int     code;                                   /**< Status code, or HTTPC_ERROR */
+    String  body;                                   /**< Response body */
+    std::vector<std::pair<String, String>>  headers;  /**< Response headers */
+  } MockReplyST;
+  typedef std::function<bool(const String& host, uint16_t port, const String& uri, MockReplyST& reply)> MockServerT;
+
+  HTTPClient() : _port(0), _code(0) {}
+  ~HTTPClient() { end(); }
+
+  bool  begin(WiFiClient& client, const String& host, uint16_t port, const String& uri = String("/"), bool https = false);
+  bool  begin(WiFiClient& client, const String& url);
+  void  end(void) { _client.stop(); }
+  bool  connected(void) { return _client.connected(); }
+  void  setReuse(bool reuse) { (void)(reuse); }
+  void  setUserAgent(const String& userAgent) { (void)(userAgent); }
+  void  setAuthorization(const char* user, const char* password) { (void)(user); (void)(password); }
+  void  setTimeout(uint16_t timeout) { _client.setTimeout(timeout); }
+  void  setFollowRedirects(bool follow) { (void)(follow); }
+  void  addHeader(const String& name, const String& value, bool first = false, bool replace = true) { (void)(name); (void)(value); (void)(first); (void)(replace); }
+  void  collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+  String  header(const char* name);
+  String  header(size_t i);
+  bool  hasHeader(const char* name);
+  int   GET(void);
+  int   getSize(void) { return _code > 0 ? static_cast<int>(_reply.body.length()) : -1; }
+  WiFiClient& getStream(void) { return _client; }
+  WiFiClient* getStreamPtr(void) { return &_client; }
+  String  getString(void) { return _reply.body; }
+  static String errorToString(int error);
+
+  static MockServerT  mockServer;   /**< The server which answers the requests */
+
+ protected:
+  WiFiClient  _client;
+  String    _host;
+  uint16_t  _port;
+  String    _uri;
+  int       _code;
+  MockReplyST _reply;
+  std::vector<String> _headerKeys;
+};
+
+#endif // !_MOCK_ESP8266HTTPCLIENT_H_
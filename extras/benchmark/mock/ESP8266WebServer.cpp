@@ -0,0 +1,315 @@
+/**
+ *  ESP8266WebServer implementation of the mock core.
+ *  @file   ESP8266WebServer.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include "ESP8266WebServer.h"
+
+namespace {
+
+// The request handler which the on function registers.
+class _FunctionRequestHandler : public RequestHandler {
+ public:
+  _FunctionRequestHandler(ESP8266WebServer::THandlerFunction fn, ESP8266WebServer::THandlerFunction ufn, const String& uri, HTTPMethod method)
+    : _fn(fn), _ufn(ufn), _uri(uri), _method(method) {}
+  bool  canHandle(HTTPMethod requestMethod, String requestUri) override {
+    return (_method == HTTP_ANY || _method == requestMethod) && requestUri == _uri;
+  }
+  bool  canUpload(String requestUri) override {
+    return _ufn && canHandle(HTTP_POST, requestUri);
+  }
+  bool  handle(ESP8266WebServer& server, HTTPMethod requestMethod, String requestUri) override {
+    (void)(server);
+    if (!canHandle(requestMethod, requestUri))
+      return false;
+    _fn();
+    return true;
+  }
+  void  upload(ESP8266WebServer& server, String requestUri, HTTPUpload& upload) override {
+    (void)(server);
+    (void)(upload);
+    if (canUpload(requestUri))
+      _ufn();
+  }
+
+ protected:
+  ESP8266WebServer::THandlerFunction  _fn;
+  ESP8266WebServer::THandlerFunction  _ufn;
+  String      _uri;
+  HTTPMethod  _method;
+};
+
+const char* _responseCodeToString(int code) {
+  switch (code) {
+  case 200: return "OK";
+  case 302: return "Found";
+  case 304: return "Not Modified";
+  case 400: return "Bad Request";
+  case 401: return "Unauthorized";
+  case 403: return "Forbidden";
+  case 404: return "Not Found";
+  case 500: return "Internal Server Error";
+  default:  return "";
+  }
+}
+
+} // namespace
+
+ESP8266WebServer::ESP8266WebServer(int port) {
+  (void)(port);
+}
+
+ESP8266WebServer::ESP8266WebServer(IPAddress addr, int port) {
+  (void)(addr);
+  (void)(port);
+}
+
+ESP8266WebServer::~ESP8266WebServer() {}
+
+void ESP8266WebServer::on(const String& uri, HTTPMethod method, THandlerFunction fn, THandlerFunction ufn) {
+  _ownHandlers.emplace_back(new _FunctionRequestHandler(fn, ufn, uri, method));
+  addHandler(_ownHandlers.back().get());
+}
+
+void ESP8266WebServer::addHandler(RequestHandler* handler) {
+  if (!_lastHandler) {
+    _firstHandler = handler;
+    _lastHandler = handler;
+  }
+  else {
+    _lastHandler->next(handler);
+    _lastHandler = handler;
+  }
+}
+
+void ESP8266WebServer::handleClient(void) {
+  if (!_pending)
+    return;
+  std::unique_ptr<MockRequestST>  request(std::move(_pending));
+
+  _currentClient = WiFiClient(WiFiClient::mockOpen(request->remote));
+  _currentMethod = request->method;
+  _currentUri = request->uri;
+  _currentArgs.clear();
+  for (const std::pair<String, String>& arg : request->args)
+    _currentArgs.push_back({ arg.first, arg.second });
+  _currentHeaders.clear();
+  _hostHeader = String();
+  for (const std::pair<String, String>& header : request->headers) {
+    if (header.first.equalsIgnoreCase(F("Host")))
+      _hostHeader = header.second;
+    for (const String& key : _collectKeys)
+      if (header.first.equalsIgnoreCase(key))
+        _currentHeaders.push_back({ key, header.second });
+  }
+  _responseHeaders = String();
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+  _chunked = false;
+  _response = { 0, String(), 0, false };
+
+  if (request->uploadName.length()) {
+    _currentUpload.reset(new HTTPUpload());
+    _currentUpload->name = request->uploadName;
+    _currentUpload->filename = request->uploadFile;
+    _currentUpload->type = String(F("application/octet-stream"));
+    _currentUpload->contentLength = request->uploadContent.length();
+    _upload(request->uploadContent);
+  }
+  _handleRequest();
+  _currentUpload.reset();
+
+  std::shared_ptr<WiFiClient::ConnectionST> conn = _currentClient.mockConnection();
+  _response.bytes = conn->txBytes;
+  _currentClient.stop();
+}
+
+void ESP8266WebServer::_handleRequest(void) {
+  bool  handled = false;
+  for (RequestHandler* handler = _firstHandler; handler; handler = handler->next()) {
+    if (handler->canHandle(_currentMethod, _currentUri)) {
+      handled = handler->handle(*this, _currentMethod, _currentUri);
+      if (handled)
+        break;
+    }
+  }
+  if (!handled) {
+    if (_notFoundHandler)
+      _notFoundHandler();
+    else
+      send(404, "text/plain", String(F("Not found: ")) + _currentUri);
+  }
+}
+
+void ESP8266WebServer::_upload(const String& content) {
+  RequestHandler* handler = _firstHandler;
+  while (handler && !handler->canUpload(_currentUri))
+    handler = handler->next();
+
+  auto  notify = [&]() {
+    if (_fileUploadHandler)
+      _fileUploadHandler();
+    if (handler)
+      handler->upload(*this, _currentUri, *_currentUpload);
+  };
+
+  _currentUpload->status = UPLOAD_FILE_START;
+  _currentUpload->totalSize = 0;
+  _currentUpload->currentSize = 0;
+  notify();
+  for (size_t pos = 0; pos < content.length(); pos += HTTP_UPLOAD_BUFLEN) {
+    const size_t  size = std::min(static_cast<size_t>(HTTP_UPLOAD_BUFLEN), content.length() - pos);
+    memcpy(_currentUpload->buf, content.c_str() + pos, size);
+    _currentUpload->status = UPLOAD_FILE_WRITE;
+    _currentUpload->currentSize = size;
+    notify();
+    _currentUpload->totalSize += size;
+  }
+  _currentUpload->status = UPLOAD_FILE_END;
+  _currentUpload->currentSize = 0;
+  notify();
+}
+
+const String& ESP8266WebServer::arg(const String& name) const {
+  for (const RequestArgument& arg : _currentArgs)
+    if (arg.key == name)
+      return arg.value;
+  return _empty;
+}
+
+const String& ESP8266WebServer::arg(int i) const {
+  return i >= 0 && static_cast<size_t>(i) < _currentArgs.size() ? _currentArgs[i].value : _empty;
+}
+
+const String& ESP8266WebServer::argName(int i) const {
+  return i >= 0 && static_cast<size_t>(i) < _currentArgs.size() ? _currentArgs[i].key : _empty;
+}
+
+bool ESP8266WebServer::hasArg(const String& name) const {
+  for (const RequestArgument& arg : _currentArgs)
+    if (arg.key == name)
+      return true;
+  return false;
+}
+
+void ESP8266WebServer::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+  _collectKeys.clear();
+  for (size_t i = 0; i < headerKeysCount; i++)
+    _collectKeys.push_back(String(headerKeys[i]));
+}
+
+const String& ESP8266WebServer::header(const String& name) const {
+  for (const RequestArgument& header : _currentHeaders)
+    if (header.key.equalsIgnoreCase(name))
+      return header.value;
+  return _empty;
+}
+
+const String& ESP8266WebServer::header(int i) const {
+  return i >= 0 && static_cast<size_t>(i) < _currentHeaders.size() ? _currentHeaders[i].value : _empty;
+}
+
+const String& ESP8266WebServer::headerName(int i) const {
+  return i >= 0 && static_cast<size_t>(i) < _currentHeaders.size() ? _currentHeaders[i].key : _empty;
+}
+
+bool ESP8266WebServer::hasHeader(const String& name) const {
+  for (const RequestArgument& header : _currentHeaders)
+    if (header.key.equalsIgnoreCase(name))
+      return true;
+  return false;
+}
+
+void ESP8266WebServer::_prepareHeader(String& response, int code, const char* content_type, size_t contentLength) {
+  response = String(F("HTTP/1.1 ")) + String(code) + ' ' + _responseCodeToString(code) + String(F("\r\n"));
+  if (!content_type)
+    content_type = "text/html";
+  response += String(F("Content-Type: ")) + content_type + String(F("\r\n"));
+  if (_contentLength == CONTENT_LENGTH_NOT_SET)
+    response += String(F("Content-Length: ")) + String(static_cast<unsigned long>(contentLength)) + String(F("\r\n"));
+  else if (_contentLength != CONTENT_LENGTH_UNKNOWN)
+    response += String(F("Content-Length: ")) + String(static_cast<unsigned long>(_contentLength)) + String(F("\r\n"));
+  else {
+    _chunked = true;
+    _response.chunked = true;
+    response += String(F("Transfer-Encoding: chunked\r\n"));
+  }
+  response += _keepAlive ? String(F("Connection: keep-alive\r\n")) : String(F("Connection: close\r\n"));
+  response += _responseHeaders;
+  response += String(F("\r\n"));
+  _responseHeaders = String();
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+  _response.code = code;
+  _response.contentType = content_type;
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const String& content) {
+  String  header;
+  _prepareHeader(header, code, content_type, content.length());
+  _write(header.c_str(), header.length());
+  if (content.length())
+    sendContent(content);
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const char* content, size_t contentLength) {
+  String  header;
+  _prepareHeader(header, code, content_type, contentLength);
+  _write(header.c_str(), header.length());
+  if (contentLength)
+    sendContent(content, contentLength);
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first) {
+  String  headerLine = name + String(F(": ")) + value + String(F("\r\n"));
+  if (first)
+    _responseHeaders = headerLine + _responseHeaders;
+  else
+    _responseHeaders += headerLine;
+}
+
+void ESP8266WebServer::sendContent(const char* content, size_t size) {
+  if (_chunked) {
+    char  chunkSize[11];
+    snprintf(chunkSize, sizeof(chunkSize), "%zx\r\n", size);
+    _write(chunkSize, strlen(chunkSize));
+  }
+  _write(content, size);
+  if (_chunked) {
+    _write("\r\n", 2);
+    if (!size)
+      _chunked = false;
+  }
+}
+
+size_t ESP8266WebServer::_write(const char* data, size_t size) {
+  return _currentClient.write(reinterpret_cast<const uint8_t*>(data), size);
+}
+
+String ESP8266WebServer::urlDecode(const String& text) {
+  String  decoded;
+  const unsigned int  len = text.length();
+  for (unsigned int i = 0; i < len; i++) {
+    char  c = text[i];
+    if (c == '+')
+      c = ' ';
+    else if (c == '%' && i + 2 < len) {
+      char  hex[3] = { text[i + 1], text[i + 2], '\0' };
+      c = static_cast<char>(strtol(hex, nullptr, 16));
+      i += 2;
+    }
+    decoded += c;
+  }
+  return decoded;
+}
+
+void ESP8266WebServer::mockRequest(const MockRequestST& request) {
+  _pending.reset(new MockRequestST(request));
+}
+
+String ESP8266WebServer::mockContent(void) const {
+  std::shared_ptr<WiFiClient::ConnectionST> conn = _currentClient.mockConnection();
+  return conn ? conn->tx : String();
+}
@@ -0,0 +1,197 @@
+/**
+ *  ESP8266WebServer of the mock core. It follows the interface of the
+ *  ESP8266 core 2.7, but the request is not received from the network.
+ *  The benchmark places the request with mockRequest, and handleClient
+ *  dispatches it to the request handlers as the core does. The response
+ *  is written to the WiFiClient of the request, so the bytes sent are
+ *  counted with the chunked transfer framing included.
+ *  @file   ESP8266WebServer.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef ESP8266WEBSERVER_H
+#define ESP8266WEBSERVER_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "ESP8266WiFi.h"
+#include "FS.h"
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+enum HTTPUploadStatus { UPLOAD_FILE_START, UPLOAD_FILE_WRITE, UPLOAD_FILE_END, UPLOAD_FILE_ABORTED };
+enum HTTPClientStatus { HC_NONE, HC_WAIT_READ, HC_WAIT_CLOSE };
+enum HTTPAuthMethod { BASIC_AUTH, DIGEST_AUTH };
+
+#define HTTP_DOWNLOAD_UNIT_SIZE 1460
+#ifndef HTTP_UPLOAD_BUFLEN
+#define HTTP_UPLOAD_BUFLEN      2048
+#endif
+#define HTTP_MAX_DATA_WAIT      5000
+#define HTTP_MAX_POST_WAIT      5000
+#define HTTP_MAX_SEND_WAIT      5000
+#define HTTP_MAX_CLOSE_WAIT     2000
+#define CONTENT_LENGTH_UNKNOWN  ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET  ((size_t) -2)
+
+typedef struct {
+  HTTPUploadStatus  status;
+  String  filename;
+  String  name;
+  String  type;
+  size_t  totalSize;
+  size_t  currentSize;
+  size_t  contentLength;
+  uint8_t buf[HTTP_UPLOAD_BUFLEN];
+} HTTPUpload;
+
+class ESP8266WebServer;
+
+class RequestHandler {
+ public:
+  virtual ~RequestHandler() {}
+  virtual bool  canHandle(HTTPMethod method, String uri) { (void)(method); (void)(uri); return false; }
+  virtual bool  canUpload(String uri) { (void)(uri); return false; }
+  virtual bool  handle(ESP8266WebServer& server, HTTPMethod requestMethod, String requestUri) { (void)(server); (void)(requestMethod); (void)(requestUri); return false; }
+  virtual void  upload(ESP8266WebServer& server, String requestUri, HTTPUpload& upload) { (void)(server); (void)(requestUri); (void)(upload); }
+  RequestHandler* next(void) { return _next; }
+  void  next(RequestHandler* r) { _next = r; }
+
+ private:
+  RequestHandler* _next = nullptr;
+};
+
+class ESP8266WebServer {
+ public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit ESP8266WebServer(int port = 80);
+  ESP8266WebServer(IPAddress addr, int port = 80);
+  virtual ~ESP8266WebServer();
+
+  void  begin(void) {}
+  void  begin(uint16_t port) { (void)(port); }
+  void  handleClient(void);
+  void  close(void) {}
+  void  stop(void) {}
+
+  bool  authenticate(const char* username, const char* password) { (void)(username); (void)(password); return true; }
+  void  requestAuthentication(HTTPAuthMethod mode = BASIC_AUTH, const char* realm = nullptr, const String& authFailMsg = String("")) { (void)(mode); (void)(realm); (void)(authFailMsg); }
+
+  void  on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+  void  on(const String& uri, HTTPMethod method, THandlerFunction fn) { on(uri, method, fn, nullptr); }
+  void  on(const String& uri, HTTPMethod method, THandlerFunction fn, THandlerFunction ufn);
+  void  addHandler(RequestHandler* handler);
+  void  serveStatic(const char* uri, fs::FS& fs, const char* path, const char* cache_header = nullptr) { (void)(uri); (void)(fs); (void)(path); (void)(cache_header); }
+  void  onNotFound(THandlerFunction fn) { _notFoundHandler = fn; }
+  void  onFileUpload(THandlerFunction fn) { _fileUploadHandler = fn; }
+
+  const String& uri(void) const { return _currentUri; }
+  HTTPMethod  method(void) const { return _currentMethod; }
+  WiFiClient  client(void) { return _currentClient; }
+  HTTPUpload& upload(void) { return *_currentUpload; }
+
+  const String& arg(const String& name) const;
+  const String& arg(int i) const;
+  const String& argName(int i) const;
+  int   args(void) const { return static_cast<int>(_currentArgs.size()); }
+  bool  hasArg(const String& name) const;
+  void  collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+  const String& header(const String& name) const;
+  const String& header(int i) const;
+  const String& headerName(int i) const;
+  int   headers(void) const { return static_cast<int>(_currentHeaders.size()); }
+  bool  hasHeader(const String& name) const;
+  const String& hostHeader(void) const { return _hostHeader; }
+
+  void  send(int code, const char* content_type = nullptr, const String& content = String(""));
+  void  send(int code, char* content_type, const String& content) { send(code, const_cast<const char*>(content_type), content); }
+  void  send(int code, const String& content_type, const String& content) { send(code, content_type.c_str(), content); }
+  void  send(int code, const char* content_type, const char* content) { send(code, content_type, content, strlen(content)); }
+  void  send(int code, const char* content_type, const char* content, size_t contentLength);
+  void  send_P(int code, PGM_P content_type, PGM_P content) { send(code, content_type, content); }
+  void  send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength) { send(code, content_type, content, contentLength); }
+  void  setContentLength(const size_t contentLength) { _contentLength = contentLength; }
+  void  sendHeader(const String& name, const String& value, bool first = false);
+  void  sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+  void  sendContent(const char* content, size_t size);
+  void  sendContent_P(PGM_P content) { sendContent(content, strlen_P(content)); }
+  void  sendContent_P(PGM_P content, size_t size) { sendContent(content, size); }
+  template<typename T>
+  size_t  streamFile(T& file, const String& contentType, const int code = 200) {
+    setContentLength(file.size());
+    send(code, contentType.c_str(), String(""));
+    uint8_t buf[HTTP_DOWNLOAD_UNIT_SIZE];
+    size_t  sent = 0;
+    size_t  len;
+    while ((len = file.read(buf, sizeof(buf))) > 0)
+      sent += _write(reinterpret_cast<const char*>(buf), len);
+    return sent;
+  }
+  void  keepAlive(bool keepAlive) { _keepAlive = keepAlive; }
+  bool  getKeepAlive(void) const { return _keepAlive; }
+
+  static String urlDecode(const String& text);
+
+  /** A request to be dispatched by handleClient */
+  typedef struct {
+    HTTPMethod  method;                     /**< Request method */
+    String      uri;                        /**< Request URI without the query */
+    std::vector<std::pair<String, String>>  args;     /**< Query and form arguments */
+    std::vector<std::pair<String, String>>  headers;  /**< Request headers */
+    IPAddress   remote;                     /**< Address of the client */
+    String      uploadName;                 /**< Form field name of the file to upload, empty for no upload */
+    String      uploadFile;                 /**< File name of the upload */
+    String      uploadContent;              /**< Content of the file to upload */
+  } MockRequestST;
+
+  /** The response of the request dispatched */
+  typedef struct {
+    int     code;                           /**< Status code, 0 for no response */
+    String  contentType;                    /**< Content type */
+    size_t  bytes;                          /**< Bytes sent to the client including the header */
+    bool    chunked;                        /**< Responded with the chunked transfer */
+  } MockResponseST;
+
+  void  mockRequest(const MockRequestST& request);      /**< Place the request for the next handleClient */
+  const MockResponseST& mockResponse(void) const { return _response; }  /**< The last response */
+  String  mockContent(void) const;                      /**< The bytes sent with the last response when captured */
+
+ protected:
+  typedef struct {
+    String  key;
+    String  value;
+  } RequestArgument;
+
+  void  _handleRequest(void);
+  void  _prepareHeader(String& response, int code, const char* content_type, size_t contentLength);
+  void  _upload(const String& content);
+  size_t  _write(const char* data, size_t size);
+
+  RequestHandler* _firstHandler = nullptr;
+  RequestHandler* _lastHandler = nullptr;
+  std::vector<std::unique_ptr<RequestHandler>>  _ownHandlers;
+  THandlerFunction  _notFoundHandler;
+  THandlerFunction  _fileUploadHandler;
+
+  std::unique_ptr<MockRequestST>  _pending;
+  WiFiClient  _currentClient;
+  HTTPMethod  _currentMethod = HTTP_ANY;
+  String  _currentUri;
+  std::vector<RequestArgument>  _currentArgs;
+  std::vector<RequestArgument>  _currentHeaders;
+  std::vector<String> _collectKeys;
+  std::unique_ptr<HTTPUpload> _currentUpload;
+  String  _hostHeader;
+  String  _responseHeaders;
+  size_t  _contentLength = CONTENT_LENGTH_NOT_SET;
+  bool    _chunked = false;
+  bool    _keepAlive = false;
+  MockResponseST  _response;
+  String  _empty;
+};
+
+#endif // !ESP8266WEBSERVER_H
@@ -0,0 +1,294 @@
+/**
+ *  ESP8266WiFi and WiFiClient implementation of the mock core.
+ *  @file   ESP8266WiFi.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include "ESP8266WiFi.h"
+
+namespace {
+
+// The station configuration that the SDK keeps over WiFi.begin.
+struct station_config _sdkConfig;
+
+// A got IP handler whose lifetime is the WiFiEventHandler returned.
+class _GotIPHandler : public WiFiEventHandlerOpaque {
+ public:
+  explicit _GotIPHandler(std::function<void(const WiFiEventStationModeGotIP&)> f) : handler(f) {}
+  std::function<void(const WiFiEventStationModeGotIP&)> handler;
+};
+
+const uint8_t _staMac[6] = { 0x5c, 0xcf, 0x7f, 0xa1, 0xb2, 0xc3 };
+const uint8_t _apMac[6] = { 0x5e, 0xcf, 0x7f, 0xa1, 0xb2, 0xc3 };
+
+String _macString(const uint8_t* mac) {
+  char  macStr[18];
+  snprintf(macStr, sizeof(macStr), "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  return String(macStr);
+}
+
+} // namespace
+
+bool WiFiClient::mockCapture = false;
+
+wl_status_t ESP8266WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel, const uint8_t* bssid, bool connect) {
+  (void)(bssid);
+  _mode = static_cast<WiFiMode_t>(_mode | WIFI_STA);
+  memset(&_sdkConfig, 0x00, sizeof(_sdkConfig));
+  if (ssid)
+    memcpy(_sdkConfig.ssid, ssid, std::min(strlen(ssid), sizeof(_sdkConfig.ssid)));
+  if (passphrase)
+    memcpy(_sdkConfig.password, passphrase, std::min(strlen(passphrase), sizeof(_sdkConfig.password)));
+  if (channel)
+    _channel = channel;
+  if (!connect)
+    return _status;
+
+  _status = WL_NO_SSID_AVAIL;
+  const MockNetworkST*  network = _find(ssid);
+  if (network) {
+    if (network->psk != String(passphrase ? passphrase : "")) {
+      _status = WL_CONNECT_FAILED;
+      return _status;
+    }
+    _ssid = network->ssid;
+    _psk = network->psk;
+    memcpy(_bssid, network->bssid, sizeof(_bssid));
+    _rssi = network->rssi;
+    _channel = network->channel;
+    _status = WL_CONNECTED;
+    const WiFiEventStationModeGotIP event = { _localIP, _subnetMask, _gatewayIP };
+    for (auto it = _gotIP.begin(); it != _gotIP.end();) {
+      std::shared_ptr<WiFiEventHandlerOpaque> handler = it->lock();
+      if (!handler) {
+        it = _gotIP.erase(it);
+        continue;
+      }
+      static_cast<_GotIPHandler*>(handler.get())->handler(event);
+      ++it;
+    }
+  }
+  return _status;
+}
+
+wl_status_t ESP8266WiFiClass::begin(void) {
+  char  ssid[sizeof(_sdkConfig.ssid) + 1] = { '\0' };
+  char  psk[sizeof(_sdkConfig.password) + 1] = { '\0' };
+  memcpy(ssid, _sdkConfig.ssid, sizeof(_sdkConfig.ssid));
+  memcpy(psk, _sdkConfig.password, sizeof(_sdkConfig.password));
+  return begin(ssid, psk);
+}
+
+bool ESP8266WiFiClass::config(IPAddress local_ip, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+  (void)(dns1);
+  (void)(dns2);
+  if (local_ip.isSet()) {
+    _localIP = local_ip;
+    _gatewayIP = gateway;
+    _subnetMask = subnet;
+  }
+  return true;
+}
+
+bool ESP8266WiFiClass::disconnect(bool wifioff) {
+  _status = WL_DISCONNECTED;
+  _ssid = String();
+  memset(_bssid, 0x00, sizeof(_bssid));
+  if (wifioff)
+    _mode = static_cast<WiFiMode_t>(_mode & ~WIFI_STA);
+  return true;
+}
+
+bool ESP8266WiFiClass::reconnect(void) {
+  return begin() == WL_CONNECTED;
+}
+
+uint8_t* ESP8266WiFiClass::macAddress(uint8_t* mac) {
+  memcpy(mac, _staMac, sizeof(_staMac));
+  return mac;
+}
+
+String ESP8266WiFiClass::macAddress(void) {
+  return _macString(_staMac);
+}
+
+uint8_t* ESP8266WiFiClass::BSSID(void) {
+  return _bssid;
+}
+
+String ESP8266WiFiClass::BSSIDstr(void) {
+  return _macString(_bssid);
+}
+
+bool ESP8266WiFiClass::softAP(const char* ssid, const char* passphrase, int channel, int ssid_hidden, int max_connection) {
+  (void)(ssid);
+  (void)(passphrase);
+  (void)(ssid_hidden);
+  (void)(max_connection);
+  _mode = static_cast<WiFiMode_t>(_mode | WIFI_AP);
+  _channel = channel;
+  if (!_softAPIP.isSet())
+    _softAPIP = IPAddress(192, 168, 4, 1);
+  return true;
+}
+
+bool ESP8266WiFiClass::softAPConfig(IPAddress local_ip, IPAddress gateway, IPAddress subnet) {
+  (void)(gateway);
+  (void)(subnet);
+  _softAPIP = local_ip;
+  return true;
+}
+
+bool ESP8266WiFiClass::softAPdisconnect(bool wifioff) {
+  if (wifioff)
+    _mode = static_cast<WiFiMode_t>(_mode & ~WIFI_AP);
+  return true;
+}
+
+uint8_t* ESP8266WiFiClass::softAPmacAddress(uint8_t* mac) {
+  memcpy(mac, _apMac, sizeof(_apMac));
+  return mac;
+}
+
+String ESP8266WiFiClass::softAPmacAddress(void) {
+  return _macString(_apMac);
+}
+
+int8_t ESP8266WiFiClass::scanNetworks(bool async, bool show_hidden, uint8_t channel, uint8_t* ssid) {
+  (void)(async);
+  (void)(show_hidden);
+  (void)(channel);
+  (void)(ssid);
+  _scanned = static_cast<int8_t>(_networks.size());
+  return _scanned;
+}
+
+String ESP8266WiFiClass::SSID(uint8_t networkItem) {
+  return networkItem < _networks.size() ? _networks[networkItem].ssid : String();
+}
+
+uint8_t ESP8266WiFiClass::encryptionType(uint8_t networkItem) {
+  return networkItem < _networks.size() && _networks[networkItem].psk.length() ? ENC_TYPE_CCMP : ENC_TYPE_NONE;
+}
+
+int32_t ESP8266WiFiClass::RSSI(uint8_t networkItem) {
+  return networkItem < _networks.size() ? _networks[networkItem].rssi : 0;
+}
+
+uint8_t* ESP8266WiFiClass::BSSID(uint8_t networkItem) {
+  return networkItem < _networks.size() ? _networks[networkItem].bssid : nullptr;
+}
+
+String ESP8266WiFiClass::BSSIDstr(uint8_t networkItem) {
+  return networkItem < _networks.size() ? _macString(_networks[networkItem].bssid) : String();
+}
+
+int32_t ESP8266WiFiClass::channel(uint8_t networkItem) {
+  return networkItem < _networks.size() ? _networks[networkItem].channel : 0;
+}
+
+WiFiEventHandler ESP8266WiFiClass::onStationModeGotIP(std::function<void(const WiFiEventStationModeGotIP&)> f) {
+  WiFiEventHandler  handler = std::make_shared<_GotIPHandler>(f);
+  _gotIP.push_back(handler);
+  return handler;
+}
+
+WiFiEventHandler ESP8266WiFiClass::onStationModeDisconnected(std::function<void(const WiFiEventStationModeDisconnected&)> f) {
+  (void)(f);
+  return std::make_shared<WiFiEventHandlerOpaque>();
+}
+
+void ESP8266WiFiClass::mockNetwork(const MockNetworkST& network) {
+  _networks.push_back(network);
+}
+
+void ESP8266WiFiClass::mockClear(void) {
+  _networks.clear();
+  disconnect(false);
+  memset(&_sdkConfig, 0x00, sizeof(_sdkConfig));
+}
+
+const ESP8266WiFiClass::MockNetworkST* ESP8266WiFiClass::_find(const char* ssid) const {
+  if (ssid)
+    for (const MockNetworkST& network : _networks)
+      if (network.ssid == ssid)
+        return &network;
+  return nullptr;
+}
+
+ESP8266WiFiClass  WiFi;
+
+extern "C" {
+
+bool wifi_station_get_config(struct station_config* config) {
+  memcpy(config, &_sdkConfig, sizeof(_sdkConfig));
+  return true;
+}
+
+bool wifi_station_get_config_default(struct station_config* config) {
+  return wifi_station_get_config(config);
+}
+
+enum dhcp_status wifi_station_dhcpc_status(void) {
+  return DHCP_STARTED;
+}
+
+station_status_t wifi_station_get_connect_status(void) {
+  switch (WiFi.status()) {
+  case WL_CONNECTED:
+    return STATION_GOT_IP;
+  case WL_NO_SSID_AVAIL:
+    return STATION_NO_AP_FOUND;
+  case WL_CONNECT_FAILED:
+    return STATION_WRONG_PASSWORD;
+  default:
+    return STATION_IDLE;
+  }
+}
+
+struct station_info* wifi_softap_get_station_info(void) {
+  return nullptr;
+}
+
+void wifi_softap_free_station_info(void) {}
+
+} // extern "C"
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+  (void)(host);
+  (void)(port);
+  _conn = mockOpen(IPAddress(192, 168, 1, 1));
+  return 1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+  const size_t  n = std::min(size, static_cast<size_t>(available()));
+  if (n) {
+    memcpy(buf, _conn->rx.c_str() + _conn->rxPos, n);
+    _conn->rxPos += n;
+  }
+  return static_cast<int>(n);
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+  if (!connected())
+    return 0;
+  _conn->txBytes += size;
+  if (mockCapture)
+    _conn->tx.concat(reinterpret_cast<const char*>(buf), size);
+  return size;
+}
+
+std::shared_ptr<WiFiClient::ConnectionST> WiFiClient::mockOpen(const IPAddress& remote, const String& rx) {
+  std::shared_ptr<ConnectionST> conn = std::make_shared<ConnectionST>();
+  conn->rx = rx;
+  conn->rxPos = 0;
+  conn->txBytes = 0;
+  conn->open = true;
+  conn->remote = remote;
+  conn->local = WiFi.localIP();
+  return conn;
+}
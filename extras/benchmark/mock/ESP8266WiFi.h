@@ -0,0 +1,171 @@
+/**
+ *  ESP8266WiFi of the mock core. The station connects at once to the
+ *  access point which the benchmark made reachable, and the scan
+ *  returns the networks which the benchmark placed.
+ *  @file   ESP8266WiFi.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_ESP8266WIFI_H_
+#define _MOCK_ESP8266WIFI_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+extern "C" {
+#include "user_interface.h"
+}
+
+typedef enum {
+  WL_NO_SHIELD = 255,
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum WiFiMode {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+} WiFiMode_t;
+
+enum wl_enc_type {
+  ENC_TYPE_WEP = 5,
+  ENC_TYPE_TKIP = 2,
+  ENC_TYPE_CCMP = 4,
+  ENC_TYPE_NONE = 7,
+  ENC_TYPE_AUTO = 8
+};
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+
+struct WiFiEventStationModeGotIP {
+  IPAddress ip;
+  IPAddress mask;
+  IPAddress gw;
+};
+
+struct WiFiEventStationModeDisconnected {
+  String  ssid;
+  uint8_t bssid[6];
+  uint8_t reason;
+};
+
+class WiFiEventHandlerOpaque {
+ public:
+  virtual ~WiFiEventHandlerOpaque() {}
+};
+typedef std::shared_ptr<WiFiEventHandlerOpaque> WiFiEventHandler;
+
+class ESP8266WiFiClass {
+ public:
+  wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0, const uint8_t* bssid = nullptr, bool connect = true);
+  wl_status_t begin(char* ssid, char* passphrase = nullptr, int32_t channel = 0, const uint8_t* bssid = nullptr, bool connect = true) { return begin(const_cast<const char*>(ssid), const_cast<const char*>(passphrase), channel, bssid, connect); }
+  wl_status_t begin(const String& ssid, const String& passphrase = String(), int32_t channel = 0, const uint8_t* bssid = nullptr, bool connect = true) { return begin(ssid.c_str(), passphrase.c_str(), channel, bssid, connect); }
+  wl_status_t begin(void);
+  bool  config(IPAddress local_ip, IPAddress gateway, IPAddress subnet, IPAddress dns1 = static_cast<uint32_t>(0), IPAddress dns2 = static_cast<uint32_t>(0));
+  bool  disconnect(bool wifioff = false);
+  bool  reconnect(void);
+  bool  setAutoConnect(bool autoConnect) { _autoConnect = autoConnect; return true; }
+  bool  getAutoConnect(void) { return _autoConnect; }
+  bool  setAutoReconnect(bool autoReconnect) { _autoReconnect = autoReconnect; return true; }
+  bool  getAutoReconnect(void) { return _autoReconnect; }
+  wl_status_t status(void) { return _status; }
+  bool  isConnected(void) { return _status == WL_CONNECTED; }
+  bool  persistent(bool persistent) { (void)(persistent); return true; }
+
+  IPAddress localIP(void) { return _status == WL_CONNECTED ? _localIP : IPAddress(); }
+  IPAddress subnetMask(void) { return _status == WL_CONNECTED ? _subnetMask : IPAddress(); }
+  IPAddress gatewayIP(void) { return _status == WL_CONNECTED ? _gatewayIP : IPAddress(); }
+  IPAddress dnsIP(uint8_t dns_no = 0) { (void)(dns_no); return _gatewayIP; }
+  uint8_t*  macAddress(uint8_t* mac);
+  String  macAddress(void);
+  String  hostname(void) { return _hostname; }
+  bool  hostname(const char* aHostname) { _hostname = aHostname; return true; }
+  bool  hostname(const String& aHostname) { return hostname(aHostname.c_str()); }
+  bool  setHostname(const char* aHostname) { return hostname(aHostname); }
+
+  String  SSID(void) const { return _status == WL_CONNECTED ? _ssid : String(); }
+  String  psk(void) const { return _psk; }
+  uint8_t*  BSSID(void);
+  String  BSSIDstr(void);
+  int32_t RSSI(void) { return _status == WL_CONNECTED ? _rssi : 0; }
+  int32_t channel(void) { return _channel; }
+
+  bool  mode(WiFiMode_t m) { _mode = m; return true; }
+  WiFiMode_t  getMode(void) { return _mode; }
+  bool  enableSTA(bool enable) { return mode(static_cast<WiFiMode_t>(enable ? _mode | WIFI_STA : _mode & ~WIFI_STA)); }
+  bool  enableAP(bool enable) { return mode(static_cast<WiFiMode_t>(enable ? _mode | WIFI_AP : _mode & ~WIFI_AP)); }
+
+  bool  softAP(const char* ssid, const char* passphrase = nullptr, int channel = 1, int ssid_hidden = 0, int max_connection = 4);
+  bool  softAP(const String& ssid, const String& passphrase = String(), int channel = 1, int ssid_hidden = 0, int max_connection = 4) { return softAP(ssid.c_str(), passphrase.c_str(), channel, ssid_hidden, max_connection); }
+  bool  softAPConfig(IPAddress local_ip, IPAddress gateway, IPAddress subnet);
+  bool  softAPdisconnect(bool wifioff = false);
+  uint8_t softAPgetStationNum(void) { return 0; }
+  IPAddress softAPIP(void) { return _softAPIP; }
+  uint8_t*  softAPmacAddress(uint8_t* mac);
+  String  softAPmacAddress(void);
+
+  int8_t  scanNetworks(bool async = false, bool show_hidden = false, uint8_t channel = 0, uint8_t* ssid = nullptr);
+  int8_t  scanComplete(void) { return _scanned; }
+  void  scanDelete(void) { _scanned = WIFI_SCAN_FAILED; }
+  String  SSID(uint8_t networkItem);
+  uint8_t encryptionType(uint8_t networkItem);
+  int32_t RSSI(uint8_t networkItem);
+  uint8_t*  BSSID(uint8_t networkItem);
+  String  BSSIDstr(uint8_t networkItem);
+  int32_t channel(uint8_t networkItem);
+  bool  isHidden(uint8_t networkItem) { (void)(networkItem); return false; }
+
+  WiFiEventHandler  onStationModeGotIP(std::function<void(const WiFiEventStationModeGotIP&)> f);
+  WiFiEventHandler  onStationModeDisconnected(std::function<void(const WiFiEventStationModeDisconnected&)> f);
+
+  /** An access point around the mock station */
+  typedef struct {
+    String  ssid;
+    String  psk;
+    uint8_t bssid[6];
+    int32_t rssi;
+    int32_t channel;
+  } MockNetworkST;
+  void  mockNetwork(const MockNetworkST& network);  /**< Place an access point which is reachable */
+  void  mockClear(void);                            /**< Remove all access points and disconnect */
+
+ protected:
+  const MockNetworkST*  _find(const char* ssid) const;
+
+  wl_status_t _status = WL_DISCONNECTED;
+  WiFiMode_t  _mode = WIFI_OFF;
+  bool    _autoConnect = true;
+  bool    _autoReconnect = true;
+  String  _ssid;
+  String  _psk;
+  String  _hostname = String(F("esp8266-mock"));
+  uint8_t _bssid[6] = { 0 };
+  int32_t _rssi = 0;
+  int32_t _channel = 1;
+  int8_t  _scanned = WIFI_SCAN_FAILED;
+  IPAddress _localIP = IPAddress(192, 168, 1, 100);
+  IPAddress _subnetMask = IPAddress(255, 255, 255, 0);
+  IPAddress _gatewayIP = IPAddress(192, 168, 1, 1);
+  IPAddress _softAPIP;
+  std::vector<MockNetworkST>  _networks;
+  std::vector<std::weak_ptr<WiFiEventHandlerOpaque>>  _gotIP;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif // !_MOCK_ESP8266WIFI_H_
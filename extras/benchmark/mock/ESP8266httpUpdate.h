@@ -0,0 +1,55 @@
+/**
+ *  ESP8266HTTPUpdate of the mock core, only the state that AutoConnect
+ *  inherits.
+ *  @file   ESP8266httpUpdate.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_ESP8266HTTPUPDATE_H_
+#define _MOCK_ESP8266HTTPUPDATE_H_
+
+#include "Arduino.h"
+#include "ESP8266HTTPClient.h"
+#include "Updater.h"
+
+#define HTTP_UE_TOO_LESS_SPACE            (-100)
+#define HTTP_UE_SERVER_NOT_REPORT_SIZE    (-101)
+#define HTTP_UE_SERVER_FILE_NOT_FOUND     (-102)
+#define HTTP_UE_SERVER_FORBIDDEN          (-103)
+#define HTTP_UE_SERVER_WRONG_HTTP_CODE    (-104)
+#define HTTP_UE_SERVER_FAULTY_MD5         (-105)
+#define HTTP_UE_BIN_VERIFY_HEADER_FAILED  (-106)
+#define HTTP_UE_BIN_FOR_WRONG_FLASH       (-107)
+#define HTTP_UE_SERVER_UNAUTHORIZED       (-108)
+
+enum HTTPUpdateResult {
+  HTTP_UPDATE_FAILED,
+  HTTP_UPDATE_NO_UPDATES,
+  HTTP_UPDATE_OK
+};
+typedef HTTPUpdateResult t_httpUpdate_return;
+
+class ESP8266HTTPUpdate {
+ public:
+  ESP8266HTTPUpdate(void) : _httpClientTimeout(8000) {}
+  explicit ESP8266HTTPUpdate(int httpClientTimeout) : _httpClientTimeout(httpClientTimeout) {}
+  ~ESP8266HTTPUpdate(void) {}
+
+  void  rebootOnUpdate(bool reboot) { _rebootOnUpdate = reboot; }
+  void  followRedirects(bool follow) { (void)(follow); }
+  void  setLedPin(int ledPin = -1, uint8_t ledOn = HIGH) { _ledPin = ledPin; _ledOn = ledOn; }
+  int   getLastError(void) { return _lastError; }
+  String  getLastErrorString(void) { return String(F("Update error ")) + String(_lastError); }
+
+ protected:
+  int   _lastError = 0;
+  bool  _rebootOnUpdate = true;
+  int   _httpClientTimeout;
+  int   _ledPin = -1;
+  uint8_t _ledOn = HIGH;
+};
+
+#endif // !_MOCK_ESP8266HTTPUPDATE_H_
@@ -0,0 +1,44 @@
+/**
+ *  ESP class of the mock core. The free heap comes from the counting
+ *  allocator.
+ *  @file   Esp.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_ESP_H_
+#define _MOCK_ESP_H_
+
+#include <stdint.h>
+#include "WString.h"
+#include "MockHeap.h"
+
+class EspClass {
+ public:
+  uint32_t  getChipId(void) { return 0x00a1b2c3; }
+  uint8_t   getCpuFreqMHz(void) { return 80; }
+  uint32_t  getFlashChipId(void) { return 0x001640e0; }
+  uint32_t  getFlashChipRealSize(void) { return 4 * 1024 * 1024; }
+  uint32_t  getFlashChipSize(void) { return 4 * 1024 * 1024; }
+  uint32_t  getFlashChipSpeed(void) { return 40000000; }
+  uint32_t  getFreeHeap(void) { return static_cast<uint32_t>(MockHeap::available()); }
+  uint32_t  getMaxFreeBlockSize(void) { return getFreeHeap(); }
+  uint8_t   getHeapFragmentation(void) { return 0; }
+  uint32_t  getFreeSketchSpace(void) { return 1024 * 1024; }
+  uint32_t  getSketchSize(void) { return 512 * 1024; }
+  String    getSketchMD5(void) { return String(F("00000000000000000000000000000000")); }
+  const char* getSdkVersion(void) { return "2.2.2-dev(mock)"; }
+  String    getCoreVersion(void) { return String(F("mock")); }
+  String    getResetReason(void) { return String(F("Power on")); }
+  uint32_t  getCycleCount(void);
+  void  reset(void) {}
+  void  restart(void) {}
+  void  wdtFeed(void) {}
+  bool  eraseConfig(void) { return true; }
+};
+
+extern EspClass ESP;
+
+#endif // !_MOCK_ESP_H_
@@ -0,0 +1,77 @@
+/**
+ *  File system implementation of the mock core.
+ *  @file   FS.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include "FS.h"
+
+namespace fs {
+
+size_t File::write(const uint8_t* buf, size_t size) {
+  if (!_node)
+    return 0;
+  if (_pos > _node->content.size())
+    _pos = _node->content.size();
+  _node->content.replace(_pos, std::min(size, _node->content.size() - _pos), reinterpret_cast<const char*>(buf), size);
+  _pos += size;
+  return size;
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+  const size_t  n = std::min(size, static_cast<size_t>(available()));
+  if (n) {
+    memcpy(buf, _node->content.data() + _pos, n);
+    _pos += n;
+  }
+  return n;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!_node)
+    return false;
+  size_t  base = 0;
+  if (mode == SeekCur)
+    base = _pos;
+  else if (mode == SeekEnd)
+    base = _node->content.size();
+  if (base + pos > _node->content.size())
+    return false;
+  _pos = base + pos;
+  return true;
+}
+
+File FS::open(const char* path, const char* mode) {
+  if (!_mounted || !path || !mode)
+    return File();
+  auto  it = _files.find(path);
+  if (*mode == 'r') {
+    if (it == _files.end())
+      return File();
+    return File(it->second, false);
+  }
+  if (it == _files.end()) {
+    std::shared_ptr<File::NodeST> node = std::make_shared<File::NodeST>();
+    node->name = path;
+    it = _files.emplace(path, node).first;
+  }
+  if (*mode == 'w')
+    it->second->content.clear();
+  return File(it->second, *mode == 'a');
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+  auto  it = _files.find(pathFrom);
+  if (it == _files.end() || _files.count(pathTo))
+    return false;
+  std::shared_ptr<File::NodeST> node = it->second;
+  _files.erase(it);
+  node->name = pathTo;
+  _files.emplace(pathTo, node);
+  return true;
+}
+
+} // namespace fs
@@ -0,0 +1,97 @@
+/**
+ *  File system of the mock core. Each file system is a set of the files
+ *  in the host memory, empty at the start of the process.
+ *  @file   FS.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef FS_H
+#define FS_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include "Arduino.h"
+
+namespace fs {
+
+enum SeekMode {
+  SeekSet = 0,
+  SeekCur = 1,
+  SeekEnd = 2
+};
+
+class File : public Stream {
+ public:
+  typedef struct {
+    std::string name;       /**< Path of the file */
+    std::string content;    /**< Content of the file */
+  } NodeST;
+
+  File() : _pos(0) {}
+  File(std::shared_ptr<NodeST> node, const bool append) : _node(node), _pos(append ? node->content.size() : 0) {}
+
+  size_t  write(uint8_t c) override { return write(&c, 1); }
+  size_t  write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+  int   available(void) override { return _node ? static_cast<int>(_node->content.size() - _pos) : 0; }
+  int   read(void) override { return available() ? static_cast<uint8_t>(_node->content[_pos++]) : -1; }
+  size_t  read(uint8_t* buf, size_t size);
+  int   peek(void) override { return available() ? static_cast<uint8_t>(_node->content[_pos]) : -1; }
+  void  flush(void) override {}
+  bool  seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t  position(void) const { return _pos; }
+  size_t  size(void) const { return _node ? _node->content.size() : 0; }
+  void  close(void) { _node.reset(); _pos = 0; }
+  const char* name(void) const { return _node ? _node->name.c_str() : ""; }
+  bool  isFile(void) const { return static_cast<bool>(_node); }
+  bool  isDirectory(void) const { return false; }
+  operator bool() const { return static_cast<bool>(_node); }
+
+ protected:
+  std::shared_ptr<NodeST> _node;
+  size_t  _pos;
+};
+
+class FS {
+ public:
+  FS() : _mounted(false) {}
+  virtual ~FS() {}
+  bool  begin(void) { _mounted = true; return true; }
+  bool  begin(bool formatOnFail) { (void)(formatOnFail); return begin(); }
+  void  end(void) { _mounted = false; }
+  bool  format(void) { _files.clear(); return true; }
+  File  open(const char* path, const char* mode);
+  File  open(const String& path, const char* mode) { return open(path.c_str(), mode); }
+  bool  exists(const char* path) const { return _files.count(path) > 0; }
+  bool  exists(const String& path) const { return exists(path.c_str()); }
+  bool  remove(const char* path) { return _files.erase(path) > 0; }
+  bool  remove(const String& path) { return remove(path.c_str()); }
+  bool  rename(const char* pathFrom, const char* pathTo);
+  bool  mkdir(const char* path) { (void)(path); return true; }
+  bool  rmdir(const char* path) { (void)(path); return true; }
+
+ protected:
+  bool  _mounted;
+  std::map<std::string, std::shared_ptr<File::NodeST>>  _files;
+};
+
+} // namespace fs
+
+#ifndef FS_NO_GLOBALS
+using fs::FS;
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+#endif // !FS_NO_GLOBALS
+
+#if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_SPIFFS)
+extern fs::FS SPIFFS;
+#endif
+
+#endif // !FS_H
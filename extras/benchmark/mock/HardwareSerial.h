@@ -0,0 +1,31 @@
+/**
+ *  Serial of the mock core, written out to the stderr of the host.
+ *  @file   HardwareSerial.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_HARDWARESERIAL_H_
+#define _MOCK_HARDWARESERIAL_H_
+
+#include <stdio.h>
+#include "Stream.h"
+
+class HardwareSerial : public Stream {
+ public:
+  void  begin(unsigned long baud) { (void)(baud); }
+  void  end(void) {}
+  int   available(void) override { return 0; }
+  int   read(void) override { return -1; }
+  int   peek(void) override { return -1; }
+  size_t  write(uint8_t c) override { return fputc(c, stderr) == EOF ? 0 : 1; }
+  size_t  write(const uint8_t* buffer, size_t size) override { return fwrite(buffer, 1, size, stderr); }
+  void  flush(void) override { fflush(stderr); }
+  operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // !_MOCK_HARDWARESERIAL_H_
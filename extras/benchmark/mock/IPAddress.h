@@ -0,0 +1,82 @@
+/**
+ *  IPAddress class of the mock core, IPv4 only.
+ *  @file   IPAddress.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_IPADDRESS_H_
+#define _MOCK_IPADDRESS_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "Print.h"
+
+class IPAddress : public Printable {
+ public:
+  IPAddress() { _address.dword = 0; }
+  IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet, uint8_t fourth_octet) {
+    _address.bytes[0] = first_octet;
+    _address.bytes[1] = second_octet;
+    _address.bytes[2] = third_octet;
+    _address.bytes[3] = fourth_octet;
+  }
+  IPAddress(uint32_t address) { _address.dword = address; }
+  IPAddress(const uint8_t* address) { memcpy(_address.bytes, address, sizeof(_address.bytes)); }
+
+  bool  fromString(const char* address) {
+    uint32_t  acc = 0;
+    int dots = 0;
+    uint8_t bytes[4] = { 0 };
+    while (*address) {
+      const char  c = *address++;
+      if (c >= '0' && c <= '9') {
+        acc = acc * 10 + (c - '0');
+        if (acc > 255)
+          return false;
+      }
+      else if (c == '.') {
+        if (dots == 3)
+          return false;
+        bytes[dots++] = static_cast<uint8_t>(acc);
+        acc = 0;
+      }
+      else
+        return false;
+    }
+    if (dots != 3)
+      return false;
+    bytes[3] = static_cast<uint8_t>(acc);
+    memcpy(_address.bytes, bytes, sizeof(bytes));
+    return true;
+  }
+  bool  fromString(const String& address) { return fromString(address.c_str()); }
+  bool  isSet(void) const { return _address.dword != 0; }
+  operator uint32_t() const { return _address.dword; }
+  bool  operator==(const IPAddress& addr) const { return _address.dword == addr._address.dword; }
+  bool  operator==(uint32_t addr) const { return _address.dword == addr; }
+  bool  operator!=(const IPAddress& addr) const { return _address.dword != addr._address.dword; }
+  bool  operator!=(uint32_t addr) const { return _address.dword != addr; }
+  uint8_t operator[](int index) const { return _address.bytes[index]; }
+  uint8_t&  operator[](int index) { return _address.bytes[index]; }
+  IPAddress&  operator=(uint32_t address) { _address.dword = address; return *this; }
+
+  String  toString(void) const {
+    char  szRet[16];
+    snprintf(szRet, sizeof(szRet), "%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]);
+    return String(szRet);
+  }
+  size_t  printTo(Print& p) const override { return p.print(toString()); }
+
+ private:
+  union {
+    uint8_t   bytes[4];
+    uint32_t  dword;
+  } _address;
+};
+
+extern const IPAddress INADDR_NONE;
+
+#endif // !_MOCK_IPADDRESS_H_
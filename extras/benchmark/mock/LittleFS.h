@@ -0,0 +1,19 @@
+/**
+ *  LittleFS of the mock core.
+ *  @file   LittleFS.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_LITTLEFS_H_
+#define _MOCK_LITTLEFS_H_
+
+#include "FS.h"
+
+#if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_LITTLEFS)
+extern fs::FS LittleFS;
+#endif
+
+#endif // !_MOCK_LITTLEFS_H_
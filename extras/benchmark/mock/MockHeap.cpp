@@ -0,0 +1,167 @@
+/**
+ *  The counting allocator of the mock core. It interposes the allocation
+ *  functions of glibc and forwards them to the glibc implementation,
+ *  measuring the size of each block with malloc_usable_size.
+ *  @file   MockHeap.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include <malloc.h>
+#include <new>
+#include "MockHeap.h"
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t nmemb, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void  __libc_free(void* ptr);
+}
+
+namespace {
+
+MockHeapST  _heap = { 0, 0, 0, 0 };
+size_t  _base = 0;
+
+inline void _acquire(void* ptr) {
+  if (ptr) {
+    const size_t  size = malloc_usable_size(ptr);
+    _heap.count++;
+    _heap.bytes += size;
+    _heap.current += size;
+    if (_heap.current > _heap.peak)
+      _heap.peak = _heap.current;
+  }
+}
+
+inline void _release(void* ptr) {
+  if (ptr)
+    _heap.current -= malloc_usable_size(ptr);
+}
+
+} // namespace
+
+namespace MockHeap {
+
+void base(void) {
+  _base = _heap.current;
+}
+
+size_t available(void) {
+  const size_t  used = _heap.current > _base ? _heap.current - _base : 0;
+  return used < MOCK_HEAP_SIZE ? MOCK_HEAP_SIZE - used : 0;
+}
+
+void reset(void) {
+  _heap.count = 0;
+  _heap.bytes = 0;
+  _heap.peak = _heap.current;
+}
+
+const MockHeapST& stats(void) {
+  return _heap;
+}
+
+} // namespace MockHeap
+
+extern "C" {
+
+void* malloc(size_t size) {
+  void* ptr = __libc_malloc(size);
+  _acquire(ptr);
+  return ptr;
+}
+
+void* calloc(size_t nmemb, size_t size) {
+  void* ptr = __libc_calloc(nmemb, size);
+  _acquire(ptr);
+  return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+  if (!ptr)
+    return malloc(size);
+  const size_t  prev = malloc_usable_size(ptr);
+  void* newPtr = __libc_realloc(ptr, size);
+  if (newPtr) {
+    const size_t  now = malloc_usable_size(newPtr);
+    _heap.current = _heap.current - prev + now;
+    if (_heap.current > _heap.peak)
+      _heap.peak = _heap.current;
+    if (now > prev)
+      _heap.bytes += now - prev;
+    if (newPtr != ptr)
+      _heap.count++;
+  }
+  else if (size == 0)
+    _heap.current -= prev;
+  return newPtr;
+}
+
+void* memalign(size_t alignment, size_t size) {
+  void* ptr = __libc_memalign(alignment, size);
+  _acquire(ptr);
+  return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+  return memalign(alignment, size);
+}
+
+int posix_memalign(void** memptr, size_t alignment, size_t size) {
+  *memptr = memalign(alignment, size);
+  return *memptr ? 0 : 12;    // ENOMEM
+}
+
+void free(void* ptr) {
+  _release(ptr);
+  __libc_free(ptr);
+}
+
+} // extern "C"
+
+void* operator new(size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return malloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  free(ptr);
+}
@@ -0,0 +1,40 @@
+/**
+ *  Declaration of the counting allocator of the mock core. malloc,
+ *  calloc, realloc, free and the operator new and delete of the whole
+ *  process go through the counter, so that the allocations caused by
+ *  AutoConnect, PageBuilder, ArduinoJson and the String are counted.
+ *  The free heap of the mock ESP is derived from it.
+ *  @file   MockHeap.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_MOCKHEAP_H_
+#define _MOCK_MOCKHEAP_H_
+
+#include <stddef.h>
+
+// The heap size of the mock ESP. It is the free heap of an ESP8266
+// after WiFi has started.
+#ifndef MOCK_HEAP_SIZE
+#define MOCK_HEAP_SIZE  48000
+#endif // !MOCK_HEAP_SIZE
+
+/** Allocation statistics since the last reset */
+typedef struct {
+  size_t  count;      /**< Number of the allocations, realloc that moves the block included */
+  size_t  bytes;      /**< Total bytes allocated */
+  size_t  current;    /**< Bytes in use now */
+  size_t  peak;       /**< The highest bytes in use */
+} MockHeapST;
+
+namespace MockHeap {
+void  base(void);                 /**< Make the current usage the origin of the free heap */
+size_t  available(void);          /**< Free heap of the mock ESP */
+void  reset(void);                /**< Reset the counts and the peak */
+const MockHeapST& stats(void);    /**< Allocation statistics */
+}
+
+#endif // !_MOCK_MOCKHEAP_H_
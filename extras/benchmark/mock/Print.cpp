@@ -0,0 +1,155 @@
+/**
+ *  Print and Stream class implementation of the mock core.
+ *  @file   Print.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Arduino.h"
+#include "Stream.h"
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t  n = 0;
+  while (size--) {
+    const size_t  ret = write(*buffer++);
+    if (ret == 0)
+      break;
+    n += ret;
+  }
+  return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+  va_list arg;
+  va_start(arg, format);
+  char  temp[64];
+  char* buffer = temp;
+  const int len = vsnprintf(temp, sizeof(temp), format, arg);
+  va_end(arg);
+  if (len < 0)
+    return 0;
+  if (static_cast<size_t>(len) >= sizeof(temp)) {
+    buffer = static_cast<char*>(malloc(len + 1));
+    if (!buffer)
+      return 0;
+    va_start(arg, format);
+    vsnprintf(buffer, len + 1, format, arg);
+    va_end(arg);
+  }
+  const size_t  n = write(reinterpret_cast<const uint8_t*>(buffer), len);
+  if (buffer != temp)
+    free(buffer);
+  return n;
+}
+
+size_t Print::printf_P(PGM_P format, ...) {
+  va_list arg;
+  va_start(arg, format);
+  char  temp[64];
+  char* buffer = temp;
+  const int len = vsnprintf(temp, sizeof(temp), format, arg);
+  va_end(arg);
+  if (len < 0)
+    return 0;
+  if (static_cast<size_t>(len) >= sizeof(temp)) {
+    buffer = static_cast<char*>(malloc(len + 1));
+    if (!buffer)
+      return 0;
+    va_start(arg, format);
+    vsnprintf(buffer, len + 1, format, arg);
+    va_end(arg);
+  }
+  const size_t  n = write(reinterpret_cast<const uint8_t*>(buffer), len);
+  if (buffer != temp)
+    free(buffer);
+  return n;
+}
+
+/**
+ *  Read a byte with the timeout. The host does not wait for the bytes
+ *  to arrive, the content of the mock streams is already there.
+ */
+int Stream::timedRead(void) {
+  const unsigned long start = millis();
+  do {
+    const int c = read();
+    if (c >= 0)
+      return c;
+    yield();
+  } while (millis() - start < _timeout && available());
+  return -1;
+}
+
+int Stream::timedPeek(void) {
+  return peek();
+}
+
+bool Stream::findUntil(const char* target, const char* terminator) {
+  const size_t  targetLen = strlen(target);
+  const size_t  termLen = terminator ? strlen(terminator) : 0;
+  size_t  index = 0;
+  size_t  termIndex = 0;
+  if (targetLen == 0)
+    return true;
+  int c;
+  while ((c = timedRead()) > 0) {
+    if (c == target[index]) {
+      if (++index >= targetLen)
+        return true;
+    }
+    else
+      index = c == target[0] ? 1 : 0;
+    if (termLen > 0 && c == terminator[termIndex]) {
+      if (++termIndex >= termLen)
+        return false;
+    }
+    else
+      termIndex = 0;
+  }
+  return false;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t  count = 0;
+  while (count < length) {
+    const int c = timedRead();
+    if (c < 0)
+      break;
+    *buffer++ = static_cast<char>(c);
+    count++;
+  }
+  return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+  size_t  index = 0;
+  while (index < length) {
+    const int c = timedRead();
+    if (c < 0 || c == terminator)
+      break;
+    *buffer++ = static_cast<char>(c);
+    index++;
+  }
+  return index;
+}
+
+String Stream::readString(void) {
+  String  ret;
+  int c;
+  while ((c = timedRead()) >= 0)
+    ret += static_cast<char>(c);
+  return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String  ret;
+  int c;
+  while ((c = timedRead()) >= 0 && c != terminator)
+    ret += static_cast<char>(c);
+  return ret;
+}
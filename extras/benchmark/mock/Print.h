@@ -0,0 +1,75 @@
+/**
+ *  Print class of the mock core.
+ *  @file   Print.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_PRINT_H_
+#define _MOCK_PRINT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print;
+
+class Printable {
+ public:
+  virtual ~Printable() {}
+  virtual size_t  printTo(Print& p) const = 0;
+};
+
+class Print {
+ public:
+  Print() : _writeError(0) {}
+  virtual ~Print() {}
+  int   getWriteError(void) { return _writeError; }
+  void  clearWriteError(void) { _writeError = 0; }
+
+  virtual size_t  write(uint8_t) = 0;
+  virtual size_t  write(const uint8_t* buffer, size_t size);
+  size_t  write(const char* str) { return str ? write(reinterpret_cast<const uint8_t*>(str), strlen(str)) : 0; }
+  size_t  write(const char* buffer, size_t size) { return write(reinterpret_cast<const uint8_t*>(buffer), size); }
+  size_t  write(char c) { return write(static_cast<uint8_t>(c)); }
+  virtual int availableForWrite(void) { return 0; }
+  virtual void  flush(void) {}
+
+  size_t  printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  size_t  printf_P(PGM_P format, ...) __attribute__((format(printf, 2, 3)));
+  size_t  print(const __FlashStringHelper* ifsh) { return print(reinterpret_cast<const char*>(ifsh)); }
+  size_t  print(const String& s) { return write(s.c_str(), s.length()); }
+  size_t  print(const char str[]) { return write(str); }
+  size_t  print(char c) { return write(c); }
+  size_t  print(unsigned char n, int base = DEC) { return print(static_cast<unsigned long>(n), base); }
+  size_t  print(int n, int base = DEC) { return print(static_cast<long>(n), base); }
+  size_t  print(unsigned int n, int base = DEC) { return print(static_cast<unsigned long>(n), base); }
+  size_t  print(long n, int base = DEC) { return print(String(n, static_cast<unsigned char>(base))); }
+  size_t  print(unsigned long n, int base = DEC) { return print(String(n, static_cast<unsigned char>(base))); }
+  size_t  print(long long n, int base = DEC) { return print(String(n, static_cast<unsigned char>(base))); }
+  size_t  print(unsigned long long n, int base = DEC) { return print(String(n, static_cast<unsigned char>(base))); }
+  size_t  print(double n, int digits = 2) { return print(String(n, static_cast<unsigned char>(digits))); }
+  size_t  print(const Printable& x) { return x.printTo(*this); }
+
+  size_t  println(void) { return print("\r\n"); }
+  template<typename T>
+  size_t  println(const T& x) { size_t n = print(x); return n + println(); }
+  template<typename T>
+  size_t  println(const T& x, int base) { size_t n = print(x, base); return n + println(); }
+
+ protected:
+  void  setWriteError(int err = 1) { _writeError = err; }
+
+ private:
+  int   _writeError;
+};
+
+#endif // !_MOCK_PRINT_H_
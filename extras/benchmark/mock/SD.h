@@ -0,0 +1,32 @@
+/**
+ *  SD of the mock core. The card is never present.
+ *  @file   SD.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_SD_H_
+#define _MOCK_SD_H_
+
+#include "FS.h"
+
+#define FILE_READ   0x01
+#define FILE_WRITE  0x02
+
+class SDClass {
+ public:
+  bool  begin(uint8_t csPin, uint32_t cfg = 4000000) { (void)(csPin); (void)(cfg); return false; }
+  void  end(bool endSPI = true) { (void)(endSPI); }
+  uint8_t type(void) { return 0; }
+  fs::File  open(const char* filename, uint8_t mode = FILE_READ) { (void)(filename); (void)(mode); return fs::File(); }
+  bool  exists(const char* filepath) { (void)(filepath); return false; }
+  bool  remove(const char* filepath) { (void)(filepath); return false; }
+};
+
+#if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_SD)
+extern SDClass SD;
+#endif
+
+#endif // !_MOCK_SD_H_
@@ -0,0 +1,24 @@
+/**
+ *  SPI of the mock core.
+ *  @file   SPI.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_SPI_H_
+#define _MOCK_SPI_H_
+
+#include <stdint.h>
+
+class SPIClass {
+ public:
+  void  begin(void) {}
+  void  end(void) {}
+  uint8_t transfer(uint8_t data) { return data; }
+};
+
+extern SPIClass SPI;
+
+#endif // !_MOCK_SPI_H_
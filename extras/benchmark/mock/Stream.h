@@ -0,0 +1,39 @@
+/**
+ *  Stream class of the mock core.
+ *  @file   Stream.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_STREAM_H_
+#define _MOCK_STREAM_H_
+
+#include "Print.h"
+
+class Stream : public Print {
+ public:
+  Stream() : _timeout(1000) {}
+  virtual int available(void) = 0;
+  virtual int read(void) = 0;
+  virtual int peek(void) = 0;
+
+  void  setTimeout(unsigned long timeout) { _timeout = timeout; }
+  unsigned long getTimeout(void) const { return _timeout; }
+  bool  find(const char* target) { return findUntil(target, nullptr); }
+  bool  find(char target) { char t[2] = { target, '\0' }; return find(t); }
+  bool  findUntil(const char* target, const char* terminator);
+  virtual size_t  readBytes(char* buffer, size_t length);
+  size_t  readBytes(uint8_t* buffer, size_t length) { return readBytes(reinterpret_cast<char*>(buffer), length); }
+  size_t  readBytesUntil(char terminator, char* buffer, size_t length);
+  virtual String  readString(void);
+  String  readStringUntil(char terminator);
+
+ protected:
+  int   timedRead(void);
+  int   timedPeek(void);
+  unsigned long _timeout;   /**< Number of milliseconds to wait for the next char */
+};
+
+#endif // !_MOCK_STREAM_H_
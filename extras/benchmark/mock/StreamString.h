@@ -0,0 +1,37 @@
+/**
+ *  StreamString class of the mock core.
+ *  @file   StreamString.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_STREAMSTRING_H_
+#define _MOCK_STREAMSTRING_H_
+
+#include "Stream.h"
+
+/**
+ *  A String that can be written and read as a Stream. The content read
+ *  is removed from the top of the String.
+ */
+class StreamString : public Stream, public String {
+ public:
+  StreamString() {}
+  explicit StreamString(const String& s) : String(s) {}
+  size_t  write(const uint8_t* data, size_t size) override { return concat(reinterpret_cast<const char*>(data), size) ? size : 0; }
+  size_t  write(uint8_t data) override { return concat(static_cast<char>(data)) ? 1 : 0; }
+  int   available(void) override { return String::length(); }
+  int   read(void) override {
+    if (!String::length())
+      return -1;
+    const uint8_t c = static_cast<uint8_t>(String::charAt(0));
+    String::remove(0, 1);
+    return c;
+  }
+  int   peek(void) override { return String::length() ? static_cast<uint8_t>(String::charAt(0)) : -1; }
+  void  flush(void) override {}
+};
+
+#endif // !_MOCK_STREAMSTRING_H_
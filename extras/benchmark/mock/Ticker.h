@@ -0,0 +1,43 @@
+/**
+ *  Ticker of the mock core. The callback is held but never called, the
+ *  timing of the host does not correspond to the target.
+ *  @file   Ticker.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_TICKER_H_
+#define _MOCK_TICKER_H_
+
+#include <functional>
+#include <stdint.h>
+
+class Ticker {
+ public:
+  typedef std::function<void(void)> callback_function_t;
+
+  Ticker() : _active(false) {}
+  ~Ticker() { detach(); }
+  void  attach(float seconds, callback_function_t callback) { (void)(seconds); _callback = callback; _active = true; }
+  void  attach_ms(uint32_t milliseconds, callback_function_t callback) { (void)(milliseconds); _callback = callback; _active = true; }
+  template<typename TArg>
+  void  attach(float seconds, void (*callback)(TArg), TArg arg) { attach(seconds, std::bind(callback, arg)); }
+  template<typename TArg>
+  void  attach_ms(uint32_t milliseconds, void (*callback)(TArg), TArg arg) { attach_ms(milliseconds, std::bind(callback, arg)); }
+  void  once(float seconds, callback_function_t callback) { attach(seconds, callback); }
+  void  once_ms(uint32_t milliseconds, callback_function_t callback) { attach_ms(milliseconds, callback); }
+  template<typename TArg>
+  void  once(float seconds, void (*callback)(TArg), TArg arg) { attach(seconds, callback, arg); }
+  template<typename TArg>
+  void  once_ms(uint32_t milliseconds, void (*callback)(TArg), TArg arg) { attach_ms(milliseconds, callback, arg); }
+  void  detach(void) { _callback = nullptr; _active = false; }
+  bool  active(void) const { return _active; }
+
+ protected:
+  bool  _active;
+  callback_function_t _callback;
+};
+
+#endif // !_MOCK_TICKER_H_
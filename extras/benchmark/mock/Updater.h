@@ -0,0 +1,66 @@
+/**
+ *  Updater of the mock core. The image is written nowhere, its size is
+ *  counted only.
+ *  @file   Updater.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_UPDATER_H_
+#define _MOCK_UPDATER_H_
+
+#include <functional>
+#include "Arduino.h"
+
+#define UPDATE_ERROR_OK           (0)
+#define UPDATE_ERROR_WRITE        (1)
+#define UPDATE_ERROR_ERASE        (2)
+#define UPDATE_ERROR_READ         (3)
+#define UPDATE_ERROR_SPACE        (4)
+#define UPDATE_ERROR_SIZE         (5)
+#define UPDATE_ERROR_STREAM       (6)
+#define UPDATE_ERROR_MD5          (7)
+#define UPDATE_ERROR_FLASH_CONFIG (8)
+#define UPDATE_ERROR_NEW_FLASH_CONFIG (9)
+#define UPDATE_ERROR_MAGIC_BYTE   (10)
+#define UPDATE_ERROR_BOOTSTRAP    (11)
+
+#define U_FLASH   0
+#define U_FS      100
+#define U_AUTH    200
+
+class UpdaterClass {
+ public:
+  typedef std::function<void(size_t, size_t)> THandlerFunction_Progress;
+
+  bool  begin(size_t size, int command = U_FLASH, int ledPin = -1, uint8_t ledOn = LOW) { (void)(command); (void)(ledPin); (void)(ledOn); _size = size; _progress = 0; _error = UPDATE_ERROR_OK; _running = true; return true; }
+  size_t  write(uint8_t* data, size_t len) { (void)(data); _progress += len; if (_progress_callback) _progress_callback(_progress, _size); return len; }
+  size_t  writeStream(Stream& data) { size_t n = 0; while (data.available() && data.read() >= 0) n++; _progress += n; return n; }
+  bool  end(bool evenIfRemaining = false) { _running = false; if (!evenIfRemaining && _progress < _size) { _error = UPDATE_ERROR_SIZE; return false; } return true; }
+  void  abort(void) { _running = false; _error = UPDATE_ERROR_STREAM; }
+  bool  setMD5(const char* expected_md5) { (void)(expected_md5); return true; }
+  String  md5String(void) { return String(F("00000000000000000000000000000000")); }
+  void  printError(Print& out) { out.print(F("Mock update error ")); out.print(_error); }
+  bool  hasError(void) { return _error != UPDATE_ERROR_OK; }
+  uint8_t getError(void) { return _error; }
+  void  clearError(void) { _error = UPDATE_ERROR_OK; }
+  bool  isRunning(void) { return _running; }
+  bool  isFinished(void) { return !_running && _progress >= _size; }
+  size_t  size(void) { return _size; }
+  size_t  progress(void) { return _progress; }
+  size_t  remaining(void) { return _size - _progress; }
+  UpdaterClass& onProgress(THandlerFunction_Progress fn) { _progress_callback = fn; return *this; }
+
+ protected:
+  size_t  _size = 0;
+  size_t  _progress = 0;
+  uint8_t _error = UPDATE_ERROR_OK;
+  bool    _running = false;
+  THandlerFunction_Progress _progress_callback;
+};
+
+extern UpdaterClass Update;
+
+#endif // !_MOCK_UPDATER_H_
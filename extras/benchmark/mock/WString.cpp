@@ -0,0 +1,495 @@
+/**
+ *  String class implementation of the mock core.
+ *  @file   WString.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "WString.h"
+
+namespace {
+
+/**
+ *  Convert the integer to the text in the specified base.
+ *  @param  value     An absolute value to convert.
+ *  @param  negative  The value is negative.
+ *  @param  base      Base of the text.
+ *  @param  buf       Destination, at least 66 bytes.
+ */
+void _toText(unsigned long long value, const bool negative, const unsigned char base, char* buf) {
+  char  tmp[66];
+  char* p = tmp;
+  const unsigned char radix = base < 2 ? 10 : base;
+  do {
+    const unsigned int  digit = static_cast<unsigned int>(value % radix);
+    *p++ = static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+    value /= radix;
+  } while (value);
+  if (negative)
+    *p++ = '-';
+  while (p != tmp)
+    *buf++ = *--p;
+  *buf = '\0';
+}
+
+} // namespace
+
+String::String(const char* cstr) {
+  _init();
+  if (cstr)
+    _copy(cstr, strlen(cstr));
+}
+
+String::String(const String& str) {
+  _init();
+  *this = str;
+}
+
+String::String(const __FlashStringHelper* str) {
+  _init();
+  *this = str;
+}
+
+String::String(String&& rval) noexcept {
+  _init();
+  _move(rval);
+}
+
+String::String(char c) {
+  _init();
+  char  buf[2] = { c, '\0' };
+  *this = buf;
+}
+
+String::String(unsigned char value, unsigned char base) : String(static_cast<unsigned long long>(value), base) {}
+String::String(int value, unsigned char base) : String(static_cast<long long>(value), base) {}
+String::String(unsigned int value, unsigned char base) : String(static_cast<unsigned long long>(value), base) {}
+String::String(long value, unsigned char base) : String(static_cast<long long>(value), base) {}
+String::String(unsigned long value, unsigned char base) : String(static_cast<unsigned long long>(value), base) {}
+
+String::String(long long value, unsigned char base) {
+  _init();
+  char  buf[68];
+  const bool  negative = value < 0 && base == 10;
+  _toText(negative ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value), negative, base, buf);
+  *this = buf;
+}
+
+String::String(unsigned long long value, unsigned char base) {
+  _init();
+  char  buf[68];
+  _toText(value, false, base, buf);
+  *this = buf;
+}
+
+String::String(float value, unsigned char decimalPlaces) : String(static_cast<double>(value), decimalPlaces) {}
+
+String::String(double value, unsigned char decimalPlaces) {
+  _init();
+  char  buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(decimalPlaces), value);
+  *this = buf;
+}
+
+String::~String() {
+  free(_buffer);
+}
+
+void String::_invalidate(void) {
+  free(_buffer);
+  _init();
+}
+
+/**
+ *  Reserve the buffer to hold the string of the specified length.
+ *  @param  size  Length of the string not counting the '\0'.
+ *  @return 1 if the buffer is available.
+ */
+unsigned char String::reserve(unsigned int size) {
+  if (_buffer && _capacity >= size)
+    return 1;
+  if (_changeBuffer(size)) {
+    if (_len == 0)
+      _buffer[0] = '\0';
+    return 1;
+  }
+  return 0;
+}
+
+unsigned char String::_changeBuffer(unsigned int maxStrLen) {
+  char* newbuffer = static_cast<char*>(realloc(_buffer, maxStrLen + 1));
+  if (newbuffer) {
+    _buffer = newbuffer;
+    _capacity = maxStrLen;
+    return 1;
+  }
+  return 0;
+}
+
+String& String::_copy(const char* cstr, unsigned int length) {
+  if (!reserve(length)) {
+    _invalidate();
+    return *this;
+  }
+  _len = length;
+  memmove(_buffer, cstr, length);
+  _buffer[length] = '\0';
+  return *this;
+}
+
+void String::_move(String& rhs) noexcept {
+  free(_buffer);
+  _buffer = rhs._buffer;
+  _capacity = rhs._capacity;
+  _len = rhs._len;
+  rhs._init();
+}
+
+String& String::operator=(const String& rhs) {
+  if (this == &rhs)
+    return *this;
+  if (rhs._buffer)
+    _copy(rhs._buffer, rhs._len);
+  else
+    _invalidate();
+  return *this;
+}
+
+String& String::operator=(const char* cstr) {
+  if (cstr)
+    _copy(cstr, strlen(cstr));
+  else
+    _invalidate();
+  return *this;
+}
+
+String& String::operator=(const __FlashStringHelper* pstr) {
+  return operator=(reinterpret_cast<const char*>(pstr));
+}
+
+String& String::operator=(String&& rval) noexcept {
+  if (this != &rval)
+    _move(rval);
+  return *this;
+}
+
+unsigned char String::concat(const char* cstr, unsigned int length) {
+  if (!cstr)
+    return 0;
+  if (length == 0)
+    return 1;
+  const unsigned int  newlen = _len + length;
+  // The source may be the own buffer, hold its offset over the realloc.
+  const bool  self = _buffer && cstr >= _buffer && cstr < _buffer + _len;
+  const size_t  offset = self ? cstr - _buffer : 0;
+  if (!reserve(newlen))
+    return 0;
+  memmove(_buffer + _len, self ? _buffer + offset : cstr, length);
+  _len = newlen;
+  _buffer[_len] = '\0';
+  return 1;
+}
+
+unsigned char String::concat(const String& s) {
+  if (!s._buffer)
+    return reserve(_len);
+  return concat(s._buffer, s._len);
+}
+
+unsigned char String::concat(const char* cstr) {
+  return cstr ? concat(cstr, strlen(cstr)) : 0;
+}
+
+unsigned char String::concat(const __FlashStringHelper* str) {
+  return concat(reinterpret_cast<const char*>(str));
+}
+
+unsigned char String::concat(char c) {
+  return concat(&c, 1);
+}
+
+unsigned char String::concat(unsigned char num) { return concat(String(num)); }
+unsigned char String::concat(int num) { return concat(String(num)); }
+unsigned char String::concat(unsigned int num) { return concat(String(num)); }
+unsigned char String::concat(long num) { return concat(String(num)); }
+unsigned char String::concat(unsigned long num) { return concat(String(num)); }
+unsigned char String::concat(long long num) { return concat(String(num)); }
+unsigned char String::concat(unsigned long long num) { return concat(String(num)); }
+unsigned char String::concat(float num) { return concat(String(num)); }
+unsigned char String::concat(double num) { return concat(String(num)); }
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs) {
+  StringSumHelper&  a = const_cast<StringSumHelper&>(lhs);
+  if (!a.concat(rhs))
+    a._invalidate();
+  return a;
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const char* cstr) {
+  StringSumHelper&  a = const_cast<StringSumHelper&>(lhs);
+  if (!cstr || !a.concat(cstr))
+    a._invalidate();
+  return a;
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const __FlashStringHelper* rhs) {
+  return lhs + reinterpret_cast<const char*>(rhs);
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, char c) {
+  StringSumHelper&  a = const_cast<StringSumHelper&>(lhs);
+  if (!a.concat(c))
+    a._invalidate();
+  return a;
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, unsigned char num) { return lhs + String(num); }
+StringSumHelper& operator+(const StringSumHelper& lhs, int num) { return lhs + String(num); }
+StringSumHelper& operator+(const StringSumHelper& lhs, unsigned int num) { return lhs + String(num); }
+StringSumHelper& operator+(const StringSumHelper& lhs, long num) { return lhs + String(num); }
+StringSumHelper& operator+(const StringSumHelper& lhs, unsigned long num) { return lhs + String(num); }
+StringSumHelper& operator+(const StringSumHelper& lhs, float num) { return lhs + String(num); }
+StringSumHelper& operator+(const StringSumHelper& lhs, double num) { return lhs + String(num); }
+
+int String::compareTo(const String& s) const {
+  if (!_buffer || !s._buffer) {
+    if (s._buffer && s._len > 0)
+      return 0 - static_cast<unsigned char>(*s._buffer);
+    if (_buffer && _len > 0)
+      return static_cast<unsigned char>(*_buffer);
+    return 0;
+  }
+  return strcmp(_buffer, s._buffer);
+}
+
+unsigned char String::equals(const String& s2) const {
+  return _len == s2._len && compareTo(s2) == 0;
+}
+
+unsigned char String::equals(const char* cstr) const {
+  if (_len == 0)
+    return cstr == nullptr || *cstr == '\0';
+  if (cstr == nullptr)
+    return _buffer[0] == '\0';
+  return strcmp(_buffer, cstr) == 0;
+}
+
+unsigned char String::equalsIgnoreCase(const String& s2) const {
+  if (this == &s2)
+    return 1;
+  if (_len != s2._len)
+    return 0;
+  if (_len == 0)
+    return 1;
+  return strcasecmp(_buffer, s2._buffer) == 0;
+}
+
+unsigned char String::startsWith(const String& s2) const {
+  if (_len < s2._len)
+    return 0;
+  return startsWith(s2, 0);
+}
+
+unsigned char String::startsWith(const String& s2, unsigned int offset) const {
+  if (offset > _len - s2._len || !_buffer || !s2._buffer)
+    return 0;
+  return strncmp(&_buffer[offset], s2._buffer, s2._len) == 0;
+}
+
+unsigned char String::endsWith(const String& s2) const {
+  if (_len < s2._len || !_buffer || !s2._buffer)
+    return 0;
+  return strcmp(&_buffer[_len - s2._len], s2._buffer) == 0;
+}
+
+char String::charAt(unsigned int loc) const {
+  return operator[](loc);
+}
+
+void String::setCharAt(unsigned int loc, char c) {
+  if (loc < _len)
+    _buffer[loc] = c;
+}
+
+char& String::operator[](unsigned int index) {
+  static char dummy_writable_char;
+  if (index >= _len || !_buffer) {
+    dummy_writable_char = '\0';
+    return dummy_writable_char;
+  }
+  return _buffer[index];
+}
+
+char String::operator[](unsigned int index) const {
+  if (index >= _len || !_buffer)
+    return '\0';
+  return _buffer[index];
+}
+
+void String::getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index) const {
+  if (!bufsize || !buf)
+    return;
+  if (index >= _len) {
+    buf[0] = '\0';
+    return;
+  }
+  unsigned int  n = bufsize - 1;
+  if (n > _len - index)
+    n = _len - index;
+  strncpy(reinterpret_cast<char*>(buf), _buffer + index, n);
+  buf[n] = '\0';
+}
+
+int String::indexOf(char c) const {
+  return indexOf(c, 0);
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+  if (fromIndex >= _len)
+    return -1;
+  const char* temp = strchr(_buffer + fromIndex, ch);
+  return temp ? static_cast<int>(temp - _buffer) : -1;
+}
+
+int String::indexOf(const String& s2) const {
+  return indexOf(s2, 0);
+}
+
+int String::indexOf(const String& s2, unsigned int fromIndex) const {
+  if (fromIndex >= _len)
+    return -1;
+  const char* found = strstr(_buffer + fromIndex, s2.c_str());
+  return found ? static_cast<int>(found - _buffer) : -1;
+}
+
+int String::lastIndexOf(char theChar) const {
+  return lastIndexOf(theChar, _len - 1);
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const {
+  if (fromIndex >= _len)
+    return -1;
+  for (int i = static_cast<int>(fromIndex); i >= 0; i--)
+    if (_buffer[i] == ch)
+      return i;
+  return -1;
+}
+
+int String::lastIndexOf(const String& s2) const {
+  return lastIndexOf(s2, _len - s2._len);
+}
+
+int String::lastIndexOf(const String& s2, unsigned int fromIndex) const {
+  if (s2._len == 0 || _len == 0 || s2._len > _len)
+    return -1;
+  if (fromIndex >= _len)
+    fromIndex = _len - 1;
+  int found = -1;
+  for (const char* p = _buffer; p <= _buffer + fromIndex; p++) {
+    p = strstr(p, s2._buffer);
+    if (!p)
+      break;
+    if (static_cast<unsigned int>(p - _buffer) <= fromIndex)
+      found = static_cast<int>(p - _buffer);
+  }
+  return found;
+}
+
+String String::substring(unsigned int left, unsigned int right) const {
+  if (left > right) {
+    const unsigned int  temp = right;
+    right = left;
+    left = temp;
+  }
+  String  out;
+  if (left >= _len)
+    return out;
+  if (right > _len)
+    right = _len;
+  out._copy(_buffer + left, right - left);
+  return out;
+}
+
+void String::replace(char find, char replace) {
+  if (!_buffer)
+    return;
+  for (char* p = _buffer; *p; p++)
+    if (*p == find)
+      *p = replace;
+}
+
+void String::replace(const String& find, const String& replace) {
+  if (_len == 0 || find._len == 0)
+    return;
+  String  out;
+  const char* readFrom = _buffer;
+  const char* foundAt;
+  while ((foundAt = strstr(readFrom, find._buffer)) != nullptr) {
+    out.concat(readFrom, static_cast<unsigned int>(foundAt - readFrom));
+    out.concat(replace);
+    readFrom = foundAt + find._len;
+  }
+  if (readFrom == _buffer)
+    return;
+  out.concat(readFrom);
+  _move(out);
+}
+
+void String::remove(unsigned int index) {
+  remove(index, static_cast<unsigned int>(-1));
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= _len)
+    return;
+  if (count > _len - index)
+    count = _len - index;
+  memmove(_buffer + index, _buffer + index + count, _len - index - count + 1);
+  _len -= count;
+}
+
+void String::toLowerCase(void) {
+  if (!_buffer)
+    return;
+  for (char* p = _buffer; *p; p++)
+    *p = static_cast<char>(tolower(static_cast<unsigned char>(*p)));
+}
+
+void String::toUpperCase(void) {
+  if (!_buffer)
+    return;
+  for (char* p = _buffer; *p; p++)
+    *p = static_cast<char>(toupper(static_cast<unsigned char>(*p)));
+}
+
+void String::trim(void) {
+  if (!_buffer || _len == 0)
+    return;
+  char* begin = _buffer;
+  while (isspace(static_cast<unsigned char>(*begin)))
+    begin++;
+  char* end = _buffer + _len - 1;
+  while (isspace(static_cast<unsigned char>(*end)) && end >= begin)
+    end--;
+  _len = static_cast<unsigned int>(end + 1 - begin);
+  if (begin > _buffer)
+    memmove(_buffer, begin, _len);
+  _buffer[_len] = '\0';
+}
+
+long String::toInt(void) const {
+  return _buffer ? atol(_buffer) : 0;
+}
+
+float String::toFloat(void) const {
+  return static_cast<float>(toDouble());
+}
+
+double String::toDouble(void) const {
+  return _buffer ? atof(_buffer) : 0;
+}
@@ -0,0 +1,172 @@
+/**
+ *  String class of the mock core. It follows the String of the ESP8266
+ *  core, the buffer is allocated from the heap with malloc and grown
+ *  with realloc to the exact length, so the allocations of the library
+ *  are counted as they happen on the target. The small string
+ *  optimization of the core 2.5 or later is not emulated, the counts
+ *  are the upper bound of the target.
+ *  @file   WString.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_WSTRING_H_
+#define _MOCK_WSTRING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "pgmspace.h"
+
+class __FlashStringHelper;
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+#define F(string_literal)   (FPSTR(PSTR(string_literal)))
+
+class StringSumHelper;
+
+class String {
+  // Use a function pointer to allow for "if (s)" without the
+  // complications of an operator bool().
+  typedef void (String::*StringIfHelperType)() const;
+  void StringIfHelper() const {}
+
+ public:
+  String(const char* cstr = "");
+  String(const String& str);
+  String(const __FlashStringHelper* str);
+  String(String&& rval) noexcept;
+  explicit String(char c);
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(long long value, unsigned char base = 10);
+  explicit String(unsigned long long value, unsigned char base = 10);
+  explicit String(float value, unsigned char decimalPlaces = 2);
+  explicit String(double value, unsigned char decimalPlaces = 2);
+  ~String();
+
+  unsigned char reserve(unsigned int size);
+  unsigned int  length(void) const { return _buffer ? _len : 0; }
+  bool  isEmpty(void) const { return length() == 0; }
+
+  String& operator=(const String& rhs);
+  String& operator=(const char* cstr);
+  String& operator=(const __FlashStringHelper* str);
+  String& operator=(String&& rval) noexcept;
+  String& operator=(char c) { char buf[2] = { c, '\0' }; return operator=(buf); }
+
+  unsigned char concat(const String& str);
+  unsigned char concat(const char* cstr);
+  unsigned char concat(const char* cstr, unsigned int length);
+  unsigned char concat(const __FlashStringHelper* str);
+  unsigned char concat(char c);
+  unsigned char concat(unsigned char num);
+  unsigned char concat(int num);
+  unsigned char concat(unsigned int num);
+  unsigned char concat(long num);
+  unsigned char concat(unsigned long num);
+  unsigned char concat(long long num);
+  unsigned char concat(unsigned long long num);
+  unsigned char concat(float num);
+  unsigned char concat(double num);
+
+  template<typename T>
+  String& operator+=(const T& rhs) { concat(rhs); return *this; }
+
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, const char* cstr);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, const __FlashStringHelper* rhs);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, char c);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, unsigned char num);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, int num);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, unsigned int num);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, long num);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, unsigned long num);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, float num);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, double num);
+
+  operator StringIfHelperType() const { return _buffer ? &String::StringIfHelper : 0; }
+  int   compareTo(const String& s) const;
+  unsigned char equals(const String& s) const;
+  unsigned char equals(const char* cstr) const;
+  unsigned char operator==(const String& rhs) const { return equals(rhs); }
+  unsigned char operator==(const char* cstr) const { return equals(cstr); }
+  unsigned char operator!=(const String& rhs) const { return !equals(rhs); }
+  unsigned char operator!=(const char* cstr) const { return !equals(cstr); }
+  unsigned char operator<(const String& rhs) const { return compareTo(rhs) < 0; }
+  unsigned char operator>(const String& rhs) const { return compareTo(rhs) > 0; }
+  unsigned char operator<=(const String& rhs) const { return compareTo(rhs) <= 0; }
+  unsigned char operator>=(const String& rhs) const { return compareTo(rhs) >= 0; }
+  unsigned char equalsIgnoreCase(const String& s) const;
+  unsigned char equalsConstantTime(const String& s) const { return equals(s); }
+  unsigned char startsWith(const String& prefix) const;
+  unsigned char startsWith(const String& prefix, unsigned int offset) const;
+  unsigned char endsWith(const String& suffix) const;
+
+  char  charAt(unsigned int index) const;
+  void  setCharAt(unsigned int index, char c);
+  char  operator[](unsigned int index) const;
+  char& operator[](unsigned int index);
+  void  getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index = 0) const;
+  void  toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const { getBytes(reinterpret_cast<unsigned char*>(buf), bufsize, index); }
+  const char* c_str(void) const { return _buffer ? _buffer : ""; }
+  char* begin(void) { return _buffer; }
+  char* end(void) { return _buffer + length(); }
+  const char* begin(void) const { return c_str(); }
+  const char* end(void) const { return c_str() + length(); }
+
+  int   indexOf(char ch) const;
+  int   indexOf(char ch, unsigned int fromIndex) const;
+  int   indexOf(const String& str) const;
+  int   indexOf(const String& str, unsigned int fromIndex) const;
+  int   lastIndexOf(char ch) const;
+  int   lastIndexOf(char ch, unsigned int fromIndex) const;
+  int   lastIndexOf(const String& str) const;
+  int   lastIndexOf(const String& str, unsigned int fromIndex) const;
+  String  substring(unsigned int beginIndex) const { return substring(beginIndex, length()); }
+  String  substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+  void  replace(char find, char replace);
+  void  replace(const String& find, const String& replace);
+  void  remove(unsigned int index);
+  void  remove(unsigned int index, unsigned int count);
+  void  toLowerCase(void);
+  void  toUpperCase(void);
+  void  trim(void);
+
+  long  toInt(void) const;
+  float toFloat(void) const;
+  double  toDouble(void) const;
+
+ protected:
+  void  _init(void) { _buffer = nullptr; _capacity = 0; _len = 0; }
+  void  _invalidate(void);
+  unsigned char _changeBuffer(unsigned int maxStrLen);
+  String& _copy(const char* cstr, unsigned int length);
+  void  _move(String& rhs) noexcept;
+
+  char* _buffer;            /**< The actual char array */
+  unsigned int  _capacity;  /**< The array length minus one for the '\0' */
+  unsigned int  _len;       /**< The String length not counting the '\0' */
+};
+
+class StringSumHelper : public String {
+ public:
+  StringSumHelper(const String& s) : String(s) {}
+  StringSumHelper(const char* p) : String(p) {}
+  StringSumHelper(const __FlashStringHelper* p) : String(p) {}
+  StringSumHelper(char c) : String(c) {}
+  StringSumHelper(unsigned char num) : String(num) {}
+  StringSumHelper(int num) : String(num) {}
+  StringSumHelper(unsigned int num) : String(num) {}
+  StringSumHelper(long num) : String(num) {}
+  StringSumHelper(unsigned long num) : String(num) {}
+  StringSumHelper(float num) : String(num) {}
+  StringSumHelper(double num) : String(num) {}
+};
+
+#endif // !_MOCK_WSTRING_H_
@@ -0,0 +1,67 @@
+/**
+ *  WiFiClient of the mock core. A client is a handle of the connection
+ *  shared by its copies as same as the core. The bytes to receive are
+ *  placed in advance, and the bytes sent are kept in the connection.
+ *  @file   WiFiClient.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_WIFICLIENT_H_
+#define _MOCK_WIFICLIENT_H_
+
+#include <memory>
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class WiFiClient : public Stream {
+ public:
+  /** The connection shared by the copies of the client */
+  typedef struct {
+    String    rx;         /**< Bytes to be received */
+    size_t    rxPos;      /**< Bytes already received */
+    String    tx;         /**< Bytes sent */
+    size_t    txBytes;    /**< Number of bytes sent */
+    bool      open;       /**< Connection established */
+    IPAddress remote;     /**< Address of the peer */
+    IPAddress local;      /**< Address of the own */
+  } ConnectionST;
+
+  WiFiClient() {}
+  explicit WiFiClient(std::shared_ptr<ConnectionST> conn) : _conn(conn) {}
+  ~WiFiClient() {}
+
+  int   connect(IPAddress ip, uint16_t port) { return connect(ip.toString().c_str(), port); }
+  int   connect(const char* host, uint16_t port);
+  int   connect(const String& host, uint16_t port) { return connect(host.c_str(), port); }
+  uint8_t connected(void) { return _conn && _conn->open ? 1 : 0; }
+  void  stop(void) { if (_conn) _conn->open = false; }
+  void  flush(void) override {}
+  void  setNoDelay(bool nodelay) { (void)(nodelay); }
+  void  keepAlive(uint16_t idle = 7200, uint16_t intv = 75, uint8_t count = 9) { (void)(idle); (void)(intv); (void)(count); }
+  IPAddress remoteIP(void) const { return _conn ? _conn->remote : IPAddress(); }
+  uint16_t  remotePort(void) const { return 49152; }
+  IPAddress localIP(void) const { return _conn ? _conn->local : IPAddress(); }
+  uint16_t  localPort(void) const { return 80; }
+
+  int   available(void) override { return _conn ? static_cast<int>(_conn->rx.length() - _conn->rxPos) : 0; }
+  int   read(void) override { return available() ? static_cast<uint8_t>(_conn->rx[_conn->rxPos++]) : -1; }
+  int   read(uint8_t* buf, size_t size);
+  int   peek(void) override { return available() ? static_cast<uint8_t>(_conn->rx[_conn->rxPos]) : -1; }
+  size_t  readBytes(char* buffer, size_t length) override { return static_cast<size_t>(read(reinterpret_cast<uint8_t*>(buffer), length)); }
+  size_t  write(uint8_t b) override { return write(&b, 1); }
+  size_t  write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+  operator bool() { return connected(); }
+
+  static bool mockCapture;                    /**< Keep the bytes sent in the connection, otherwise counted only */
+  std::shared_ptr<ConnectionST> mockConnection(void) const { return _conn; }
+  static std::shared_ptr<ConnectionST> mockOpen(const IPAddress& remote, const String& rx = String());
+
+ protected:
+  std::shared_ptr<ConnectionST> _conn;
+};
+
+#endif // !_MOCK_WIFICLIENT_H_
@@ -0,0 +1,31 @@
+/**
+ *  WiFiServer of the mock core. It does not listen, the requests are
+ *  handed to the web server of the mock core directly.
+ *  @file   WiFiServer.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_WIFISERVER_H_
+#define _MOCK_WIFISERVER_H_
+
+#include "WiFiClient.h"
+
+class WiFiServer {
+ public:
+  explicit WiFiServer(uint16_t port) : _port(port) {}
+  WiFiServer(IPAddress addr, uint16_t port) : _port(port) { (void)(addr); }
+  void  begin(void) {}
+  void  begin(uint16_t port) { _port = port; }
+  void  close(void) {}
+  void  stop(void) {}
+  void  setNoDelay(bool nodelay) { (void)(nodelay); }
+  WiFiClient  available(void) { return WiFiClient(); }
+
+ protected:
+  uint16_t  _port;
+};
+
+#endif // !_MOCK_WIFISERVER_H_
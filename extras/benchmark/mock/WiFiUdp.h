@@ -0,0 +1,40 @@
+/**
+ *  WiFiUDP of the mock core. No packet arrives.
+ *  @file   WiFiUdp.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_WIFIUDP_H_
+#define _MOCK_WIFIUDP_H_
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class WiFiUDP : public Stream {
+ public:
+  uint8_t begin(uint16_t port) { _port = port; return 1; }
+  void  stop(void) { _port = 0; }
+  int   beginPacket(IPAddress ip, uint16_t port) { (void)(ip); (void)(port); return 1; }
+  int   beginPacket(const char* host, uint16_t port) { (void)(host); (void)(port); return 1; }
+  int   endPacket(void) { return 1; }
+  int   parsePacket(void) { return 0; }
+  int   available(void) override { return 0; }
+  int   read(void) override { return -1; }
+  int   read(unsigned char* buffer, size_t len) { (void)(buffer); (void)(len); return 0; }
+  int   read(char* buffer, size_t len) { return read(reinterpret_cast<unsigned char*>(buffer), len); }
+  int   peek(void) override { return -1; }
+  size_t  write(uint8_t c) override { (void)(c); return 1; }
+  size_t  write(const uint8_t* buffer, size_t size) override { (void)(buffer); return size; }
+  using Print::write;
+  IPAddress remoteIP(void) const { return IPAddress(); }
+  uint16_t  remotePort(void) const { return 0; }
+  static void stopAll(void) {}
+
+ protected:
+  uint16_t  _port = 0;
+};
+
+#endif // !_MOCK_WIFIUDP_H_
@@ -0,0 +1,80 @@
+/**
+ *  The ESP8266 mock core for the host, the timing, the pins and the
+ *  global instances.
+ *  @file   core.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#include <chrono>
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "FS.h"
+#include "LittleFS.h"
+#include "SD.h"
+#include "SPI.h"
+#include "Updater.h"
+
+namespace {
+
+const std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+// The delay advances the clock of the mock core without sleeping, so
+// that the waits of the library do not stretch the benchmark.
+unsigned long long  _delayed = 0;
+
+unsigned long long _elapsed(void) {
+  return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _epoch).count()) + _delayed;
+}
+
+} // namespace
+
+unsigned long millis(void) {
+  return static_cast<unsigned long>(static_cast<uint32_t>(_elapsed() / 1000));
+}
+
+unsigned long micros(void) {
+  return static_cast<unsigned long>(static_cast<uint32_t>(_elapsed()));
+}
+
+void delay(unsigned long ms) {
+  _delayed += static_cast<unsigned long long>(ms) * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+  _delayed += us;
+}
+
+void yield(void) {}
+void esp_yield(void) {}
+
+void pinMode(uint8_t pin, uint8_t mode) { (void)(pin); (void)(mode); }
+void digitalWrite(uint8_t pin, uint8_t val) { (void)(pin); (void)(val); }
+int digitalRead(uint8_t pin) { (void)(pin); return LOW; }
+void analogWrite(uint8_t pin, int val) { (void)(pin); (void)(val); }
+
+long random(long howbig) {
+  return howbig ? static_cast<long>(::random() % howbig) : 0;
+}
+
+long random(long howsmall, long howbig) {
+  return howsmall >= howbig ? howsmall : random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  srandom(static_cast<unsigned int>(seed));
+}
+
+uint32_t EspClass::getCycleCount(void) {
+  return static_cast<uint32_t>(_elapsed() * 80);
+}
+
+HardwareSerial  Serial;
+EspClass  ESP;
+UpdaterClass  Update;
+SPIClass  SPI;
+SDClass   SD;
+fs::FS    SPIFFS;
+fs::FS    LittleFS;
+const IPAddress INADDR_NONE(0, 0, 0, 0);
@@ -0,0 +1,19 @@
+/**
+ *  Version identification of the mock core, impersonates the ESP8266
+ *  core 2.7.1.
+ *  @file   core_version.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_CORE_VERSION_H_
+#define _MOCK_CORE_VERSION_H_
+
+#define ARDUINO_ESP8266_GIT_VER   0x2843a5ac
+#define ARDUINO_ESP8266_GIT_DESC  2.7.1
+#define ARDUINO_ESP8266_RELEASE_2_7_1
+#define ARDUINO_ESP8266_RELEASE   "2_7_1"
+
+#endif // !_MOCK_CORE_VERSION_H_
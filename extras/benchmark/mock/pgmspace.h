@@ -0,0 +1,49 @@
+/**
+ *  PROGMEM access of the mock core. The host has a flat address space,
+ *  so the flash access functions are the plain ones.
+ *  @file   pgmspace.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_PGMSPACE_H_
+#define _MOCK_PGMSPACE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#define PROGMEM
+#define PGM_P             const char*
+#define PGM_VOID_P        const void*
+#define PSTR(s)           (s)
+
+#define pgm_read_byte(addr)   (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr)   (*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr)  (*reinterpret_cast<const uint32_t*>(addr))
+#define pgm_read_float(addr)  (*reinterpret_cast<const float*>(addr))
+#define pgm_read_ptr(addr)    (*reinterpret_cast<const void* const*>(addr))
+
+#define memcpy_P          memcpy
+#define memcmp_P          memcmp
+#define strlen_P          strlen
+#define strnlen_P         strnlen
+#define strcpy_P          strcpy
+#define strncpy_P         strncpy
+#define strcat_P          strcat
+#define strncat_P         strncat
+#define strcmp_P          strcmp
+#define strncmp_P         strncmp
+#define strcasecmp_P      strcasecmp
+#define strncasecmp_P     strncasecmp
+#define strstr_P          strstr
+#define strchr_P          strchr
+#define strrchr_P         strrchr
+#define sprintf_P         sprintf
+#define snprintf_P        snprintf
+#define vsnprintf_P       vsnprintf
+
+#endif // !_MOCK_PGMSPACE_H_
@@ -0,0 +1,67 @@
+/**
+ *  The NONOS SDK interface of the mock core, only the station and
+ *  softAP functions that AutoConnect calls.
+ *  @file   user_interface.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _MOCK_USER_INTERFACE_H_
+#define _MOCK_USER_INTERFACE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/queue.h>
+
+typedef uint8_t   uint8;
+typedef uint16_t  uint16;
+typedef uint32_t  uint32;
+typedef int8_t    sint8;
+
+struct ip_addr {
+  uint32  addr;
+};
+
+struct ip_info {
+  struct ip_addr  ip;
+  struct ip_addr  netmask;
+  struct ip_addr  gw;
+};
+
+struct station_config {
+  uint8 ssid[32];
+  uint8 password[64];
+  uint8 bssid_set;
+  uint8 bssid[6];
+};
+
+struct station_info {
+  STAILQ_ENTRY(station_info)  next;
+  uint8 bssid[6];
+  struct ip_addr  ip;
+};
+
+enum dhcp_status {
+  DHCP_STOPPED,
+  DHCP_STARTED
+};
+
+typedef enum {
+  STATION_IDLE = 0,
+  STATION_CONNECTING,
+  STATION_WRONG_PASSWORD,
+  STATION_NO_AP_FOUND,
+  STATION_CONNECT_FAIL,
+  STATION_GOT_IP
+} station_status_t;
+
+bool  wifi_station_get_config(struct station_config* config);
+bool  wifi_station_get_config_default(struct station_config* config);
+enum dhcp_status  wifi_station_dhcpc_status(void);
+station_status_t  wifi_station_get_connect_status(void);
+struct station_info*  wifi_softap_get_station_info(void);
+void  wifi_softap_free_station_info(void);
+
+#endif // !_MOCK_USER_INTERFACE_H_
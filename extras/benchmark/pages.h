@@ -0,0 +1,199 @@
+/**
+ *  The custom Web pages which the benchmark serves. They are taken from
+ *  the Elements and the Update examples as they are, so the results
+ *  represent the pages of a typical sketch.
+ *  @file   pages.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-20
+ *  @copyright  MIT license.
+ */
+
+#ifndef _BENCHMARK_PAGES_H_
+#define _BENCHMARK_PAGES_H_
+
+#include <Arduino.h>
+
+// examples/Elements
+static const char PAGE_ELEMENTS[] PROGMEM = R"(
+{
+  "uri": "/elements",
+  "title": "Elements",
+  "menu": true,
+  "element": [
+    {
+      "name": "text",
+      "type": "ACText",
+      "value": "AutoConnect element behaviors collection",
+      "style": "font-family:Arial;font-size:18px;font-weight:400;color:#191970"
+    },
+    {
+      "name": "check",
+      "type": "ACCheckbox",
+      "value": "check",
+      "label": "Check",
+      "labelposition": "infront",
+      "checked": true
+    },
+    {
+      "name": "input",
+      "type": "ACInput",
+      "label": "Text input",
+      "placeholder": "This area accepts hostname patterns",
+      "pattern": "^(([a-zA-Z0-9]|[a-zA-Z0-9][a-zA-Z0-9\\-]*[a-zA-Z0-9])\\.)*([A-Za-z0-9]|[A-Za-z0-9][A-Za-z0-9\\-]*[A-Za-z0-9])$"
+    },
+    {
+      "name": "radio",
+      "type": "ACRadio",
+      "value": [
+        "Button-1",
+        "Button-2",
+        "Button-3"
+      ],
+      "label": "Radio buttons",
+      "arrange": "vertical",
+      "checked": 1
+    },
+    {
+      "name": "select",
+      "type": "ACSelect",
+      "option": [
+        "Option-1",
+        "Option-2",
+        "Option-3"
+      ],
+      "label": "Select",
+      "selected": 2
+    },
+    {
+      "name": "load",
+      "type": "ACSubmit",
+      "value": "Load",
+      "uri": "/elements"
+    },
+    {
+      "name": "save",
+      "type": "ACSubmit",
+      "value": "Save",
+      "uri": "/save"
+    },
+    {
+      "name": "adjust_width",
+      "type": "ACElement",
+      "value": "<script type=\"text/javascript\">window.onload=function(){var t=document.querySelectorAll(\"input[type='text']\");for(i=0;i<t.length;i++){var e=t[i].getAttribute(\"placeholder\");e&&t[i].setAttribute(\"size\",e.length*.8)}};</script>"
+    }
+  ]
+}
+)";
+
+static const char PAGE_SAVE[] PROGMEM = R"(
+{
+  "uri": "/save",
+  "title": "Elements",
+  "menu": false,
+  "element": [
+    {
+      "name": "caption",
+      "type": "ACText",
+      "format": "Elements have been saved to %s",
+      "style": "font-family:Arial;font-size:18px;font-weight:400;color:#191970"
+    },
+    {
+      "name": "validated",
+      "type": "ACText",
+      "style": "color:red"
+    },
+    {
+      "name": "echo",
+      "type": "ACText",
+      "style": "font-family:monospace;font-size:small;white-space:pre;"
+    },
+    {
+      "name": "ok",
+      "type": "ACSubmit",
+      "value": "OK",
+      "uri": "/elements"
+    }
+  ]
+}
+)";
+
+// examples/Update
+static const char PAGE_SETUP[] PROGMEM = R"(
+{
+  "title": "Update setup",
+  "uri": "/setup",
+  "menu": true,
+  "element": [
+    {
+      "name": "caption",
+      "type": "ACText",
+      "value": "OTA update setup",
+      "style": ""
+    },
+    {
+      "name": "isvalid",
+      "type": "ACText",
+      "style": "color:red"
+    },
+    {
+      "name": "server",
+      "type": "ACInput",
+      "label": "Update server",
+      "pattern": "^((([a-zA-Z]|[a-zA-Z][a-zA-Z0-9-]*[a-zA-Z0-9]).)*([A-Za-z]|[A-Za-z][A-Za-z0-9-]*[A-Za-z0-9]))|((25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)(\\.(25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)){3})$",
+      "placeholder": "Your update server address"
+    },
+    {
+      "name": "port",
+      "type": "ACInput",
+      "label": "port",
+      "pattern": "[0-9]{1,4}"
+    },
+    {
+      "name": "path",
+      "type": "ACInput",
+      "label": "path"
+    },
+    {
+      "name": "apply",
+      "type": "ACSubmit",
+      "value": "Apply",
+      "uri": "/apply"
+    },
+    {
+      "name": "cancel",
+      "type": "ACSubmit",
+      "value": "Discard",
+      "uri": "/"
+    }
+  ]
+}
+)";
+
+static const char PAGE_APPLY[] PROGMEM = R"(
+{
+  "title": "Update setup",
+  "uri": "/apply",
+  "menu": false,
+  "element": [
+    {
+      "name": "redirect",
+      "type": "ACElement",
+      "value": "<script type=\"text/javascript\">location.href='__REDIRECT__';</script>"
+    }
+  ]
+}
+)";
+
+// The catalog which the mock update server responds to the Update page.
+static const char UPDATE_CATALOG[] PROGMEM = R"(
+[
+  { "name": "archives", "type": "directory", "date": "May 20 2020", "time": "10:12:08", "size": 0 },
+  { "name": "update.ino", "type": "file", "date": "May 20 2020", "time": "10:12:08", "size": 5183 },
+  { "name": "mqttRSSI.ino.bin", "type": "bin", "date": "May 20 2020", "time": "10:15:41", "size": 412560 },
+  { "name": "FSBrowser.ino.bin", "type": "bin", "date": "May 19 2020", "time": "21:03:17", "size": 398304 },
+  { "name": "Elements.ino.bin.gz", "type": "bin", "date": "May 18 2020", "time": "08:44:52", "size": 281937, "compression": "gzip" }
+]
+)";
+
+#endif // !_BENCHMARK_PAGES_H_
@@ -76,6 +76,11 @@ bool AutoConnect::begin(void) {
 bool AutoConnect::begin(const char* ssid, const char* passphrase, unsigned long timeout) {
   bool  cs;
 
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+  // The captive portal inside begin is served by the caller.
+  _stopPortalTask();
+#endif
+
   // Overwrite for the current timeout value.
   _connectTimeout = timeout;
 
@@ -110,7 +115,14 @@ bool AutoConnect::begin(const char* ssid, const char* passphrase, unsigned long
     station_config_t  current;
     if (_getConfigSTA(&current))
       AC_DBG("Current:%.32s\n", current.ssid);
-    if (_apConfig.principle == AC_PRINCIPLE_RSSI && (ssid == nullptr && passphrase == nullptr)) {
+    // The fast reconnect tries the directed connection to the last known
+    // channel and BSSID ahead of scanning.
+    bool  fast = false;
+    if (_apConfig.fastReconnect && (ssid == nullptr && passphrase == nullptr))
+      fast = _fastConnect(reinterpret_cast<const char*>(current.ssid));
+    uint8_t adoptedCh = 0;
+    uint8_t adoptedBSSID[sizeof(station_config_t::bssid)];
+    if (!fast && _apConfig.principle == AC_PRINCIPLE_RSSI && (ssid == nullptr && passphrase == nullptr)) {
       // AC_PRINCIPLE_RSSI is available when SSID and password are not provided.
       // Find the strongest signal from the broadcast among the saved credentials.
       if ((cs = _loadAvailCredential(nullptr, AC_PRINCIPLE_RSSI, false))) {
@@ -118,22 +130,31 @@ bool AutoConnect::begin(const char* ssid, const char* passphrase, unsigned long
         memcpy(current.password, _credential.password, sizeof(station_config_t::password));
         c_ssid = reinterpret_cast<const char*>(current.ssid);
         c_password = reinterpret_cast<const char*>(current.password);
+        // Keep the channel and BSSID found by the scan, the credential
+        // will be reloaded in the STA configuration.
+        adoptedCh = _credential.channel;
+        memcpy(adoptedBSSID, _credential.bssid, sizeof(station_config_t::bssid));
         AC_DBG("Adopted:%.32s\n", c_ssid);
       }
     }
 
-    if (cs) {
+    if (cs && !fast) {
       // Advance configuration for STA mode. Restore previous configuration of STA.
       _loadAvailCredential(reinterpret_cast<const char*>(current.ssid));
-      if (!_configSTA(_apConfig.staip, _apConfig.staGateway, _apConfig.staNetmask, _apConfig.dns1, _apConfig.dns2))
+      if (!_configSTA(_apConfig.staip, _apConfig.staGateway, _apConfig.staNetmask, _apConfig.dns1, _apConfig.dns2)) {
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+        // The portal stopped at the entry is to be resumed.
+        _startPortalTask();
+#endif
         return false;
+      }
 
       // Try to connect by STA immediately.
       if (c_ssid == nullptr && c_password == nullptr)
         WiFi.begin();
       else {
         _disconnectWiFi(false);
-        WiFi.begin(c_ssid, c_password);
+        WiFi.begin(c_ssid, c_password, adoptedCh, adoptedCh ? adoptedBSSID : nullptr);
       }
       AC_DBG("WiFi.begin(%s%s%s)\n", c_ssid == nullptr ? "" : c_ssid, c_password == nullptr ? "" : ",", c_password == nullptr ? "" : c_password);
       cs = _waitForConnect(_connectTimeout) == WL_CONNECTED;
@@ -154,13 +175,17 @@ bool AutoConnect::begin(const char* ssid, const char* passphrase, unsigned long
       AC_DBG("autoReconnect loaded:%s(%s)\n", ssid_c, _apConfig.principle == AC_PRINCIPLE_RECENT ? "RECENT" : "RSSI");
       const char* psk = strlen(password_c) ? password_c : nullptr;
       _configSTA(IPAddress(_credential.config.sta.ip), IPAddress(_credential.config.sta.gateway), IPAddress(_credential.config.sta.netmask), IPAddress(_credential.config.sta.dns1), IPAddress(_credential.config.sta.dns2));
-      WiFi.begin(ssid_c, psk);
+      WiFi.begin(ssid_c, psk, _credential.channel, _credential.channel ? _credential.bssid : nullptr);
       AC_DBG("WiFi.begin(%s%s%s)\n", ssid_c, psk == nullptr ? "" : ",", psk == nullptr ? "" : psk);
       cs = _waitForConnect(_connectTimeout) == WL_CONNECTED;
     }
   }
   _currentHostIP = WiFi.localIP();
 
+  // Keep the channel of the established connection for the next fast reconnect.
+  if (cs && _apConfig.fastReconnect)
+    _rememberChannel();
+
   // End first begin process, the captive portal specific process starts here.
   if (cs) {
     // Activate AutoConnectUpdate if it is attached and incorporate it into the AutoConnect menu.
@@ -202,6 +227,7 @@ bool AutoConnect::begin(const char* ssid, const char* passphrase, unsigned long
         } while (WiFi.softAPIP() != _apConfig.apip);
       }
       _currentHostIP = WiFi.softAPIP();
+      _setCaptiveRedirect();
       AC_DBG("SoftAP %s/%s Ch(%d) IP:%s %s\n", _apConfig.apid.c_str(), _apConfig.psk.c_str(), _apConfig.channel, _currentHostIP.toString().c_str(), _apConfig.hidden ? "hidden" : "");
 
       // Start ticker with AP_STA
@@ -223,10 +249,11 @@ bool AutoConnect::begin(const char* ssid, const char* passphrase, unsigned long
         // Start the captive portal to make a new connection
         bool  hasTimeout = false;
         _portalAccessPeriod = millis();
-        while (WiFi.status() != WL_CONNECTED && !_rfReset) {
+        _portalActivity = millis();
+        while ((WiFi.status() != WL_CONNECTED || _rfConnecting) && !_rfReset) {
           handleClient();
           // Force execution of queued processes.
-          yield();
+          _pacePortal();
           // Check timeout
           if ((hasTimeout = _hasTimeout(_apConfig.portalTimeout))) {
             AC_DBG("CP timeout exceeded:%ld\n", millis() - _portalAccessPeriod);
@@ -246,6 +273,7 @@ bool AutoConnect::begin(const char* ssid, const char* passphrase, unsigned long
         else if (hasTimeout) {
           if (_apConfig.retainPortal) {
             _purgePages();
+            _flushPages();
             AC_DBG("Maintain portal\n");
           }
           else {
@@ -268,6 +296,10 @@ bool AutoConnect::begin(const char* ssid, const char* passphrase, unsigned long
     if (_ticker)
       _ticker->stop();
 
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+  // Hand the portal over to the portal task.
+  _startPortalTask();
+#endif
   return cs;
 }
 
@@ -288,6 +320,8 @@ bool AutoConnect::config(const char* ap, const char* password) {
  */
 bool AutoConnect::config(AutoConnectConfig& Config) {
   _apConfig = Config;
+  AutoConnectMemory::policy(_apConfig.psram);
+  _flushPages();
   return _config();
 }
 
@@ -392,14 +426,25 @@ void AutoConnect::home(const String& uri) {
  *  Stops AutoConnect captive portal service.
  */
 void AutoConnect::end(void) {
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+  _stopPortalTask();
+#endif
   _responsePage.reset();
   _currentPageElement.reset();
+  _flushPages();
+  _stopConnect();
+  _connectState = AC_CONNECT_IDLE;
+  _rfConnecting = false;
+  _scan.clear();
   _ticker.reset();
   _update.reset();
   _ota.reset();
 
   _stopPortal();
   _dnsServer.reset();
+  _captiveRedirect = String();
+  _clientContext.clear();
+  AutoConnectArena::request().release();
   _webServer.reset();
 }
 
@@ -416,13 +461,16 @@ WebServerClass& AutoConnect::host(void) {
  *  @return A pointer of AutoConnectAux instance.
  */
 AutoConnectAux* AutoConnect::aux(const String& uri) const {
-  AutoConnectAux* aux_p = _aux;
-  while (aux_p) {
-    if (!strcmp(aux_p->uri(), uri.c_str()))
-      break;
-    aux_p = aux_p->_next;
+  if (_auxIndex.size()) {
+    const size_t  mask = _auxIndex.size() - 1;
+    size_t  n = _hashUri(uri.c_str()) & mask;
+    while (_auxIndex[n]) {
+      if (!strcmp(_auxIndex[n]->uri(), uri.c_str()))
+        return _auxIndex[n];
+      n = (n + 1) & mask;
+    }
   }
-  return aux_p;
+  return nullptr;
 }
 
 /**
@@ -436,6 +484,8 @@ void AutoConnect::join(AutoConnectAux& aux) {
   else
     _aux = &aux;
   aux._join(*this);
+  _indexAux();
+  _flushPages();
   AC_DBG("%s on hands\n", aux.uri());
 }
 
@@ -457,6 +507,18 @@ void AutoConnect::_startWebServer(void) {
   if (!_webServer) {
     // Only when hosting WebServer internally
     _webServer =  WebserverUP(new WebServerClass(AUTOCONNECT_HTTPPORT), std::default_delete<WebServerClass>() );
+#ifdef AUTOCONNECT_USE_CSSCACHE
+    // The internally hosted WebServer collects the validator of the
+    // cached style sheet. The WebServer owned by the sketch keeps its
+    // own collection, the style sheet will always respond as 200 then.
+    static const char* cssHeaders[] = { "If-None-Match" };
+    _webServer->collectHeaders(cssHeaders, sizeof(cssHeaders) / sizeof(const char*));
+#endif
+#if defined(ARDUINO_ARCH_ESP8266) && defined(AUTOCONNECT_USE_KEEPALIVE)
+    // Keep the connection for the subsequent requests of the page such
+    // as the style sheets.
+    _webServer->keepAlive(true);
+#endif
     AC_DBG("WebServer allocated\n");
   }
   // Discard the original the not found handler to redirect captive portal detection.
@@ -467,6 +529,12 @@ void AutoConnect::_startWebServer(void) {
     _responsePage.reset( new PageBuilder() );
     _responsePage->exitCanHandle(std::bind(&AutoConnect::_classifyHandle, this, std::placeholders::_1, std::placeholders::_2));
     _responsePage->onUpload(std::bind(&AutoConnect::_handleUpload, this, std::placeholders::_1, std::placeholders::_2));
+#ifdef AUTOCONNECT_USE_CSSCACHE
+    _registerCSS();
+#endif
+#ifdef AUTOCONNECT_USE_METRICS
+    _webServer->on(String(F(AUTOCONNECT_URI_METRICS)), HTTP_GET, std::bind(&AutoConnect::_serveMetrics, this));
+#endif
     _responsePage->insert(*_webServer);
 
     _webServer->begin();
@@ -477,15 +545,28 @@ void AutoConnect::_startWebServer(void) {
   }
 }
 
+#ifdef AUTOCONNECT_USE_METRICS
+/**
+ *  Respond the metrics of the portal in the text format of Prometheus.
+ */
+void AutoConnect::_serveMetrics(void) {
+  _webServer->sendHeader(String(F("Cache-Control")), String(F("no-cache, no-store, must-revalidate")));
+  _webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  _webServer->send(200, String(F("text/plain; version=0.0.4")), _emptyString);
+  AutoConnectSink sink(*_webServer);
+  _metrics.printTo(sink, _scan.duration(), _ota ? _ota->throughput() : 0);
+  sink.end();
+}
+#endif // !AUTOCONNECT_USE_METRICS
+
 /**
  *  Starts DNS server for Captive portal.
  */
 void AutoConnect::_startDNSServer(void) {
   // Boot DNS server, set up for captive portal redirection.
   if (!_dnsServer) {
-    _dnsServer.reset(new DNSServer());
-    _dnsServer->setErrorReplyCode(DNSReplyCode::NoError);
-    _dnsServer->start(AUTOCONNECT_DNSPORT, "*", WiFi.softAPIP());
+    _dnsServer.reset(new AutoConnectDNS());
+    _dnsServer->start(AUTOCONNECT_DNSPORT, WiFi.softAPIP());
     AC_DBG("DNS server started\n");
   }
 }
@@ -497,12 +578,28 @@ void AutoConnect::_startDNSServer(void) {
  *  No effects when the web server is not available.
  */
 void AutoConnect::handleClient(void) {
-  // Is there DNS Server process next request?
-  if (_dnsServer)
-    _dnsServer->processNextRequest();
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+  // The portal task serves the portal, the call from the others is ignored.
+  if (_portalServer && xTaskGetCurrentTaskHandle() != _portalServer)
+    return;
+#endif
+  // Reply all the queued DNS queries for the captive portal.
+  if (_dnsServer) {
+    size_t  replied = _dnsServer->processRequests();
+    if (replied)
+      _portalActivity = millis();
+#ifdef AUTOCONNECT_USE_METRICS
+    _metrics.dns(replied);
+#endif // !AUTOCONNECT_USE_METRICS
+  }
   // handleClient valid only at _webServer activated.
-  if (_webServer)
+  if (_webServer) {
     _webServer->handleClient();
+#ifdef AUTOCONNECT_USE_METRICS
+    _metrics.endPage();
+#endif // !AUTOCONNECT_USE_METRICS
+    AutoConnectArena::request().rewind();
+  }
 
   handleRequest();
 }
@@ -511,6 +608,13 @@ void AutoConnect::handleClient(void) {
  *  Handling for the AutoConnect menu request.
  */
 void AutoConnect::handleRequest(void) {
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+  if (_portalServer && xTaskGetCurrentTaskHandle() != _portalServer)
+    return;
+#endif
+  // Take in the result of the background scan.
+  _scan.update();
+
   // Handling processing requests to AutoConnect.
   if (_rfConnect) {
     // Leave from the AP currently.
@@ -530,9 +634,20 @@ void AutoConnect::handleRequest(void) {
     strncat(password_c, reinterpret_cast<const char*>(_credential.password), sizeof(password_c) - 1);
     AC_DBG("Attempt:%s Ch(%d)\n", ssid_c, (int)ch);
     WiFi.begin(ssid_c, password_c, ch);
-    if (_waitForConnect(_connectTimeout) == WL_CONNECTED) {
+    // The attempt proceeds along with handleClient, the portal remains
+    // responsive until the connection is established.
+    _startConnect(_connectTimeout);
+    _rfConnecting = true;
+    _rfConnect = false;
+  }
+
+  if (_rfConnecting) {
+    AC_CONNECTSTATE_t connectState = _pollConnect();
+    if (connectState == AC_CONNECT_CONNECTED) {
+      AC_DBG("Established IP:%s\n", WiFi.localIP().toString().c_str());
       if (WiFi.BSSID() != NULL) {
         memcpy(_credential.bssid, WiFi.BSSID(), sizeof(station_config_t::bssid));
+        _credential.channel = static_cast<uint8_t>(WiFi.channel());
         _currentHostIP = WiFi.localIP();
         _redirectURI = String(F(AUTOCONNECT_URI_SUCCESS));
 
@@ -559,7 +674,8 @@ void AutoConnect::handleRequest(void) {
       if (_update)
         _update->enable();
     }
-    else {
+    else if (connectState == AC_CONNECT_FAILED) {
+      AC_DBG("Time out\n");
       _currentHostIP = WiFi.softAPIP();
       _redirectURI = String(F(AUTOCONNECT_URI_FAIL));
       _rsConnect = WiFi.status();
@@ -569,7 +685,7 @@ void AutoConnect::handleRequest(void) {
         yield();
       }
     }
-    _rfConnect = false;
+    _rfConnecting = connectState == AC_CONNECT_CONNECTING;
   }
 
   if (_rfReset) {
@@ -638,13 +754,10 @@ void AutoConnect::handleRequest(void) {
  *  registered.
  */
 bool AutoConnect::on(const String& uri, const AuxHandlerFunctionT handler, AutoConnectExitOrder_t order) {
-  AutoConnectAux* aux = _aux;
-  while (aux) {
-    if (!strcmp(uri.c_str(), aux->uri())) {
-      aux->on(handler, order);
-      return true;
-    }
-    aux = aux->_next;
+  AutoConnectAux* auxPage = aux(uri);
+  if (auxPage) {
+    auxPage->on(handler, order);
+    return true;
   }
   return false;
 }
@@ -657,6 +770,15 @@ void AutoConnect::onDetect(DetectExit_ft fn) {
   _onDetectExit = fn;
 }
 
+/**
+ *  Register the exit routine that is notified of the state of the
+ *  connection attempt.
+ *  @param  fn  A function of the exit routine.
+ */
+void AutoConnect::onConnect(ConnectExit_ft fn) {
+  _onConnectExit = fn;
+}
+
 /**
  *  Register the handler function for undefined url request detected.
  *  @param  fn  A function of the not found handler.
@@ -678,27 +800,31 @@ bool AutoConnect::_loadAvailCredential(const char* ssid, const AC_PRINCIPLE_t pr
   if (credential.entries() > 0) {
     // Scan the vicinity only when the saved credentials are existing.
     if (!ssid) {
-      WiFi.scanDelete();
-      int8_t  nn = WiFi.scanNetworks(false, true);
-      AC_DBG("%d network(s) found\n", (int)nn);
+      _scan.snapshot(_apConfig.scanCache);
+      int16_t nn = _scan.count();
       if (nn > 0) {
         station_config_t  validConfig;  // Temporary to find the strongest RSSI.
         int32_t minRSSI = -120;         // Min value to find the strongest RSSI.
 
         // Seek SSID
-        const char* currentSSID = WiFi.SSID().c_str();
-        const bool  skipCurrent = excludeCurrent & (strlen(currentSSID) > 0);
+        const String  currentSSID = WiFi.SSID();
+        const bool  skipCurrent = excludeCurrent & (currentSSID.length() > 0);
+        // Read all entries within a single session of the storage.
+        credential.begin();
         for (uint8_t i = 0; i < credential.entries(); i++) {
           credential.load(i, &_credential);
           // Seek valid configuration according to the WiFi connection principle.
           // Verify that an available SSIDs meet AC_PRINCIPLE_t requirements.
-          for (uint8_t n = 0; n < nn; n++) {
-            if (skipCurrent && !strcmp(currentSSID, WiFi.SSID(n).c_str()))
+          for (int16_t n = 0; n < nn; n++) {
+            const AutoConnectScan::AutoConnectScanST& ap = _scan[n];
+            if (skipCurrent && !strcmp(currentSSID.c_str(), ap.ssid))
               continue;
-            if (!memcmp(_credential.bssid, WiFi.BSSID(n), sizeof(station_config_t::bssid))) {
+            if (!memcmp(_credential.bssid, ap.bssid, sizeof(station_config_t::bssid))) {
+              // The channel is known from the scan result.
+              _credential.channel = ap.channel;
               // Excepts SSID that has weak RSSI under the lower limit.
-              if (WiFi.RSSI(n) < _apConfig.minRSSI) {
-                AC_DBG("%s:%" PRId32 "dBm, rejected\n", reinterpret_cast<const char*>(_credential.ssid), WiFi.RSSI(n));
+              if (ap.rssi < _apConfig.minRSSI) {
+                AC_DBG("%s:%ddBm, rejected\n", reinterpret_cast<const char*>(_credential.ssid), (int)ap.rssi);
                 continue;
               }
               // Determine valid credential
@@ -710,8 +836,8 @@ bool AutoConnect::_loadAvailCredential(const char* ssid, const AC_PRINCIPLE_t pr
               case AC_PRINCIPLE_RSSI:
                 // Verify that most strong radio signal.
                 // Continue seeking to find the strongest WIFI signal SSID.
-                if (WiFi.RSSI(n) > minRSSI) {
-                  minRSSI = WiFi.RSSI(n);
+                if (ap.rssi > minRSSI) {
+                  minRSSI = ap.rssi;
                   memcpy(&validConfig, &_credential, sizeof(station_config_t));
                 }
                 break;
@@ -720,6 +846,7 @@ bool AutoConnect::_loadAvailCredential(const char* ssid, const AC_PRINCIPLE_t pr
             }
           }
         }
+        credential.end();
         // Increasing the minSSI will indicate the successfully sought for AC_PRINCIPLE_RSSI.
         // Restore the credential that has maximum RSSI.
         if (minRSSI > -120) {
@@ -746,6 +873,71 @@ bool AutoConnect::_loadAvailCredential(const char* ssid, const AC_PRINCIPLE_t pr
   return false;
 }
 
+/**
+ *  Attempt the directed connection to the AP with the channel and BSSID
+ *  stored in the credential without scanning. It gives up the attempt
+ *  in the short time so that the regular connection sequence can
+ *  follow, because the AP may have moved to another channel.
+ *  @param  ssid  SSID of the credential to connect.
+ *  @return true  Connection established.
+ */
+bool AutoConnect::_fastConnect(const char* ssid) {
+  static const uint8_t  noBSSID[sizeof(station_config_t::bssid)] = { 0 };
+  char  ssid_c[sizeof(station_config_t::ssid) + sizeof('\0')];
+
+  *ssid_c = '\0';
+  strncat(ssid_c, ssid, sizeof(ssid_c) - sizeof('\0'));
+  if (!_loadAvailCredential(ssid_c))
+    return false;
+  if (!_credential.channel || !memcmp(_credential.bssid, noBSSID, sizeof(noBSSID))) {
+    AC_DBG("%s has no channel, fast reconnect skipped\n", ssid_c);
+    return false;
+  }
+  if (!_configSTA(_apConfig.staip, _apConfig.staGateway, _apConfig.staNetmask, _apConfig.dns1, _apConfig.dns2))
+    return false;
+
+  char  password_c[sizeof(station_config_t::password) + sizeof('\0')];
+  *password_c = '\0';
+  strncat(password_c, reinterpret_cast<const char*>(_credential.password), sizeof(password_c) - sizeof('\0'));
+  const char* psk = strlen(password_c) ? password_c : nullptr;
+  _disconnectWiFi(false);
+  WiFi.begin(ssid_c, psk, _credential.channel, _credential.bssid);
+  AC_DBG("WiFi.begin(%s Ch(%d) %02x:%02x:%02x:%02x:%02x:%02x)\n", ssid_c, (int)_credential.channel, _credential.bssid[0], _credential.bssid[1], _credential.bssid[2], _credential.bssid[3], _credential.bssid[4], _credential.bssid[5]);
+
+  unsigned long timeout = AUTOCONNECT_FASTCONNECT_TIMEOUT;
+  if (_connectTimeout && _connectTimeout < timeout)
+    timeout = _connectTimeout;
+  if (_waitForConnect(timeout) == WL_CONNECTED)
+    return true;
+  AC_DBG("Fast reconnect failed, fall back\n");
+  _disconnectWiFi(false);
+  return false;
+}
+
+/**
+ *  Update the channel and BSSID of the stored credential with the
+ *  established connection. The credential is written back only when
+ *  they have changed to avoid unnecessary wear of the flash.
+ */
+void AutoConnect::_rememberChannel(void) {
+  if (_apConfig.autoSave != AC_SAVECREDENTIAL_AUTO)
+    return;
+
+  AutoConnectCredential credit(_apConfig.boundaryOffset);
+  station_config_t  entry;
+  const uint8_t ch = static_cast<uint8_t>(WiFi.channel());
+  const uint8_t*  bssid = WiFi.BSSID();
+  if (!bssid || credit.load(WiFi.SSID().c_str(), &entry) < 0)
+    return;
+  if (entry.channel != ch || memcmp(entry.bssid, bssid, sizeof(station_config_t::bssid))) {
+    entry.channel = ch;
+    memcpy(entry.bssid, bssid, sizeof(station_config_t::bssid));
+    if (credit.save(&entry)) {
+      AC_DBG("%.*s Ch(%d) remembered\n", sizeof(entry.ssid), reinterpret_cast<const char*>(entry.ssid), (int)ch);
+    }
+  }
+}
+
 /**
  *  Disconnect from the AP and stop the AutoConnect portal.
  *  Stops DNS server and flush tcp sending.
@@ -767,19 +959,42 @@ void AutoConnect::_stopPortal(void) {
 /**
  *  Redirect to captive portal if we got a request for another domain.
  *  Return true in that case so the page handler do not try to handle the request again.
+ *  The request arrived through the SoftAP is replied with the redirect
+ *  response prepared at the SoftAP starts, and the connectivity check
+ *  of the client OS is replied with its canned response after the
+ *  connection established. Both are written to the client as it is
+ *  without the web server building the response.
  */
 bool AutoConnect::_captivePortal(void) {
   String  hostHeader = _webServer->hostHeader();
-  if (!_isIP(hostHeader) && (hostHeader != WiFi.localIP().toString()) && (!hostHeader.endsWith(F(".local")))) {
-    AC_DBG("Detected application, %s, %s\n", hostHeader.c_str(), WiFi.localIP().toString().c_str());
+  PGM_P   reply = _captiveProbe(hostHeader);
+  if (!reply && (_isIP(hostHeader) || hostHeader.endsWith(F(".local"))))
+    return false;
+
+  AC_DBG("Detected application, %s\n", hostHeader.c_str());
+  if (reply && WiFi.status() == WL_CONNECTED)
+    _webServer->client().print(FPSTR(reply));
+  else if (_captiveRedirect.length() && _webServer->client().localIP() == WiFi.softAPIP())
+    _webServer->client().print(_captiveRedirect);
+  else {
     String location = String(F("http://")) + _webServer->client().localIP().toString() + _getBootUri();
     _webServer->sendHeader(String(F("Location")), location, true);
     _webServer->send(302, String(F("text/plain")), _emptyString);
-    _webServer->client().flush();
-    _webServer->client().stop();
-    return true;
   }
-  return false;
+  _webServer->client().flush();
+  _webServer->client().stop();
+  return true;
+}
+
+/**
+ *  Prepare the whole redirect response to the captive portal for the
+ *  SoftAP address. It is built once when the SoftAP comes up.
+ */
+void AutoConnect::_setCaptiveRedirect(void) {
+  _captiveRedirect = String(F("HTTP/1.1 302 Found\r\nLocation: http://"));
+  _captiveRedirect += WiFi.softAPIP().toString();
+  _captiveRedirect += _getBootUri();
+  _captiveRedirect += String(F("\r\nContent-Type: text/plain\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"));
 }
 
 /**
@@ -790,26 +1005,127 @@ bool AutoConnect::_captivePortal(void) {
  *  @return false   Connectionless duration has not exceeded yet.
  */
 bool AutoConnect::_hasTimeout(unsigned long timeout) {
-  uint8_t staNum;
-
   if (!_apConfig.portalTimeout)
     return false;
 
+  if (_countStations())
+    _portalAccessPeriod = millis();
+
+  return (millis() - _portalAccessPeriod > timeout) ? true : false;
+}
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+/**
+ *  Start the portal task that serves the DNS, the web server and the
+ *  requests to AutoConnect on AUTOCONNECT_PORTALTASK_CORE. The page
+ *  handlers, including the custom Web page handlers of AutoConnectAux,
+ *  run within the portal task thereafter. If the task could not be
+ *  created, the portal remains to be served by handleClient from the
+ *  Sketch.
+ */
+void AutoConnect::_startPortalTask(void) {
+  if (_portalServer || !_webServer)
+    return;
+
+  _portalCommand = xQueueCreate(1, sizeof(AC_PORTALTASK_t));
+  _portalStopped = xSemaphoreCreateBinary();
+  if (_portalCommand && _portalStopped)
+    if (xTaskCreatePinnedToCore(_portalTask, "ACPortal", AUTOCONNECT_PORTALTASK_STACK, this, AUTOCONNECT_PORTALTASK_PRIORITY, &_portalServer, AUTOCONNECT_PORTALTASK_CORE) == pdPASS) {
+      AC_DBG("Portal task started on core %d\n", AUTOCONNECT_PORTALTASK_CORE);
+      return;
+    }
+
+  AC_DBG("Portal task unavailable\n");
+  _portalServer = nullptr;
+  _stopPortalTask();
+}
+
+/**
+ *  Let the portal task stop and wait for it to finish the current
+ *  turn. It has no effect when called from the portal task itself,
+ *  such as from the custom Web page handler.
+ */
+void AutoConnect::_stopPortalTask(void) {
+  if (_portalServer) {
+    if (xTaskGetCurrentTaskHandle() == _portalServer) {
+      AC_DBG("Portal task cannot stop itself\n");
+      return;
+    }
+    const AC_PORTALTASK_t command = AC_PORTALTASK_STOP;
+    xQueueSend(_portalCommand, &command, portMAX_DELAY);
+    xSemaphoreTake(_portalStopped, portMAX_DELAY);
+    _portalServer = nullptr;
+    AC_DBG("Portal task stopped\n");
+  }
+  if (_portalCommand) {
+    vQueueDelete(_portalCommand);
+    _portalCommand = nullptr;
+  }
+  if (_portalStopped) {
+    vSemaphoreDelete(_portalStopped);
+    _portalStopped = nullptr;
+  }
+}
+
+/**
+ *  The portal task. It serves the portal as handleClient does in the
+ *  loop of the Sketch, and waits for the command in between the turns.
+ *  @param  pvParameters  The AutoConnect instance.
+ */
+void AutoConnect::_portalTask(void* pvParameters) {
+  AutoConnect*  portal = static_cast<AutoConnect*>(pvParameters);
+  AC_PORTALTASK_t command;
+
+  for (;;) {
+    portal->handleClient();
+    if (xQueueReceive(portal->_portalCommand, &command, 1) == pdTRUE)
+      if (command == AC_PORTALTASK_STOP)
+        break;
+  }
+  xSemaphoreGive(portal->_portalStopped);
+  vTaskDelete(nullptr);
+}
+#endif // !AUTOCONNECT_USE_PORTALTASK
+
+/**
+ *  Count the stations associated with SoftAP. The station list is
+ *  queried at each AUTOCONNECT_STATIONCHECK_INTERVAL, and the count
+ *  of the last query is returned in between.
+ *  @return The number of the stations.
+ */
+uint8_t AutoConnect::_countStations(void) {
+  unsigned long now = millis();
+
+  if (_stationChecked && now - _stationChecked < AUTOCONNECT_STATIONCHECK_INTERVAL)
+    return _stations;
+  _stationChecked = now ? now : 1;
+
 #if defined(ARDUINO_ARCH_ESP8266)
-  staNum = 0;
+  _stations = 0;
   struct station_info* station = wifi_softap_get_station_info();
   while (station) {
-    staNum++;
+    _stations++;
     station = STAILQ_NEXT(station, next);
   }
   wifi_softap_free_station_info();
 #elif defined(ARDUINO_ARCH_ESP32)
-  staNum = WiFi.softAPgetStationNum();
+  _stations = WiFi.softAPgetStationNum();
 #endif
-  if (staNum)
-    _portalAccessPeriod = millis();
+  return _stations;
+}
 
-  return (millis() - _portalAccessPeriod > timeout) ? true : false;
+/**
+ *  Give up the CPU between the turns of the captive portal loop. With
+ *  AutoConnectConfig::powerSave, the loop is paced down once the portal
+ *  has not been requested for AUTOCONNECT_PORTAL_IDLETIME, more slowly
+ *  while no station is associated. The pause lets the core idle since
+ *  the SoftAP does not allow the modem to sleep.
+ */
+void AutoConnect::_pacePortal(void) {
+  if (_apConfig.powerSave && millis() - _portalActivity > AUTOCONNECT_PORTAL_IDLETIME)
+    delay(_countStations() ? AUTOCONNECT_PORTAL_PACE : AUTOCONNECT_PORTAL_PACE_NOSTA);
+  else
+    yield();
 }
 
 /**
@@ -912,13 +1228,12 @@ String AutoConnect::_induceConnect(PageArgument& args) {
 
   // Determine the connection channel based on the scan result.
   _connectCh = 0;
-  for (uint8_t nn = 0; nn < _scanCount; nn++) {
-    String  ssid = WiFi.SSID(nn);
-    if (!strncmp(ssid.c_str(), reinterpret_cast<const char*>(_credential.ssid), sizeof(station_config_t::ssid))) {
-      _connectCh = WiFi.channel(nn);
-      break;
-    }
-  }
+  char  ssid_c[sizeof(station_config_t::ssid) + sizeof('\0')];
+  *ssid_c = '\0';
+  strncat(ssid_c, reinterpret_cast<const char*>(_credential.ssid), sizeof(ssid_c) - sizeof('\0'));
+  int16_t sc = _scan.find(ssid_c);
+  if (sc >= 0)
+    _connectCh = _scan[sc].channel;
 
   // Turn on the trigger to start WiFi.begin().
   _rfConnect = true;
@@ -957,6 +1272,15 @@ String AutoConnect::_induceConnect(PageArgument& args) {
  */
 String AutoConnect::_invokeResult(PageArgument& args) {
   AC_UNUSED(args);
+  // While the connection attempt is in progress, it responds with no
+  // content to keep the page that informs during the attempting. The
+  // page queries the result again after a while.
+  if (_rfConnect || _rfConnecting) {
+    _webServer->send(204, String(F("text/plain")), _emptyString);
+    _responsePage->cancel();
+    return _emptyString;
+  }
+
   String redirect = String(F("http://"));
   // The host address to which the connection result for ESP32 responds
   // changed from v0.9.7. This change is a measure according to the
@@ -990,32 +1314,67 @@ String AutoConnect::_invokeResult(PageArgument& args) {
  */
 bool AutoConnect::_classifyHandle(HTTPMethod method, String uri) {
   AC_UNUSED(method);
-  _portalAccessPeriod = millis();
-  AC_DBG("Host:%s,URI:%s", _webServer->hostHeader().c_str(), uri.c_str());
+  _portalAccessPeriod = _portalActivity = millis();
+  // The scratch buffers of the previous request are no longer used.
+  AutoConnectArena::request().rewind();
+  String  hostHeader = _webServer->hostHeader();
+  AC_DBG("Host:%s,URI:%s", hostHeader.c_str(), uri.c_str());
+
+  // The connectivity check of the client OS goes to _captivePortal
+  // without disposing the current page.
+  if (_captiveProbe(hostHeader)) {
+    AC_DBG_DUMB(",probe\n");
+    return false;
+  }
+
+  // Save the uri of the page that the client got last for the upload request
+  ClientContextST&  context = _context();
+  if (context.uri.length() && context.uri != uri)
+    _prevUri = context.uri;
 
   // Here, classify requested uri
   if (uri == _uri) {
     AC_DBG_DUMB(",already allocated\n");
+    context.uri = _uri;
+#ifdef AUTOCONNECT_USE_METRICS
+    _metrics.beginPage(_uri);
+#endif // !AUTOCONNECT_USE_METRICS
     return true;  // The response page already exists.
   }
 
   // Dispose decrepit page
-  if (_uri.length())
-    _prevUri = _uri;   // Save current uri for the upload request
   _purgePages();
 
-  // Create the page dynamically
-  _currentPageElement.reset( _setupPage(uri) );
-  if (!_currentPageElement && _aux) {
-    // Requested URL is not a normal page, exploring AUX pages
-    _currentPageElement.reset(_aux->_setupPage(uri));
+  // Reuse the page constructed with the previous request
+  _currentPageElement = _restorePage(uri);
+  if (_currentPageElement) {
+    AC_DBG_DUMB(",cached:%s", uri.c_str());
+  }
+  else {
+    // Create the page dynamically
+    uint32_t  freeHeap = ESP.getFreeHeap();
+    _currentPageElement.reset( _setupPage(uri) );
+    if (!_currentPageElement) {
+      // Requested URL is not a normal page, exploring AUX pages
+      AutoConnectAux* auxPage = aux(uri);
+      if (auxPage)
+        _currentPageElement.reset(auxPage->_setupPage(uri));
+    }
+    if (_currentPageElement) {
+      AC_DBG_DUMB(",generated:%s", uri.c_str());
+      uint32_t  consumed = ESP.getFreeHeap();
+      _cachePage(uri, _currentPageElement, freeHeap > consumed ? freeHeap - consumed : sizeof(PageElement));
+    }
   }
 
   if (_currentPageElement) {
-    AC_DBG_DUMB(",generated:%s", uri.c_str());
     _uri = uri;
     _responsePage->addElement(*_currentPageElement);
     _responsePage->setUri(_uri.c_str());
+    context.uri = _uri;
+#ifdef AUTOCONNECT_USE_METRICS
+    _metrics.beginPage(_uri);
+#endif // !AUTOCONNECT_USE_METRICS
   }
   AC_DBG_DUMB(",%s\n", _currentPageElement != nullptr ? " allocated" : "ignored");
   return _currentPageElement != nullptr ? true : false;
@@ -1026,14 +1385,9 @@ bool AutoConnect::_classifyHandle(HTTPMethod method, String uri) {
  *  upload function of the AutoConnectAux which has a destination URI.
  */
 void AutoConnect::_handleUpload(const String& requestUri, const HTTPUpload& upload) {
-  AutoConnectAux* aux = _aux;
-  while (aux) {
-    if (aux->_uriStr == requestUri) {
-      aux->upload(_prevUri, upload);
-      break;
-    }
-    aux = aux->_next;
-  }
+  AutoConnectAux* auxPage = aux(requestUri);
+  if (auxPage)
+    auxPage->upload(_prevUri, upload);
 }
 
 /**
@@ -1041,18 +1395,143 @@ void AutoConnect::_handleUpload(const String& requestUri, const HTTPUpload& uplo
  */
 void AutoConnect::_purgePages(void) {
   _responsePage->clearElement();
+  AutoConnectArena::request().release();
   if (_currentPageElement) {
     _currentPageElement.reset();
     _uri = String("");
   }
 }
 
+/**
+ *  Discard all cached pages. It is necessary when the construction of
+ *  the pages has changed, such as the menu items or AutoConnectAux.
+ */
+void AutoConnect::_flushPages(void) {
+  _pageCache.clear();
+  _pageCacheAmount = 0;
+}
+
+/**
+ *  Restore the page from the cache. The restored page becomes the most
+ *  recently used, and the page attributes that are set during the page
+ *  construction are reproduced.
+ *  @param  uri   A URI of the page.
+ *  @return The cached page, nullptr if it is not cached.
+ */
+std::shared_ptr<PageElement> AutoConnect::_restorePage(const String& uri) {
+  const PageCacheST*  page = nullptr;
+
+  for (auto it = _pageCache.begin(); it != _pageCache.end(); ++it) {
+    if (it->uri == uri) {
+      PageCacheST cache = *it;
+      _pageCache.erase(it);
+      _pageCache.insert(_pageCache.begin(), cache);
+      page = &_pageCache.front();
+      break;
+    }
+  }
+  if (!page)
+    return nullptr;
+  _menuTitle = page->title;
+  _freeHeapSize = ESP.getFreeHeap();
+  _reserve(page->rSize);
+  _chunked(page->transMode);
+  return page->element;
+}
+
+/**
+ *  Keep the constructed page in the cache. The least recently used
+ *  pages are evicted until the page fits within the memory budget
+ *  given by AutoConnectConfig::pageCache.
+ *  @param  uri   A URI of the page.
+ *  @param  elm   The constructed page.
+ *  @param  cost  Heap consumption of the page.
+ */
+void AutoConnect::_cachePage(const String& uri, const std::shared_ptr<PageElement>& elm, const size_t cost) {
+  if (cost > _apConfig.pageCache)
+    return;
+  while (_pageCache.size() && _pageCacheAmount + cost > _apConfig.pageCache) {
+    AC_DBG_DUMB(",evict:%s", _pageCache.back().uri.c_str());
+    _pageCacheAmount -= _pageCache.back().cost;
+    _pageCache.pop_back();
+  }
+  _pageCache.insert(_pageCache.begin(), { uri, elm, _menuTitle, _transMode, _reserveSize, cost });
+  _pageCacheAmount += cost;
+}
+
+/**
+ *  Get the context of the client of the current request. The client
+ *  that is not found takes over the context of the least recently
+ *  accessed client.
+ *  @return The context of the client, which becomes the most recent.
+ */
+AutoConnect::ClientContextST& AutoConnect::_context(void) {
+  const uint32_t  addr = static_cast<uint32_t>(_webServer->client().remoteIP());
+
+  for (auto it = _clientContext.begin(); it != _clientContext.end(); ++it) {
+    if (it->addr == addr) {
+      if (it != _clientContext.begin()) {
+        ClientContextST context = *it;
+        _clientContext.erase(it);
+        _clientContext.insert(_clientContext.begin(), context);
+      }
+      return _clientContext.front();
+    }
+  }
+  if (_clientContext.size() >= AUTOCONNECT_CLIENT_CONTEXTS)
+    _clientContext.pop_back();
+  _clientContext.insert(_clientContext.begin(), ClientContextST());
+  _clientContext.front().addr = addr;
+  return _clientContext.front();
+}
+
+/**
+ *  Rebuild the index of the joined AutoConnectAux pages to look up by
+ *  URI. The index is an open-addressed hash table with the linear
+ *  probing whose size is a power of two and at least twice the number
+ *  of pages. The chain of AutoConnectAux::_next still determines the
+ *  order of the menu items. If the URIs are duplicated, the page that
+ *  appears first in the chain takes precedence.
+ */
+void AutoConnect::_indexAux(void) {
+  size_t  count = 0;
+  for (AutoConnectAux* aux_p = _aux; aux_p; aux_p = aux_p->_next)
+    count++;
+  size_t  size = 4;
+  while (size < count * 2)
+    size <<= 1;
+  _auxIndex.assign(size, nullptr);
+
+  const size_t  mask = size - 1;
+  for (AutoConnectAux* aux_p = _aux; aux_p; aux_p = aux_p->_next) {
+    size_t  n = _hashUri(aux_p->uri()) & mask;
+    while (_auxIndex[n] && strcmp(_auxIndex[n]->uri(), aux_p->uri()))
+      n = (n + 1) & mask;
+    if (!_auxIndex[n])
+      _auxIndex[n] = aux_p;
+  }
+}
+
+/**
+ *  Calculate the hash value of the URI with FNV-1a.
+ *  @param  uri   A URI string.
+ *  @return The hash value.
+ */
+uint32_t AutoConnect::_hashUri(const char* uri) {
+  uint32_t  hash = 2166136261UL;
+  while (*uri) {
+    hash ^= static_cast<uint8_t>(*uri++);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
 /**
  *  It checks whether the specified character string is a valid IP address.
  *  @param  ipStr   IP string for validation.
  *  @return true    Valid.
  */
-bool AutoConnect::_isIP(String ipStr) {
+bool AutoConnect::_isIP(const String& ipStr) {
   for (uint8_t i = 0; i < ipStr.length(); i++) {
     char c = ipStr.charAt(i);
     if (c != '.' && (c < '0' || c > '9'))
@@ -1102,22 +1581,102 @@ unsigned int AutoConnect::_toWiFiQuality(int32_t rssi) {
  *  @return wl_status_t
  */
 wl_status_t AutoConnect::_waitForConnect(unsigned long timeout) {
-  wl_status_t wifiStatus;
-
   AC_DBG("Connecting");
-  unsigned long st = millis();
-  while ((wifiStatus = WiFi.status()) != WL_CONNECTED) {
-    if (timeout) {
-      if (millis() - st > timeout)
-        break;
-    }
-    AC_DBG_DUMB("%c", '.');
-    delay(300);
+  _startConnect(timeout);
+  while (_pollConnect() == AC_CONNECT_CONNECTING) {
+    delay(1);
+    yield();
   }
+  wl_status_t wifiStatus = WiFi.status();
   AC_DBG_DUMB("%s IP:%s\n", wifiStatus == WL_CONNECTED ? "established" : "time out", WiFi.localIP().toString().c_str());
   return wifiStatus;
 }
 
+/**
+ *  Start the connection attempt that has issued WiFi.begin. The
+ *  attempt is advanced by _pollConnect without blocking, and its
+ *  establishment is notified with the event of the station got IP.
+ *  @param  timeout  Timeout of the attempt [ms], 0 waits endlessly.
+ */
+void AutoConnect::_startConnect(unsigned long timeout) {
+  _stopConnect();
+  _connectEstablished = false;
+#if defined(ARDUINO_ARCH_ESP8266)
+  _gotIPHandler = WiFi.onStationModeGotIP([this](const WiFiEventStationModeGotIP& e) {
+    AC_UNUSED(e);
+    _connectEstablished = true;
+  });
+#elif defined(ARDUINO_ARCH_ESP32)
+  _gotIPEventId = WiFi.onEvent([this](WiFiEvent_t e, WiFiEventInfo_t info) {
+    AC_UNUSED(e);
+    AC_UNUSED(info);
+    _connectEstablished = true;
+  }, WiFiEvent_t::SYSTEM_EVENT_STA_GOT_IP);
+#endif
+  // The IP address may have been obtained before the event handler
+  // is registered.
+  if (WiFi.status() == WL_CONNECTED)
+    _connectEstablished = true;
+
+  _connectState = AC_CONNECT_CONNECTING;
+  _connectStart = _connectTick = millis();
+  _connectLimit = timeout;
+  if (_onConnectExit)
+    _onConnectExit(_connectState);
+}
+
+/**
+ *  Advance the connection attempt. The attempt completes with the
+ *  event of the station got IP, or fails when the timeout expires.
+ *  While in the attempt, the progress is notified with the state of
+ *  AC_CONNECT_CONNECTING at each AUTOCONNECT_CONNECT_TICK.
+ *  @return The state of the connection attempt.
+ */
+AC_CONNECTSTATE_t AutoConnect::_pollConnect(void) {
+  if (_connectState != AC_CONNECT_CONNECTING)
+    return _connectState;
+
+  unsigned long now = millis();
+  bool  tick = now - _connectTick >= AUTOCONNECT_CONNECT_TICK;
+  // Confirm the status at each tick as well, in case the event has
+  // not been issued such as the static IP.
+  if (_connectEstablished || (tick && WiFi.status() == WL_CONNECTED))
+    _connectState = AC_CONNECT_CONNECTED;
+  else if (_connectLimit && now - _connectStart > _connectLimit)
+    _connectState = AC_CONNECT_FAILED;
+  else {
+    if (tick) {
+      _connectTick = now;
+      AC_DBG_DUMB("%c", '.');
+      if (_onConnectExit)
+        _onConnectExit(_connectState);
+    }
+    return _connectState;
+  }
+
+  _stopConnect();
+#ifdef AUTOCONNECT_USE_METRICS
+  _metrics.connect(now - _connectStart, _connectState == AC_CONNECT_CONNECTED);
+#endif // !AUTOCONNECT_USE_METRICS
+  if (_onConnectExit)
+    _onConnectExit(_connectState);
+  return _connectState;
+}
+
+/**
+ *  Release the event handler of the connection attempt.
+ */
+void AutoConnect::_stopConnect(void) {
+#if defined(ARDUINO_ARCH_ESP8266)
+  _gotIPHandler = nullptr;
+#elif defined(ARDUINO_ARCH_ESP32)
+  if (_gotIPEventId != -1) {
+    WiFi.removeEvent(_gotIPEventId);
+    _gotIPEventId = -1;
+  }
+#endif
+}
+
 /**
  *  Control the automatic reconnection behaves. Reconnection behavior
  *  to the AP connected during captive portal operation is activated
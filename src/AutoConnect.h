@@ -29,9 +29,23 @@ using WebServerClass = WebServer;
 #include <EEPROM.h>
 #include <PageBuilder.h>
 #include "AutoConnectDefs.h"
+#include "AutoConnectMemory.h"
+#include "AutoConnectArena.h"
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+#include "AutoConnectStream.h"
 #include "AutoConnectPage.h"
 #include "AutoConnectCredential.h"
+#include "AutoConnectDNS.h"
 #include "AutoConnectTicker.h"
+#include "AutoConnectScan.h"
+#ifdef AUTOCONNECT_USE_METRICS
+#include "AutoConnectMetrics.h"
+#endif
 #include "AutoConnectAux.h"
 
 // The realization of AutoConnectOTA is effective only by the explicit
@@ -79,6 +93,14 @@ typedef enum AC_OTA {
   AC_OTA_BUILTIN
 } AC_OTA_t;
 
+/**< States of the connection attempt notified with AutoConnect::onConnect. */
+typedef enum AC_CONNECTSTATE {
+  AC_CONNECT_IDLE,
+  AC_CONNECT_CONNECTING,
+  AC_CONNECT_CONNECTED,
+  AC_CONNECT_FAILED
+} AC_CONNECTSTATE_t;
+
 class AutoConnectConfig {
  public:
   /**
@@ -103,9 +125,14 @@ class AutoConnectConfig {
     autoRise(true),
     autoReset(true),
     autoReconnect(false),
+    fastReconnect(false),
     immediateStart(false),
     retainPortal(false),
     portalTimeout(AUTOCONNECT_CAPTIVEPORTAL_TIMEOUT),
+    powerSave(false),
+    psram(AC_PSRAM_DEFAULT),
+    pageCache(AUTOCONNECT_PAGECACHE_SIZE),
+    scanCache(AUTOCONNECT_SCANCACHE_AGE),
     menuItems(AC_MENUITEM_CONFIGNEW | AC_MENUITEM_OPENSSIDS | AC_MENUITEM_DISCONNECT | AC_MENUITEM_RESET | AC_MENUITEM_UPDATE | AC_MENUITEM_HOME),
     ticker(false),
     tickerPort(AUTOCONNECT_TICKER_PORT),
@@ -139,9 +166,14 @@ class AutoConnectConfig {
     autoRise(true),
     autoReset(true),
     autoReconnect(false),
+    fastReconnect(false),
     immediateStart(false),
     retainPortal(false),
     portalTimeout(portalTimeout),
+    powerSave(false),
+    psram(AC_PSRAM_DEFAULT),
+    pageCache(AUTOCONNECT_PAGECACHE_SIZE),
+    scanCache(AUTOCONNECT_SCANCACHE_AGE),
     menuItems(AC_MENUITEM_CONFIGNEW | AC_MENUITEM_OPENSSIDS | AC_MENUITEM_DISCONNECT | AC_MENUITEM_RESET | AC_MENUITEM_UPDATE | AC_MENUITEM_HOME),
     ticker(false),
     tickerPort(AUTOCONNECT_TICKER_PORT),
@@ -175,9 +207,14 @@ class AutoConnectConfig {
     autoRise = o.autoRise;
     autoReset = o.autoReset;
     autoReconnect = o.autoReconnect;
+    fastReconnect = o.fastReconnect;
     immediateStart = o.immediateStart;
     retainPortal = o.retainPortal;
     portalTimeout = o.portalTimeout;
+    powerSave = o.powerSave;
+    psram = o.psram;
+    pageCache = o.pageCache;
+    scanCache = o.scanCache;
     menuItems = o.menuItems;
     ticker = o.ticker;
     tickerPort = o.tickerPort;
@@ -211,9 +248,14 @@ class AutoConnectConfig {
   bool      autoRise;           /**< Automatic starting the captive portal */
   bool      autoReset;          /**< Reset ESP8266 module automatically when WLAN disconnected. */
   bool      autoReconnect;      /**< Automatic reconnect with past SSID */
+  bool      fastReconnect;      /**< Reconnect directly with the last known channel and BSSID */
   bool      immediateStart;     /**< Skips WiFi.begin(), start portal immediately */
   bool      retainPortal;       /**< Even if the captive portal times out, it maintains the portal state. */
   unsigned long portalTimeout;  /**< Timeout value for stay in the captive portal */
+  bool      powerSave;          /**< Slow down the captive portal loop while idle */
+  uint16_t  psram;              /**< A compound value of the buffers to be placed in PSRAM */
+  size_t    pageCache;          /**< Memory budget for caching the constructed pages */
+  unsigned long scanCache;      /**< Max age of the cached scan results */
   uint16_t  menuItems;          /**< A compound value of the menu items to be attached */
   bool      ticker;             /**< Drives LED flicker according to WiFi connection status. */
   uint8_t   tickerPort;         /**< GPIO for flicker */
@@ -250,8 +292,12 @@ class AutoConnect {
   void  join(AutoConnectAuxVT auxVector);
   bool  on(const String& uri, const AuxHandlerFunctionT handler, AutoConnectExitOrder_t order = AC_EXIT_AHEAD);
   String where(void) const { return _auxUri; }
-  inline void enableMenu(const uint16_t items) { _apConfig.menuItems |= items; }
-  inline void disableMenu(const uint16_t items) { _apConfig.menuItems &= (0xffff ^ items); }
+  inline void enableMenu(const uint16_t items) { _apConfig.menuItems |= items; _flushPages(); }
+  inline void disableMenu(const uint16_t items) { _apConfig.menuItems &= (0xffff ^ items); _flushPages(); }
+
+  /** For AutoConnectAux described in the descriptors */
+  bool  load(const ACPageDesc_t& aux);
+  bool  load(const ACPageDesc_t* aux, const size_t count);
 
   /** For AutoConnectAux described in JSON */
 #ifdef AUTOCONNECT_USE_JSON
@@ -263,6 +309,9 @@ class AutoConnect {
 
   typedef std::function<bool(IPAddress)>  DetectExit_ft;
   void  onDetect(DetectExit_ft fn);
+  typedef std::function<void(AC_CONNECTSTATE_t)>  ConnectExit_ft;
+  void  onConnect(ConnectExit_ft fn);
+  AC_CONNECTSTATE_t connectState(void) const { return _connectState; }
   void  onNotFound(WebServerClass::THandlerFunction fn);
 
  protected:
@@ -276,17 +325,34 @@ class AutoConnect {
   bool  _getConfigSTA(station_config_t* config);
   void  _startWebServer(void);
   void  _startDNSServer(void);
+#ifdef AUTOCONNECT_USE_METRICS
+  void  _serveMetrics(void);
+#endif
   void  _handleNotFound(void);
+  bool  _fastConnect(const char* ssid);
+  void  _rememberChannel(void);
   bool  _loadAvailCredential(const char* ssid, const AC_PRINCIPLE_t principle = AC_PRINCIPLE_RECENT, const bool excludeCurrent = false);
   void  _stopPortal(void);
   bool  _classifyHandle(HTTPMethod mothod, String uri);
   void  _handleUpload(const String& requestUri, const HTTPUpload& upload);
   void  _purgePages(void);
+  void  _indexAux(void);
+  static uint32_t _hashUri(const char* uri);
+  void  _flushPages(void);
+  std::shared_ptr<PageElement>  _restorePage(const String& uri);
+  void  _cachePage(const String& uri, const std::shared_ptr<PageElement>& elm, const size_t cost);
+  inline void _chunked(const TransferEncoding_t transMode) { _transMode = transMode; _responsePage->chunked(transMode); }
+  inline void _reserve(const size_t rSize) { _reserveSize = rSize; _responsePage->reserve(rSize); }
   virtual PageElement*  _setupPage(String& uri);
+  PageElement*  _deployPage(AutoConnectPageStream* page);
+#ifdef AUTOCONNECT_USE_STREAMRENDER
+  String  _streamPage(std::shared_ptr<AutoConnectPageStream> page, PageArgument& args);
+#endif // !AUTOCONNECT_USE_STREAMRENDER
 #ifdef AUTOCONNECT_USE_JSON
   template<typename T>
   bool  _parseJson(T in);
   bool  _load(JsonVariant& aux);
+  bool  _load(AutoConnectJsonScanner& aux);
 #endif // !AUTOCONNECT_USE_JSON
 
   /** Request handlers implemented by Page Builder */
@@ -297,9 +363,21 @@ class AutoConnect {
 
   /** For portal control */
   bool  _captivePortal(void);
+  PGM_P _captiveProbe(const String& host);
+  void  _setCaptiveRedirect(void);
   bool  _hasTimeout(unsigned long timeout);
-  bool  _isIP(String ipStr);
+  uint8_t _countStations(void);
+  void  _pacePortal(void);
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+  void  _startPortalTask(void);
+  void  _stopPortalTask(void);
+  static void _portalTask(void* pvParameters);
+#endif
+  bool  _isIP(const String& ipStr);
   wl_status_t _waitForConnect(unsigned long timeout);
+  void  _startConnect(unsigned long timeout);
+  AC_CONNECTSTATE_t _pollConnect(void);
+  void  _stopConnect(void);
   void  _waitForEndTransmission(void);
   void  _disconnectWiFi(bool wifiOff);
   void  _setReconnect(const AC_STARECONNECT_t order);
@@ -310,14 +388,22 @@ class AutoConnect {
   static uint32_t      _getFlashChipRealSize(void);
   static String        _toMACAddressString(const uint8_t mac[]);
   static unsigned int  _toWiFiQuality(int32_t rssi);
+  String               _attachCSS(PGM_P css);
+  void                 _emitCSS(Print& out, PGM_P css);
+#ifdef AUTOCONNECT_USE_CSSCACHE
+  void                 _registerCSS(void);
+  void                 _serveCSS(const uint8_t id);
+  static uint32_t      _digestCSS(const uint8_t id);
+#endif // !AUTOCONNECT_USE_CSSCACHE
   DetectExit_ft        _onDetectExit;
+  ConnectExit_ft       _onConnectExit;
   WebServerClass::THandlerFunction _notFoundHandler;
   size_t               _freeHeapSize;
 
   /** Servers which works in concert. */
   typedef std::unique_ptr<WebServerClass, std::function<void(WebServerClass *)> > WebserverUP;
   WebserverUP _webServer = WebserverUP(nullptr, std::default_delete<WebServerClass>());
-  std::unique_ptr<DNSServer>      _dnsServer;
+  std::unique_ptr<AutoConnectDNS> _dnsServer;
 
   /**
    *  Dynamically hold one page of AutoConnect menu.
@@ -325,10 +411,48 @@ class AutoConnect {
    *  menu page corresponding to the URI is generated.
    */
   std::unique_ptr<PageBuilder> _responsePage;
-  std::unique_ptr<PageElement> _currentPageElement;
+  std::shared_ptr<PageElement> _currentPageElement;
+  TransferEncoding_t  _transMode = AUTOCONNECT_HTTP_TRANSFER;  /**< Transfer mode of the current page */
+  size_t              _reserveSize = 0;   /**< Reserved content buffer size of the current page */
+
+  /**
+   *  The constructed pages are kept by their URI to reuse with the next
+   *  request, within the memory budget of AutoConnectConfig::pageCache.
+   *  The most recently used page is at the top, and the least recently
+   *  used page is evicted first.
+   */
+  typedef struct {
+    String  uri;                          /**< URI of the page */
+    std::shared_ptr<PageElement>  element;  /**< Constructed page */
+    String  title;                        /**< Menu title of the page */
+    TransferEncoding_t  transMode;        /**< Transfer mode of the page */
+    size_t  rSize;                        /**< Reserved content buffer size */
+    size_t  cost;                         /**< Heap consumption of the page */
+  } PageCacheST;
+  std::vector<PageCacheST>  _pageCache;
+  size_t        _pageCacheAmount = 0;     /**< Total heap consumption of the cached pages */
+
+  /**
+   *  The request context of the clients that accessed the portal
+   *  recently, up to AUTOCONNECT_CLIENT_CONTEXTS, which are told apart
+   *  only by their IPv4 address. Each keeps the URI of the page that
+   *  the client got last, so the upload is delivered to the page where
+   *  the client posted it from. It is not an isolated state of each
+   *  connection, the page under rendering is still shared, and the
+   *  constructed pages are reused across the clients through the page
+   *  cache within its budget. The most recently accessed client is at
+   *  the top.
+   */
+  typedef struct {
+    uint32_t    addr;                     /**< IPv4 address of the client */
+    String      uri;                      /**< URI of the page last responded */
+  } ClientContextST;
+  std::vector<ClientContextST>  _clientContext;
+  ClientContextST&  _context(void);      /**< Context of the current client */
 
   /** Extended pages made up with AutoConnectAux */
   AutoConnectAux* _aux = nullptr; /**< A top of registered AutoConnectAux */
+  std::vector<AutoConnectAux*>  _auxIndex;  /**< Hash table of registered AutoConnectAux by URI */
   String        _auxUri;        /**< Last accessed AutoConnectAux */
   String        _prevUri;       /**< Previous generated page uri */
   /** Available updater, only reset by AutoConnectUpdate::attach is valid */
@@ -344,21 +468,52 @@ class AutoConnect {
   uint8_t       _connectCh;
   unsigned long _connectTimeout;
   unsigned long _portalAccessPeriod;
+  unsigned long _portalActivity = 0;  /**< millis when the portal was requested last */
+  unsigned long _stationChecked = 0;  /**< millis when the stations of SoftAP were counted */
+  uint8_t       _stations = 0;  /**< Number of the stations associated with SoftAP */
 
   /** The control indicators */
   bool  _rfConnect = false;     /**< URI /connect requested */
+  bool  _rfConnecting = false;  /**< Connection attempt requested by /connect in progress */
   bool  _rfDisconnect = false;  /**< URI /disc requested */
   bool  _rfReset = false;       /**< URI /reset requested */
   wl_status_t   _rsConnect;     /**< connection result */
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_USE_PORTALTASK)
+  /** The portal task */
+  typedef enum {
+    AC_PORTALTASK_STOP          /**< Stop serving the portal */
+  } AC_PORTALTASK_t;
+  TaskHandle_t      _portalServer = nullptr;  /**< The portal task */
+  QueueHandle_t     _portalCommand = nullptr; /**< Commands to the portal task */
+  SemaphoreHandle_t _portalStopped = nullptr; /**< The portal task finished */
+#endif
+
+  /** The connection attempt */
+  AC_CONNECTSTATE_t _connectState = AC_CONNECT_IDLE;  /**< State of the current attempt */
+  unsigned long _connectStart;  /**< Start time of the current attempt */
+  unsigned long _connectLimit;  /**< Timeout of the current attempt */
+  unsigned long _connectTick;   /**< Last time of the progress notification */
+  volatile bool _connectEstablished = false;  /**< IP address obtained by the attempt */
+#if defined(ARDUINO_ARCH_ESP8266)
+  WiFiEventHandler  _gotIPHandler;  /**< STA got IP event handler */
+#elif defined(ARDUINO_ARCH_ESP32)
+  WiFiEventId_t _gotIPEventId = -1; /**< STA got IP event handler registered id */
+#endif
 #ifdef ARDUINO_ARCH_ESP32
   WiFiEventId_t _disconnectEventId = -1; /**< STA disconnection event handler registered id  */
 #endif
   std::unique_ptr<AutoConnectTicker>  _ticker;  /**< */
+  AutoConnectScan _scan;                  /**< Snapshot of the scan results */
+#ifdef AUTOCONNECT_USE_METRICS
+  AutoConnectMetrics  _metrics;           /**< Instrumentation of the portal */
+#endif
 
   /** HTTP header information of the currently requested page. */
   IPAddress     _currentHostIP; /**< host IP address */
   String        _uri;           /**< Requested URI */
   String        _redirectURI;   /**< Redirect destination */
+  String        _captiveRedirect; /**< Redirect response to the captive portal */
   String        _menuTitle;     /**< Title string of the page */
 
   /** PageElements of AutoConnect site. */
@@ -383,6 +538,17 @@ class AutoConnect {
   static const char _PAGE_DISCONN[] PROGMEM;
   static const char _PAGE_FAIL[] PROGMEM;
   static const char _PAGE_404[] PROGMEM;
+  static const char _RESP_NOCONTENT[] PROGMEM;
+  static const char _RESP_SUCCESS[] PROGMEM;
+  static const char _RESP_MSCONNECT[] PROGMEM;
+  static const char _RESP_MSNCSI[] PROGMEM;
+  static const char _RESP_FIREFOX[] PROGMEM;
+
+  /** Connectivity check hosts of the client OS and their online replies. */
+  static const struct CaptiveProbeST {
+    char  host[32];
+    PGM_P reply;
+  } _captiveProbeHost[] PROGMEM;
 
   static const struct PageTranserModeST {
     const char*              uri;
@@ -390,6 +556,14 @@ class AutoConnect {
     const size_t             rSize;
   } _pageBuildMode[];
 
+#ifdef AUTOCONNECT_USE_CSSCACHE
+  /** Style sheets delivered as the cacheable resources. */
+  static const struct CSSResourceST {
+    const char* uri;
+    PGM_P       css;
+  } _cssResource[];
+#endif // !AUTOCONNECT_USE_CSSCACHE
+
   /** Token handlers for PageBuilder */
   String _token_CSS_BASE(PageArgument& args);
   String _token_CSS_UL(PageArgument& args);
@@ -419,7 +593,7 @@ class AutoConnect {
   String _token_FLASH_SIZE(PageArgument& args);
   String _token_CHIP_ID(PageArgument& args);
   String _token_FREE_HEAP(PageArgument& args);
-  String _token_LIST_SSID(PageArgument& args);
+  void   _emitListSSID(Print& out, PageArgument& args);
   String _token_SSID_COUNT(PageArgument& args);
   String _token_HIDDEN_COUNT(PageArgument& args);
   String _token_CONFIG_STAIP(PageArgument& args);
@@ -438,6 +612,7 @@ class AutoConnect {
 #endif
 
   friend class AutoConnectAux;
+  friend class AutoConnectOTA;
   friend class AutoConnectUpdate;
 };
 
@@ -0,0 +1,76 @@
+/**
+ *  AutoConnectArena class implementation.
+ *  Provides the scratch buffers of the request.
+ *  @file   AutoConnectArena.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-17
+ *  @copyright  MIT license.
+ */
+
+#include "AutoConnectArena.h"
+
+namespace {
+  // The buffer is aligned to the word.
+  constexpr size_t  _arenaAlign = sizeof(uint32_t);
+}
+
+/**
+ *  Carve the buffer out of the arena. The buffer is valid until the
+ *  arena is rewound or released, it must not be freed.
+ *  @param  size  Size of the buffer.
+ *  @return The buffer, nullptr if no block can be allocated.
+ */
+void* AutoConnectArena::allocate(const size_t size) {
+  const size_t  aligned = (size + _arenaAlign - 1) & ~(_arenaAlign - 1);
+
+  if (!_block || _block->used + aligned > _block->size) {
+    const size_t  area = aligned > _size ? aligned : _size;
+    ArenaBlockST* block = static_cast<ArenaBlockST*>(AutoConnectMemory::allocate(sizeof(ArenaBlockST) + area, AC_PSRAM_ARENA));
+    if (!block) {
+      AC_DBG("Arena block(%u) allocation failed\n", (unsigned int)area);
+      return nullptr;
+    }
+    block->next = _block;
+    block->size = area;
+    block->used = 0;
+    _block = block;
+  }
+  uint8_t*  buffer = reinterpret_cast<uint8_t*>(_block + 1) + _block->used;
+  _block->used += aligned;
+  return buffer;
+}
+
+/**
+ *  Discard all buffers. The first block is kept for the next request
+ *  and the chained blocks are released.
+ */
+void AutoConnectArena::rewind(void) {
+  while (_block && _block->next) {
+    ArenaBlockST* next = _block->next;
+    AutoConnectMemory::release(_block);
+    _block = next;
+  }
+  if (_block)
+    _block->used = 0;
+}
+
+/**
+ *  Discard all buffers and release all blocks.
+ */
+void AutoConnectArena::release(void) {
+  while (_block) {
+    ArenaBlockST* next = _block->next;
+    AutoConnectMemory::release(_block);
+    _block = next;
+  }
+}
+
+/**
+ *  Get the arena shared by the rendering of the request in progress.
+ *  @return The arena.
+ */
+AutoConnectArena& AutoConnectArena::request(void) {
+  static AutoConnectArena arena;
+  return arena;
+}
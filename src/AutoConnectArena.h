@@ -0,0 +1,50 @@
+/**
+ *  Declaration of AutoConnectArena class.
+ *  @file   AutoConnectArena.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-17
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTARENA_H_
+#define _AUTOCONNECTARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "AutoConnectDefs.h"
+#include "AutoConnectMemory.h"
+
+/**
+ *  A bump allocator for the scratch buffers that live only while a
+ *  request is rendered. The buffers are carved out of a block of
+ *  AUTOCONNECT_ARENA_SIZE in order and they are never freed one by one,
+ *  the whole arena is rewound at the next request and released within
+ *  AutoConnect::_purgePages. The heap is not punctured by the buffers
+ *  freed in random order, so that the largest free block is kept
+ *  during a long uptime. When the block is exhausted, a further block
+ *  is chained. The arena shared by the rendering is obtained with
+ *  AutoConnectArena::request.
+ */
+class AutoConnectArena {
+ public:
+  explicit AutoConnectArena(const size_t size = AUTOCONNECT_ARENA_SIZE) : _block(nullptr), _size(size) {}
+  ~AutoConnectArena() { release(); }
+  void*   allocate(const size_t size);          /**< Carve the buffer out of the arena */
+  void    rewind(void);                         /**< Discard all buffers and keep the first block */
+  void    release(void);                        /**< Discard all buffers and release the blocks */
+  static AutoConnectArena&  request(void);      /**< The arena of the request */
+
+ protected:
+  /** A block of the arena, the area follows the header */
+  typedef struct AutoConnectArenaBlock {
+    struct AutoConnectArenaBlock* next;         /**< The block chained previously */
+    size_t  size;                               /**< Size of the area */
+    size_t  used;                               /**< Size of the area carved out */
+  } ArenaBlockST;
+
+  ArenaBlockST* _block;                         /**< The latest block */
+  size_t  _size;                                /**< Size of the area of a block */
+};
+
+#endif // !_AUTOCONNECTARENA_H_
@@ -78,8 +78,16 @@ const char AutoConnectAux::_PAGE_AUX[] PROGMEM = {
 AutoConnectAux::~AutoConnectAux() {
   _addonElm.clear();
   _addonElm.swap(_addonElm);
+  _generation++;
 }
 
+/**
+ * The generation of the elements placed on all AutoConnectAux pages.
+ * It advances every time the elements change, and the binder of each
+ * AutoConnectAux is rebuilt when it is out of the generation.
+ */
+uint32_t AutoConnectAux::_generation = 1;
+
 /**
  * Returns a null element as static storage.
  * This static element is referred by invalid JSON data.
@@ -96,6 +104,7 @@ AutoConnectElement& AutoConnectAux::_nullElement() {
  */
 void AutoConnectAux::add(AutoConnectElement& addon) {
   _addonElm.push_back(addon);
+  _generation++;
   AC_DBG("%s placed on %s\n", addon.name.length() ? addon.name.c_str() : "*noname", uri());
 }
 
@@ -118,15 +127,11 @@ void AutoConnectAux::fetchElement(void) {
     _ac->_auxUri = _webServer->arg(String(F(AUTOCONNECT_AUXURI_PARAM)));
     _ac->_auxUri.replace("&#47;", "/");
     AC_DBG("fetch %s", _ac->_auxUri.c_str());
-    AutoConnectAux* aux = _ac->_aux;
-    while (aux) {
-      if (aux->_uriStr == _ac->_auxUri) {
-        // Save the value owned by each element contained in the POST body
-        // of a current HTTP request to AutoConnectElements.
-        aux->_storeElements(_webServer);
-        break;
-      }
-      aux = aux->_next;
+    AutoConnectAux* aux = _ac->aux(_ac->_auxUri);
+    if (aux) {
+      // Save the value owned by each element contained in the POST body
+      // of a current HTTP request to AutoConnectElements.
+      aux->_storeElements(_webServer);
     }
   }
 }
@@ -172,7 +177,20 @@ bool AutoConnectAux::release(const String& name) {
     [&](std::reference_wrapper<AutoConnectElement> const elm) {
       return elm.get().name.equalsIgnoreCase(name);
     });
-  return _addonElm.erase(itr, _addonElm.end()) != _addonElm.end();
+  bool  rc = _addonElm.erase(itr, _addonElm.end()) != _addonElm.end();
+  _generation++;
+  return rc;
+}
+
+/**
+ * Set a title of the auxiliary page. The cached pages are discarded
+ * since the title is taken over the menu of the page.
+ * @param  title  A title string of the page.
+ */
+void AutoConnectAux::setTitle(const String& title) {
+  _title = title;
+  if (_ac)
+    _ac->_flushPages();
 }
 
 /**
@@ -185,26 +203,35 @@ bool AutoConnectAux::release(const String& name) {
  */
 bool AutoConnectAux::setElementValue(const String& name, const String value) {
   AutoConnectElement* elm = getElement(name);
-  if (elm) {
-    if (elm->typeOf() == AC_Select) {
-      AutoConnectSelect* elmSelect = reinterpret_cast<AutoConnectSelect*>(elm);
-      elmSelect->select(value);
-    }
-    else {
-      if (elm->typeOf() == AC_Checkbox) {
-        if (value == "checked") {
-          AutoConnectCheckbox* elmCheckbox = reinterpret_cast<AutoConnectCheckbox*>(elm);
-          elmCheckbox->checked = true;
-        }
-      }
-      else if (elm->typeOf() == AC_Radio) {
-        AutoConnectRadio* elmRadio = reinterpret_cast<AutoConnectRadio*>(elm);
-        elmRadio->check(value);
+  return elm ? _setElementValue(*elm, value) : false;
+}
+
+/**
+ * Set the value to the element.
+ * @param  elm   A reference of the element to set the value.
+ * @param  value Setting value. (String)
+ * @return true  The value was set.
+ * @return false The element value does not match storage type.
+ */
+bool AutoConnectAux::_setElementValue(AutoConnectElement& elm, const String& value) {
+  if (elm.typeOf() == AC_Select) {
+    AutoConnectSelect& elmSelect = reinterpret_cast<AutoConnectSelect&>(elm);
+    elmSelect.select(value);
+  }
+  else {
+    if (elm.typeOf() == AC_Checkbox) {
+      if (value == "checked") {
+        AutoConnectCheckbox& elmCheckbox = reinterpret_cast<AutoConnectCheckbox&>(elm);
+        elmCheckbox.checked = true;
       }
-      else
-        elm->value = value;
-      return true;
     }
+    else if (elm.typeOf() == AC_Radio) {
+      AutoConnectRadio& elmRadio = reinterpret_cast<AutoConnectRadio&>(elm);
+      elmRadio.check(value);
+    }
+    else
+      elm.value = value;
+    return true;
   }
   return false;
 }
@@ -264,14 +291,9 @@ void AutoConnectAux::upload(const String& requestUri, const HTTPUpload& upload)
     String  logContext = "missing";
 
     AutoConnectElementVT  addons;
-    AutoConnectAux* aux = _ac->_aux;
-    while (aux) {
-      if (aux->_uriStr == requestUri) {
-        addons = aux->_addonElm;
-        break;
-      }
-      aux = aux->_next;
-    }
+    AutoConnectAux* aux = _ac->aux(requestUri);
+    if (aux)
+      addons = aux->_addonElm;
 
     _currentUpload = nullptr;
     for (AutoConnectElement& elm : addons) {
@@ -352,6 +374,7 @@ void AutoConnectAux::_concat(AutoConnectAux& aux) {
  */
 void AutoConnectAux::_join(AutoConnect& ac) {
   _ac = &ac;
+  _generation++;
 
   // Chain to subsequent AutoConnectAux in the list.
   if (_next)
@@ -420,21 +443,48 @@ const String AutoConnectAux::_indicateEncType(PageArgument& args) {
  */
 const String AutoConnectAux::_insertElement(PageArgument& args) {
   String  body = String("");
+  AutoConnectStringSink out(body);
+
+  _prepareElement(args);
+  _emitElement(out, args);
+  return body;
+}
 
-  // When WebServerClass::handleClient calls RequestHandler, the parsed
-  //  http argument has been prepared.
-  // If the current request argument contains AutoConnectElement, it is
-  // the form data of the AutoConnectAux page and with this timing save
-  // the value of each element.
+/**
+ * Prepare the elements of the page ahead of the rendering.
+ * When WebServerClass::handleClient calls RequestHandler, the parsed
+ * http argument has been prepared. If the current request argument
+ * contains AutoConnectElement, it is the form data of the
+ * AutoConnectAux page and with this timing save the value of each
+ * element. Also, the user handler with AC_EXIT_AHEAD is called here
+ * and its output is kept until the elements are emitted.
+ * @param  args  A reference of PageArgument of the PageBuilder.
+ * @return true  The page continues to be rendered.
+ * @return false The client has gone away.
+ */
+bool AutoConnectAux::_prepareElement(PageArgument& args) {
   fetchElement();
 
   // Call user handler before HTML generation.
+  _aheadContent = String("");
   if (_handler) {
     if (_order & AC_EXIT_AHEAD) {
       AC_DBG("CB in AHEAD %s\n", uri());
-      body += _handler(*this, args);
+      _aheadContent = _handler(*this, args);
     }
   }
+  return _ac->_webServer->client().connected();
+}
+
+/**
+ * Write the HTML of all AutoConnectElements contained in the page into
+ * the sink, with the output of the user handler.
+ * @param  out   A sink to write the HTML.
+ * @param  args  A reference of PageArgument of the PageBuilder.
+ */
+void AutoConnectAux::_emitElement(Print& out, PageArgument& args) {
+  out.print(_aheadContent);
+  _aheadContent = String("");
 
   // Generate HTML for all AutoConnectElements contained in the page.
   for (AutoConnectElement& addon : _addonElm) {
@@ -443,32 +493,29 @@ const String AutoConnectAux::_insertElement(PageArgument& args) {
     // generator by each element.
     if (addon.typeOf() != AC_Style)
       // Invoke an HTML generator by each element
-      body += addon.toHTML();
+      addon.emit(out);
   }
 
   // Call user handler after HTML generation.
   if (_handler) {
     if (_order & AC_EXIT_LATER) {
       AC_DBG("CB in LATER %s\n", uri());
-      body += _handler(*this, args);
+      out.print(_handler(*this, args));
     }
   }
-  return body;
 }
 
 /**
- * Insert user defined CSS code to AutoConnectAux page.
+ * Write user defined CSS code to AutoConnectAux page.
+ * @param  out   A sink to write the CSS.
  * @param  args  A reference of PageArgument but unused.
- * @return HTML string that should be inserted.
  */
-const String AutoConnectAux::_insertStyle(PageArgument& args) {
-  String  css = String("");
-
+void AutoConnectAux::_emitStyle(Print& out, PageArgument& args) {
+  AC_UNUSED(args);
   for (AutoConnectElement& elm : _addonElm) {
     if (elm.typeOf() == AC_Style)
-      css += elm.toHTML();
+      elm.emit(out);
   }
-  return css;
 }
 
 /**
@@ -484,35 +531,38 @@ PageElement* AutoConnectAux::_setupPage(const String& uri) {
   PageElement*  elm = nullptr;
 
   if (_ac) {
-    if (uri != String(_uri)) {
-      if (_next) {
-        elm = _next->_setupPage(uri);
-      }
-    } else {
+    if (uri == String(_uri)) {
       AutoConnect*  mother = _ac;
       // Overwrite actual AutoConnectMenu title to the Aux. page title
       if (_title.length())
         mother->_menuTitle = _title;
 
-      elm = new PageElement();
+      AutoConnectPageStream*  page = new AutoConnectPageStream(_PAGE_AUX);
       // Construct the auxiliary page
-      elm->setMold(_PAGE_AUX);
-      elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("AUX_TITLE")), std::bind(&AutoConnectAux::_injectTitle, this, std::placeholders::_1));
-      elm->addToken(String(FPSTR("CSS_BASE")), std::bind(&AutoConnect::_token_CSS_BASE, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("CSS_UL")), std::bind(&AutoConnect::_token_CSS_UL, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("CSS_INPUT_BUTTON")), std::bind(&AutoConnect::_token_CSS_INPUT_BUTTON, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("CSS_INPUT_TEXT")), std::bind(&AutoConnect::_token_CSS_INPUT_TEXT, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("CSS_LUXBAR")), std::bind(&AutoConnect::_token_CSS_LUXBAR, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("AUX_CSS")), std::bind(&AutoConnectAux::_insertStyle, this, std::placeholders::_1));
-      elm->addToken(String(FPSTR("MENU_PRE")), std::bind(&AutoConnect::_token_MENU_PRE, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("MENU_AUX")), std::bind(&AutoConnect::_token_MENU_AUX, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("MENU_POST")), std::bind(&AutoConnect::_token_MENU_POST, mother, std::placeholders::_1));
-      elm->addToken(String(FPSTR("AUX_URI")), std::bind(&AutoConnectAux::_indicateUri, this, std::placeholders::_1));
-      elm->addToken(String(FPSTR("ENC_TYPE")), std::bind(&AutoConnectAux::_indicateEncType, this, std::placeholders::_1));
-      elm->addToken(String(FPSTR("AUX_ELEMENT")), std::bind(&AutoConnectAux::_insertElement, this, std::placeholders::_1));
+      page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, mother, std::placeholders::_1));
+      page->addToken(F("AUX_TITLE"), std::bind(&AutoConnectAux::_injectTitle, this, std::placeholders::_1));
+      page->addStream(F("CSS_BASE"), std::bind(&AutoConnect::_emitCSS, mother, std::placeholders::_1, AutoConnect::_CSS_BASE));
+      page->addStream(F("CSS_UL"), std::bind(&AutoConnect::_emitCSS, mother, std::placeholders::_1, AutoConnect::_CSS_UL));
+      page->addStream(F("CSS_INPUT_BUTTON"), std::bind(&AutoConnect::_emitCSS, mother, std::placeholders::_1, AutoConnect::_CSS_INPUT_BUTTON));
+      page->addStream(F("CSS_INPUT_TEXT"), std::bind(&AutoConnect::_emitCSS, mother, std::placeholders::_1, AutoConnect::_CSS_INPUT_TEXT));
+      page->addStream(F("CSS_LUXBAR"), std::bind(&AutoConnect::_emitCSS, mother, std::placeholders::_1, AutoConnect::_CSS_LUXBAR));
+      page->addStream(F("AUX_CSS"), std::bind(&AutoConnectAux::_emitStyle, this, std::placeholders::_1, std::placeholders::_2));
+      page->addToken(F("MENU_PRE"), std::bind(&AutoConnect::_token_MENU_PRE, mother, std::placeholders::_1));
+      page->addToken(F("MENU_AUX"), std::bind(&AutoConnect::_token_MENU_AUX, mother, std::placeholders::_1));
+      page->addToken(F("MENU_POST"), std::bind(&AutoConnect::_token_MENU_POST, mother, std::placeholders::_1));
+      page->addToken(F("AUX_URI"), std::bind(&AutoConnectAux::_indicateUri, this, std::placeholders::_1));
+      page->addToken(F("ENC_TYPE"), std::bind(&AutoConnectAux::_indicateEncType, this, std::placeholders::_1));
+#ifdef AUTOCONNECT_USE_STREAMRENDER
+      // The elements are prepared ahead of the rendering since the
+      // user handler may respond by itself, such as the redirection.
+      page->onPrologue(std::bind(&AutoConnectAux::_prepareElement, this, std::placeholders::_1));
+      page->addStream(F("AUX_ELEMENT"), std::bind(&AutoConnectAux::_emitElement, this, std::placeholders::_1, std::placeholders::_2));
+#else
+      page->addToken(F("AUX_ELEMENT"), std::bind(&AutoConnectAux::_insertElement, this, std::placeholders::_1));
+#endif // !AUTOCONNECT_USE_STREAMRENDER
       // Restore transfer mode by each page
-      mother->_responsePage->chunked(chunk);
+      mother->_chunked(chunk);
+      elm = mother->_deployPage(page);
     }
   }
   return elm;
@@ -525,43 +575,360 @@ PageElement* AutoConnectAux::_setupPage(const String& uri) {
  * @param webServer A pointer to the class object of WebServerClass
  */
 void AutoConnectAux::_storeElements(WebServerClass* webServer) {
-  // Retrieve each element value, Overwrites the value of all cataloged
-  // AutoConnectElements with arguments inherited from last http request.
-  for (AutoConnectElement& elm : _addonElm) {
+  // The binder is rebuilt only when the elements of any AutoConnectAux
+  // have been changed since the last build.
+  if (_bindGeneration != _generation)
+    _bindElements();
 
-    // The POST body does not contain the value of the AutoConnectFile,
-    // so it can not be obtained with the WebServerClass::arg function.
-    // The AutoConnectFile value will be restored from least recent
-    // upload request.
-    if (elm.typeOf() == AC_File)
-      continue;
-
-    // Relies on AutoConnectRadio, it restores to false at the being
-    // because the checkbox argument will not pass if it is not checked.
+  // Relies on AutoConnectRadio, it restores to false at the being
+  // because the checkbox argument will not pass if it is not checked.
+  for (AutoConnectElement& elm : _addonElm)
     if (elm.typeOf() == AC_Checkbox)
       reinterpret_cast<AutoConnectCheckbox&>(elm).checked = false;
 
-    // Seek by argument, store the value to its element.
-    for (int8_t n = 0; n < static_cast<int8_t>(webServer->args()); n++) {
-      if (webServer->argName(n).equalsIgnoreCase(elm.name)) {
-        String  elmValue = webServer->arg(n);
-        if (elm.typeOf() == AC_Checkbox)
-          elmValue = "checked";
-        setElementValue(elm.name, elmValue);
-
-        // Copy a value to other elements declared as global.
-        if (elm.global) {
-          AutoConnectAux* aux = _ac->_aux;
-          while (aux) {
-            if (aux != this)
-              aux->setElementValue(elm.name, elmValue);
-            aux = aux->_next;
+  // Retrieve each argument inherited from last http request, overwrites
+  // the value of the AutoConnectElement bound to the argument name.
+  for (int8_t n = 0; n < static_cast<int8_t>(webServer->args()); n++) {
+    const ElementBindST*  bind = _findBind(webServer->argName(n));
+    if (!bind)
+      continue;
+    String  elmValue = webServer->arg(n);
+    if (bind->element->typeOf() == AC_Checkbox)
+      elmValue = "checked";
+    _setElementValue(*bind->element, elmValue);
+
+    // Copy a value to other elements declared as global.
+    for (uint16_t s = bind->subFrom; s < bind->subFrom + bind->subCount; s++)
+      _setElementValue(*_subscriber[s], elmValue);
+  }
+  AC_DBG_DUMB(",elements stored\n");
+}
+
+/**
+ * Build the binder that associates the argument name of the http
+ * request with the AutoConnectElement. The binder is an open-addressed
+ * hash table keyed by the case-folded element name. The AutoConnectFile
+ * is excluded since the POST body does not contain its value, it will
+ * be restored from least recent upload request. For the element
+ * declared as global, the elements of the same name placed on the other
+ * AutoConnectAux pages are listed as the subscribers.
+ */
+void AutoConnectAux::_bindElements(void) {
+  size_t  size = 4;
+  while (size < _addonElm.size() * 2)
+    size <<= 1;
+  _binder.assign(size, { 0, nullptr, 0, 0 });
+  _subscriber.clear();
+
+  const size_t  mask = size - 1;
+  for (AutoConnectElement& elm : _addonElm) {
+    if (elm.typeOf() == AC_File || !elm.name.length())
+      continue;
+    uint32_t  hash = _hashName(elm.name);
+    size_t  n = hash & mask;
+    while (_binder[n].element && !(_binder[n].hash == hash && _binder[n].element->name.equalsIgnoreCase(elm.name)))
+      n = (n + 1) & mask;
+    // The first element takes precedence as same as getElement.
+    if (_binder[n].element)
+      continue;
+    _binder[n] = { hash, &elm, static_cast<uint16_t>(_subscriber.size()), 0 };
+
+    if (elm.global && _ac) {
+      for (AutoConnectAux* aux = _ac->_aux; aux; aux = aux->_next) {
+        if (aux == this)
+          continue;
+        for (AutoConnectElement& other : aux->_addonElm)
+          if (other.name.equalsIgnoreCase(elm.name)) {
+            _subscriber.push_back(&other);
+            _binder[n].subCount++;
+            break;
           }
-        }
       }
     }
   }
-  AC_DBG_DUMB(",elements stored\n");
+  _bindGeneration = _generation;
+}
+
+/**
+ * Find the element bound to the argument name.
+ * @param  name  An argument name of the http request.
+ * @return A pointer to the binder entry, nullptr if not bound.
+ */
+const AutoConnectAux::ElementBindST* AutoConnectAux::_findBind(const String& name) const {
+  const size_t  mask = _binder.size() - 1;
+  uint32_t  hash = _hashName(name);
+  size_t  n = hash & mask;
+  while (_binder[n].element) {
+    if (_binder[n].hash == hash && _binder[n].element->name.equalsIgnoreCase(name))
+      return &_binder[n];
+    n = (n + 1) & mask;
+  }
+  return nullptr;
+}
+
+/**
+ * Calculate the case-folded hash value of the element name with FNV-1a.
+ * @param  name  An element name.
+ * @return The hash value.
+ */
+uint32_t AutoConnectAux::_hashName(const String& name) {
+  uint32_t  hash = 2166136261UL;
+  for (size_t n = 0; n < name.length(); n++) {
+    hash ^= static_cast<uint8_t>(tolower(name[n]));
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+/**
+ * Load AutoConnectAux page from the descriptors placed in PROGMEM.
+ * This function can load AutoConnectAux for multiple AUX pages and is
+ * registered in AutoConnect.
+ * @param  aux   A descriptor of the page to be load.
+ * @return true  Successfully loaded.
+ */
+bool AutoConnect::load(const ACPageDesc_t& aux) {
+  return load(&aux, 1);
+}
+
+/**
+ * Load AutoConnectAux pages from the array of the descriptors placed
+ * in PROGMEM.
+ * @param  aux   The descriptors of the pages to be load.
+ * @param  count Number of the pages.
+ * @return true  Successfully loaded.
+ */
+bool AutoConnect::load(const ACPageDesc_t* aux, const size_t count) {
+  for (size_t n = 0; n < count; n++) {
+    AutoConnectAux* newAux = new AutoConnectAux;
+    if (!newAux->load(aux[n])) {
+      delete newAux;
+      return false;
+    }
+    join(*newAux);
+  }
+  return true;
+}
+
+/**
+ * Constructs an AutoConnectAux instance from the descriptor of the
+ * page. It is equivalent to loading the JSON document but it does not
+ * parse anything, the elements are instantiated directly according to
+ * the descriptors that can be declared at the compile time.
+ * @param  page  A descriptor of the page placed in PROGMEM.
+ * @return true  The element collection successfully loaded.
+ * @return false Invalid descriptor. 
+ */
+bool AutoConnectAux::load(const ACPageDesc_t& page) {
+  ACPageDesc_t  desc;
+  memcpy_P(&desc, &page, sizeof(ACPageDesc_t));
+  _title = desc.title ? String(FPSTR(desc.title)) : String("");
+  _uriStr = desc.uri ? String(FPSTR(desc.uri)) : String("");
+  _uri = _uriStr.c_str();
+  if (_ac) {
+    // The URI of the page already joined has changed.
+    _ac->_indexAux();
+    _ac->_flushPages();
+  }
+  _menu = desc.menu;
+  return loadElement(desc.elements, desc.count);
+}
+
+/**
+ * Load the elements from the descriptors. The element whose name is
+ * already placed on the page is overwritten with the descriptor.
+ * @param  elements  The descriptors of the elements placed in PROGMEM.
+ * @param  count     Number of the elements.
+ * @return true  All elements successfully loaded.
+ * @return false Some elements are not loaded.
+ */
+bool AutoConnectAux::loadElement(const ACElementDesc_t* elements, const size_t count) {
+  bool  rc = true;
+  for (size_t n = 0; n < count; n++) {
+    ACElementDesc_t desc;
+    memcpy_P(&desc, &elements[n], sizeof(ACElementDesc_t));
+    if (!_loadElement(desc).name.length())
+      rc = false;
+  }
+  return rc;
+}
+
+/**
+ * Load an element from the descriptor.
+ * @param  desc  A descriptor of the element copied to RAM.
+ * @return A reference of loaded AutoConnectElement instance.
+ */
+AutoConnectElement& AutoConnectAux::_loadElement(const ACElementDesc_t& desc) {
+  if (!desc.name) {
+    AC_DBG("Element name missing\n");
+    return _nullElement();
+  }
+  String  elmName = String(FPSTR(desc.name));
+  AutoConnectElement* auxElm = getElement(elmName);
+  if (!auxElm) {
+    auxElm = _createElement(desc.type);
+    auxElm->name = elmName;
+    AC_DBG("%s<%d> of %s created\n", elmName.c_str(), (int)(auxElm->typeOf()), uri());
+    add(*auxElm);
+  }
+  else if (auxElm->typeOf() != desc.type) {
+    AC_DBG("Type of %s element mismatched\n", elmName.c_str());
+    return _nullElement();
+  }
+
+  // Split the items of AC_Radio and AC_Select separated by '\n'.
+  auto items = [&desc](std::function<void(const String&)> add) {
+    String  values = String(FPSTR(desc.value));
+    int     from = 0;
+    while (from < (int)values.length()) {
+      int to = values.indexOf('\n', from);
+      if (to < 0)
+        to = values.length();
+      add(values.substring(from, to));
+      from = to + 1;
+    }
+  };
+
+  auxElm->post = desc.post;
+  auxElm->global = desc.global;
+  if (desc.value && desc.type != AC_Radio && desc.type != AC_Select)
+    auxElm->value = String(FPSTR(desc.value));
+  switch (desc.type) {
+  case AC_Button: {
+    AutoConnectButton&  elm = auxElm->as<AutoConnectButton>();
+    if (desc.label)
+      elm.action = FPSTR(desc.label);
+    break;
+  }
+  case AC_Checkbox: {
+    AutoConnectCheckbox&  elm = auxElm->as<AutoConnectCheckbox>();
+    if (desc.label)
+      elm.label = FPSTR(desc.label);
+    elm.checked = desc.checked;
+    elm.labelPosition = static_cast<ACPosition_t>(desc.arrange);
+    break;
+  }
+  case AC_File: {
+    AutoConnectFile&  elm = auxElm->as<AutoConnectFile>();
+    if (desc.label)
+      elm.label = FPSTR(desc.label);
+    elm.store = static_cast<ACFile_t>(desc.arrange);
+    break;
+  }
+  case AC_Input: {
+    AutoConnectInput& elm = auxElm->as<AutoConnectInput>();
+    if (desc.label)
+      elm.label = FPSTR(desc.label);
+    if (desc.pattern)
+      elm.pattern = FPSTR(desc.pattern);
+    if (desc.placeholder)
+      elm.placeholder = FPSTR(desc.placeholder);
+    break;
+  }
+  case AC_Radio: {
+    AutoConnectRadio& elm = auxElm->as<AutoConnectRadio>();
+    if (desc.label)
+      elm.label = FPSTR(desc.label);
+    if (desc.value) {
+      elm.empty();
+      items([&elm](const String& v) { elm.add(v); });
+    }
+    elm.checked = static_cast<uint8_t>(desc.checked);
+    elm.order = static_cast<ACArrange_t>(desc.arrange);
+    break;
+  }
+  case AC_Select: {
+    AutoConnectSelect&  elm = auxElm->as<AutoConnectSelect>();
+    if (desc.label)
+      elm.label = FPSTR(desc.label);
+    if (desc.value) {
+      elm.empty();
+      items([&elm](const String& v) { elm.add(v); });
+    }
+    elm.selected = static_cast<uint8_t>(desc.checked);
+    break;
+  }
+  case AC_Submit: {
+    AutoConnectSubmit&  elm = auxElm->as<AutoConnectSubmit>();
+    if (desc.label)
+      elm.uri = FPSTR(desc.label);
+    break;
+  }
+  case AC_Text: {
+    AutoConnectText&  elm = auxElm->as<AutoConnectText>();
+    if (desc.label)
+      elm.style = FPSTR(desc.label);
+    if (desc.pattern)
+      elm.format = FPSTR(desc.pattern);
+    break;
+  }
+  default:
+    break;
+  }
+  AC_DBG("%s<%d> of %s loaded\n", auxElm->name.c_str(), (int)auxElm->typeOf(), uri());
+  return *auxElm;
+}
+
+/**
+ * Create an instance of the AutoConnectElement of the type.
+ * @param  type  Type of the element.
+ * @return A pointer of created AutoConnectElement instance.
+ */
+AutoConnectElement* AutoConnectAux::_createElement(const ACElement_t type) {
+  switch (type) {
+  case AC_Button: {
+    AutoConnectButton*  cert_elm = new AutoConnectButton;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_Checkbox: {
+    AutoConnectCheckbox*  cert_elm = new AutoConnectCheckbox;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_File: {
+    AutoConnectFile* cert_elm = new AutoConnectFile;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_Input: {
+    AutoConnectInput* cert_elm = new AutoConnectInput;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_Radio: {
+    AutoConnectRadio*  cert_elm = new AutoConnectRadio;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_Select: {
+    AutoConnectSelect*  cert_elm = new AutoConnectSelect;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_Style: {
+    AutoConnectStyle*  cert_elm = new AutoConnectStyle;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_Submit: {
+    AutoConnectSubmit*  cert_elm = new AutoConnectSubmit;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_Text: {
+    AutoConnectText*  cert_elm = new AutoConnectText;
+    cert_elm->_native = true;
+    return reinterpret_cast<AutoConnectElement*>(cert_elm);
+  }
+  case AC_Element:
+  case AC_Unknown:
+  default:
+    break;
+  }
+  AutoConnectElement* cert_elm = new AutoConnectElement;
+  cert_elm->_native = true;
+  return cert_elm;
 }
 
 #ifdef AUTOCONNECT_USE_JSON
@@ -602,12 +969,14 @@ bool AutoConnect::load(const String& aux) {
 /**
  * Load AutoConnectAux page from JSON description from the stream.
  * This function can load AutoConnectAux for multiple AUX pages written
- * in JSON and is registered in AutoConnect.
+ * in JSON and is registered in AutoConnect. The stream is loaded
+ * element by element without deserializing the whole document.
  * @param  aux  Stream for read AutoConnectAux elements.
  * @return true Successfully loaded.
  */
 bool AutoConnect::load(Stream& aux) {
-  return _parseJson<Stream&>(aux);
+  AutoConnectJsonScanner  scanner(aux);
+  return _load(scanner);
 }
 
 /**
@@ -643,58 +1012,39 @@ bool AutoConnect::_load(JsonVariant& auxJson) {
   return rc;
 }
 
+/**
+ * Load AutoConnectAux pages from JSON stream. Each page is joined as
+ * soon as it is loaded, the pages preceding the broken one remain
+ * joined.
+ * @param  aux  A scanner of the JSON stream positioned at the top of
+ * the page or the array of the pages.
+ * @return true Successfully loaded.
+ */
+bool AutoConnect::_load(AutoConnectJsonScanner& aux) {
+  bool  array = aux.next('[');
+
+  if (array && aux.next(']'))
+    return true;
+  do {
+    AutoConnectAux* newAux = new AutoConnectAux;
+    if (newAux->_load(aux))
+      join(*newAux);
+    else {
+      delete newAux;
+      return false;
+    }
+  } while (array && aux.next(','));
+  return !array || aux.next(']');
+}
+
 /**
  * Create an instance from the AutoConnectElement of the JSON object.
  * @param  json  A reference of JSON
  * @return A pointer of created AutoConnectElement instance.
  */
 AutoConnectElement* AutoConnectAux::_createElement(const JsonObject& json) {
-  AutoConnectElement* elm = nullptr;
   String  type = json[F(AUTOCONNECT_JSON_KEY_TYPE)].as<String>();
-
-  switch (_asElementType(type)) {
-  case AC_Element:
-  case AC_Unknown:
-    elm = new AutoConnectElement;
-    break;
-  case AC_Button: {
-    AutoConnectButton*  cert_elm = new AutoConnectButton;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  case AC_Checkbox: {
-    AutoConnectCheckbox*  cert_elm = new AutoConnectCheckbox;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  case AC_File: {
-    AutoConnectFile* cert_elm = new AutoConnectFile;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  case AC_Input: {
-    AutoConnectInput* cert_elm = new AutoConnectInput;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  case AC_Radio: {
-    AutoConnectRadio*  cert_elm = new AutoConnectRadio;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  case AC_Select: {
-    AutoConnectSelect*  cert_elm = new AutoConnectSelect;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  case AC_Style: {
-    AutoConnectStyle*  cert_elm = new AutoConnectStyle;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  case AC_Submit: {
-    AutoConnectSubmit*  cert_elm = new AutoConnectSubmit;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  case AC_Text: {
-    AutoConnectText*  cert_elm = new AutoConnectText;
-    return reinterpret_cast<AutoConnectElement*>(cert_elm);
-  }
-  }
-  return elm;
+  return _createElement(_asElementType(type));
 }
 
 /**
@@ -742,7 +1092,8 @@ bool AutoConnectAux::load(const __FlashStringHelper* in) {
  * @return false Invalid JSON data occurred. 
  */
 bool AutoConnectAux::load(Stream& in) {
-  return _parseJson<Stream&>(in);
+  AutoConnectJsonScanner  scanner(in);
+  return _load(scanner);
 }
 
 /**
@@ -755,12 +1106,77 @@ bool AutoConnectAux::_load(JsonObject& jb) {
   _title = jb[F(AUTOCONNECT_JSON_KEY_TITLE)].as<String>();
   _uriStr = jb[F(AUTOCONNECT_JSON_KEY_URI)].as<String>();
   _uri = _uriStr.c_str();
+  if (_ac) {
+    // The URI of the page already joined has changed.
+    _ac->_indexAux();
+    _ac->_flushPages();
+  }
   _menu = jb[F(AUTOCONNECT_JSON_KEY_MENU)].as<bool>();
-  JsonVariant elements = jb[F(AUTOCONNECT_JSON_KEY_ELEMENT)];
-  (void)_loadElement(elements, "");
+  if (jb.containsKey(F(AUTOCONNECT_JSON_KEY_ELEMENT))) {
+    JsonVariant elements = jb[F(AUTOCONNECT_JSON_KEY_ELEMENT)];
+    (void)_loadElement(elements, "");
+  }
   return true;
 }
 
+/**
+ * Load all elements of AutoConectAux page from JSON stream. The
+ * elements are deserialized one by one as they arrive, and the other
+ * members of the page are collected into a small object and loaded
+ * at the end of the page.
+ * @param  in    A scanner of the JSON stream positioned at the page.
+ * @return true  Successfully loaded.
+ * @return false loading unsuccessful, JSON parsing error occurred.
+ */
+bool AutoConnectAux::_load(AutoConnectJsonScanner& in) {
+  String  page = String('{');
+  size_t  nodes = 0;
+
+  if (!in.next('{'))
+    return false;
+  if (!in.next('}')) {
+    do {
+      String  key;
+      if (!in.key(key))
+        return false;
+      if (key.equals(F(AUTOCONNECT_JSON_KEY_ELEMENT))) {
+        if (!_loadElement(in, std::vector<String>()) && in.hasError())
+          return false;
+        continue;
+      }
+      size_t  valueNodes;
+      if (page.length() > 1)
+        page += ',';
+      page += '"';
+      page += key;
+      page += String(F("\":"));
+      if (!in.capture(&page, &valueNodes))
+        return false;
+      nodes += valueNodes + 1;
+    } while (in.next(','));
+    if (!in.next('}'))
+      return false;
+  }
+  page += '}';
+
+  ArduinoJsonBuffer jsonBuffer(JSON_ARRAY_SIZE(nodes));
+#if ARDUINOJSON_VERSION_MAJOR<=5
+  JsonObject& jb = jsonBuffer.parseObject(&page[0]);
+  if (!jb.success()) {
+    AC_DBG("JSON parse error\n");
+    return false;
+  }
+#else
+  DeserializationError  err = deserializeJson(jsonBuffer, &page[0]);
+  if (err) {
+    AC_DBG("Deserialize:%s\n", err.c_str());
+    return false;
+  }
+  JsonObject jb = jsonBuffer.as<JsonObject>();
+#endif
+  return _load(jb);
+}
+
 /**
  * Load element specified by the name parameter from the stream
  * described by JSON. Usually, the Stream is specified a storm file of
@@ -783,7 +1199,11 @@ bool AutoConnectAux::loadElement(const String& in, const String& name) {
   return _parseElement<const String&, const String&>(in, name);
 }
 bool AutoConnectAux::loadElement(Stream& in, const String& name) {
-  return _parseElement<Stream&, const String&>(in, name);
+  AutoConnectJsonScanner  scanner(in);
+  std::vector<String> names;
+  if (name.length())
+    names.push_back(name);
+  return _loadElement(scanner, names);
 }
 
 bool AutoConnectAux::loadElement(PGM_P in, std::vector<String> const& names) {
@@ -799,7 +1219,8 @@ bool AutoConnectAux::loadElement(const String& in, std::vector<String> const& na
 }
 
 bool AutoConnectAux::loadElement(Stream& in, std::vector<String> const& names) {
-  return _parseElement<Stream&, std::vector<String> const&>(in, names);
+  AutoConnectJsonScanner  scanner(in);
+  return _loadElement(scanner, names);
 }
 
 bool AutoConnectAux::_loadElement(JsonVariant& jb, std::vector<String> const& names) {
@@ -869,6 +1290,73 @@ AutoConnectElement& AutoConnectAux::_loadElement(JsonObject& element, const Stri
   return auxElm ? *auxElm : _nullElement();
 }
 
+/**
+ * Load the elements from JSON stream one by one. Each element object
+ * is captured and deserialized with the document sized for it, and
+ * the document is discarded before the next element is read, so the
+ * memory required is that of the largest element.
+ * @param  in    A scanner of the JSON stream positioned at the element
+ * or the array of the elements.
+ * @param  names The element names to be loaded, empty for all.
+ * @return true  All specified elements have been loaded, or some
+ * element has been loaded when no name is specified.
+ */
+bool AutoConnectAux::_loadElement(AutoConnectJsonScanner& in, std::vector<String> const& names) {
+  std::vector<bool> found(names.size(), false);
+  size_t  loaded = 0;
+  size_t  matched = 0;
+  bool    array = in.next('[');
+
+  if (!array || !in.next(']')) {
+    do {
+      String  text;
+      size_t  nodes;
+      text.reserve(AUTOCONNECT_JSONBUFFER_SIZE);
+      if (!in.capture(&text, &nodes))
+        return false;
+
+      // The element that cannot be deserialized is skipped, the stream
+      // stays at the boundary of the elements.
+      ArduinoJsonBuffer jsonBuffer(JSON_ARRAY_SIZE(nodes));
+#if ARDUINOJSON_VERSION_MAJOR<=5
+      JsonObject& element = jsonBuffer.parseObject(&text[0]);
+      if (!element.success()) {
+        AC_DBG("JSON parse error\n");
+        continue;
+      }
+#else
+      DeserializationError  err = deserializeJson(jsonBuffer, &text[0]);
+      if (err) {
+        AC_DBG("Deserialize:%s\n", err.c_str());
+        continue;
+      }
+      JsonObject element = jsonBuffer.as<JsonObject>();
+#endif
+      // Picks the element of the specified names.
+      size_t  n = 0;
+      if (names.size()) {
+        String  elmName = element[F(AUTOCONNECT_JSON_KEY_NAME)].as<String>();
+        while (n < names.size() && !names[n].equalsIgnoreCase(elmName))
+          n++;
+        if (n >= names.size() || found[n])
+          continue;
+      }
+      if (_loadElement(element, String("")).name.length()) {
+        loaded++;
+        if (names.size()) {
+          found[n] = true;
+          // The rest of the stream is left unread.
+          if (++matched >= names.size())
+            return true;
+        }
+      }
+    } while (array && in.next(','));
+    if (array && !in.next(']'))
+      return false;
+  }
+  return names.size() ? matched >= names.size() : loaded > 0;
+}
+
 /**
  * Serialize an element specified the name into the stream.
  * @param  name  An element name to be output.
@@ -17,9 +17,11 @@
 #include <type_traits>
 #ifdef AUTOCONNECT_USE_JSON
 #include <Stream.h>
+#include "AutoConnectJsonScanner.h"
 #endif // !AUTOCONNECT_USE_JSON
 #include <PageBuilder.h>
 #include "AutoConnectElement.h"
+#include "AutoConnectStream.h"
 
 class AutoConnect;  // Reference to avoid circular
 class AutoConnectAux;  // Reference to avoid circular
@@ -37,6 +39,27 @@ typedef enum {
   AC_EXIT_BOTH = 3      /**< Callback twice before and after building HTML */
 } AutoConnectExitOrder_t;
 
+/**
+ * A descriptor of AutoConnectAux page which can be placed in PROGMEM
+ * together with the descriptors of the elements.
+ */
+typedef struct {
+  const char*   uri;          /**< URI of the page */
+  const char*   title;        /**< Title of the page */
+  bool          menu;         /**< Whether to display in menu */
+  const ACElementDesc_t*  elements; /**< Descriptors of the elements */
+  size_t        count;        /**< Number of the elements */
+} ACPageDesc_t;
+
+/**
+ * Support declare the descriptor of AutoConnectAux page at the compile
+ * time. The number of the elements is derived from the array.
+ */
+template<size_t N>
+constexpr ACPageDesc_t ACPageDesc(const char* uri, const char* title, const bool menu, const ACElementDesc_t (&elements)[N]) {
+  return { uri, title, menu, elements, N };
+}
+
 /**
  * A class that handles an auxiliary page with AutoConnectElement
  * that placed on it by binding it to the AutoConnect menu.
@@ -64,8 +87,10 @@ class AutoConnectAux : public PageBuilder {
   bool  release(const String& name);                                    /**< Release an AutoConnectElement */
   bool  setElementValue(const String& name, const String value);        /**< Set value to specified element */
   bool  setElementValue(const String& name, std::vector<String> const& values);  /**< Set values collection to specified element */
-  void  setTitle(const String& title) { _title = title; }               /**< Set a title of the auxiliary page */
+  void  setTitle(const String& title);                                  /**< Set a title of the auxiliary page */
   void  on(const AuxHandlerFunctionT handler, const AutoConnectExitOrder_t order = AC_EXIT_AHEAD) { _handler = handler; _order = order; }   /**< Set user handler */
+  bool  load(const ACPageDesc_t& page);                                 /**< Load whole elements from the descriptor */
+  bool  loadElement(const ACElementDesc_t* elements, const size_t count); /**< Load elements from the descriptors */
   void  onUpload(PageBuilder::UploadFuncT uploadFunc) override { _uploadHandler = uploadFunc; }
   template<typename T>
   void  onUpload(T& uploadClass) {
@@ -97,21 +122,30 @@ class AutoConnectAux : public PageBuilder {
   void  _join(AutoConnect& ac);                                         /**< Make a link to AutoConnect */
   PageElement*  _setupPage(const String& uri);                          /**< AutoConnectAux page builder */
   const String  _insertElement(PageArgument& args);                     /**< Insert a generated HTML to the page built by PageBuilder */
-  const String  _insertStyle(PageArgument& args);                       /**< Insert CSS style */
+  bool  _prepareElement(PageArgument& args);                            /**< Fetch the elements and call the AHEAD handler */
+  void  _emitElement(Print& out, PageArgument& args);                   /**< Write a generated HTML into the sink */
+  void  _emitStyle(Print& out, PageArgument& args);                     /**< Write CSS style into the sink */
   const String  _injectTitle(PageArgument& args) const { (void)(args); return _title; } /**< Returns title of this page to PageBuilder */
   const String  _injectMenu(PageArgument& args);                        /**< Inject menu title of this page to PageBuilder */
   const String  _indicateUri(PageArgument& args);                       /**< Inject the uri that caused the request */
   const String  _indicateEncType(PageArgument& args);                   /**< Inject the ENCTYPE attribute */
   void  _storeElements(WebServerClass* webServer);                      /**< Store element values from contained in request arguments */
+  void  _bindElements(void);                                            /**< Build the binder of the request arguments to the elements */
+  static bool _setElementValue(AutoConnectElement& elm, const String& value); /**< Set value to the element */
+  static uint32_t _hashName(const String& name);                        /**< Case-folded hash of the element name */
   static AutoConnectElement&  _nullElement(void);                       /**< A static returning value as invalid */
+  AutoConnectElement& _loadElement(const ACElementDesc_t& desc);        /**< Load an element from the descriptor */
+  static AutoConnectElement*  _createElement(const ACElement_t type);   /**< Create an AutoConnectElement instance of the type */
 
 #ifdef AUTOCONNECT_USE_JSON
   template<typename T>
   bool  _parseJson(T in);
   bool  _load(JsonObject& in);                                          /**< Load all elements from JSON object */
+  bool  _load(AutoConnectJsonScanner& in);                              /**< Load all elements from JSON stream */
   bool  _loadElement(JsonVariant& in, const String& name);              /**< Load an element as specified name from JSON object */
   bool  _loadElement(JsonVariant& in, std::vector<String> const& names);  /**< Load any elements as specified name from JSON object */
   AutoConnectElement& _loadElement(JsonObject& in, const String& name); /**< Load an element as specified name from JSON object */
+  bool  _loadElement(AutoConnectJsonScanner& in, std::vector<String> const& names);  /**< Load the elements from JSON stream one by one */
   AutoConnectElement* _createElement(const JsonObject& json);           /**< Create an AutoConnectElement instance from JSON object */
   static ACElement_t  _asElementType(const String& type);               /**< Convert a string of element type to the enumeration value */
   /**
@@ -153,6 +187,20 @@ class AutoConnectAux : public PageBuilder {
   AuxHandlerFunctionT   _handler;             /**< User sketch callback function when AutoConnectAux page requested. */
   AutoConnectExitOrder_t  _order;             /**< The order in which callback functions are called. */
   PageBuilder::UploadFuncT    _uploadHandler; /**< The AutoConnectFile corresponding to current upload */
+  String  _aheadContent;                      /**< Output of the AC_EXIT_AHEAD handler held until the elements emitted */
+
+  /** Binder of the request arguments to the elements */
+  typedef struct {
+    uint32_t  hash;                           /**< Case-folded hash of the element name */
+    AutoConnectElement* element;              /**< Bound element */
+    uint16_t  subFrom;                        /**< Top of the subscribers in _subscriber */
+    uint16_t  subCount;                       /**< Number of the subscribers */
+  } ElementBindST;
+  const ElementBindST*  _findBind(const String& name) const;            /**< Find the element bound to the argument */
+  std::vector<ElementBindST>  _binder;        /**< Hash table of the elements by name */
+  std::vector<AutoConnectElement*>  _subscriber;  /**< Elements of the other pages that subscribe the global elements */
+  uint32_t  _bindGeneration = 0;              /**< The generation of the elements when the binder built */
+  static uint32_t _generation;                /**< The generation of the elements of all pages */
   AutoConnectFile*      _currentUpload;       /**< AutoConnectFile handling the current upload */
   static const char _PAGE_AUX[] PROGMEM;      /**< Auxiliary page template */
 
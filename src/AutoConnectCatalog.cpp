@@ -0,0 +1,294 @@
+/**
+ *  AutoConnectCatalog class implementation.
+ *  Parses the catalog list of the update server entry by entry.
+ *  @file   AutoConnectCatalog.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-08
+ *  @copyright  MIT license.
+ */
+
+#include "AutoConnectCatalog.h"
+
+/**
+ *  Enter the catalog array. The stream must begin with the array
+ *  after the white spaces.
+ *  @return true  The array has been entered.
+ */
+bool AutoConnectCatalog::begin(void) {
+  if (_state != CATALOG_IDLE)
+    return _state != CATALOG_ERROR;
+  if (_skipWs() != '[')
+    return _fail();
+  _state = CATALOG_FIRST;
+  return true;
+}
+
+/**
+ *  Parse the next entry of the catalog array. The known keys are
+ *  stored into the fields of the entry, and the others are ignored.
+ *  @param  entry An entry to store the parsed keys.
+ *  @return true  The entry has been parsed.
+ *  @return false Reached the end of the array or the catalog is
+ *  broken, which can be tested with hasError.
+ */
+bool AutoConnectCatalog::next(AutoConnectCatalogST& entry) {
+  if (_state != CATALOG_FIRST && _state != CATALOG_LIST)
+    return false;
+
+  int c = _skipWs();
+  if (c == ']') {
+    _state = CATALOG_END;
+    return false;
+  }
+  if (_state == CATALOG_LIST) {
+    if (c != ',')
+      return _fail();
+    c = _skipWs();
+  }
+  _state = CATALOG_LIST;
+  if (c != '{')
+    return _fail();
+
+  memset(&entry, 0x00, sizeof(AutoConnectCatalogST));
+  c = _skipWs();
+  if (c == '}')
+    return true;
+  for (;;) {
+    char  key[sizeof("compression")];
+    bool  truncated;
+    if (c != '"' || !_string(key, sizeof(key), &truncated))
+      return _fail();
+    // The long key that is not known is ignored.
+    if (truncated)
+      *key = '\0';
+    if (_skipWs() != ':')
+      return _fail();
+
+    char*   field = nullptr;
+    size_t  fieldSize = 0;
+    if (!strcmp_P(key, PSTR("name")))
+      field = entry.name, fieldSize = sizeof(entry.name);
+    else if (!strcmp_P(key, PSTR("type")))
+      field = entry.type, fieldSize = sizeof(entry.type);
+    else if (!strcmp_P(key, PSTR("date")))
+      field = entry.date, fieldSize = sizeof(entry.date);
+    else if (!strcmp_P(key, PSTR("time")))
+      field = entry.time, fieldSize = sizeof(entry.time);
+    else if (!strcmp_P(key, PSTR("compression")))
+      field = entry.compression, fieldSize = sizeof(entry.compression);
+
+    c = _skipWs();
+    if (field && c == '"') {
+      if (!_string(field, fieldSize, &truncated))
+        return _fail();
+      if (field == entry.name)
+        entry.truncated = truncated;
+    }
+    else if (!strcmp_P(key, PSTR("size")) && (c == '-' || isdigit(c))) {
+      if (!_number(c, &entry.size))
+        return _fail();
+    }
+    else if (!_skip(c))
+      return _fail();
+
+    c = _skipWs();
+    if (c == '}')
+      return true;
+    if (c != ',')
+      return _fail();
+    c = _skipWs();
+  }
+}
+
+/**
+ *  Turn to the error state.
+ *  @return Always false.
+ */
+bool AutoConnectCatalog::_fail(void) {
+  AC_DBG("Catalog malformed\n");
+  _state = CATALOG_ERROR;
+  return false;
+}
+
+/**
+ *  Parse an integer part of the number. The fraction and the exponent
+ *  are consumed and discarded.
+ *  @param  c     The first character of the number.
+ *  @param  value Parsed value.
+ *  @return true  The number has been parsed.
+ */
+bool AutoConnectCatalog::_number(int c, long* value) {
+  bool  negative = c == '-';
+  bool  integral = true;
+  long  v = 0;
+
+  if (negative)
+    c = _read();
+  if (!isdigit(c))
+    return false;
+  while (c >= 0) {
+    if (isdigit(c)) {
+      if (integral)
+        v = v * 10 + (c - '0');
+    }
+    else if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')
+      integral = false;
+    else {
+      _back = c;
+      break;
+    }
+    c = _read();
+  }
+  *value = negative ? -v : v;
+  return c >= 0;
+}
+
+/**
+ *  Read a byte from the stream waiting for the arrival.
+ *  @return A byte read, -1 for the timeout.
+ */
+int AutoConnectCatalog::_read(void) {
+  if (_back >= 0) {
+    int c = _back;
+    _back = -1;
+    return c;
+  }
+  unsigned long tm = millis();
+  do {
+    int c = _stream.read();
+    if (c >= 0)
+      return c;
+    yield();
+  } while (millis() - tm < _timeout);
+  AC_DBG("Catalog stream timeout\n");
+  return -1;
+}
+
+/**
+ *  Skip the value of the unknown key including the nested objects and
+ *  arrays.
+ *  @param  c     The first character of the value.
+ *  @return true  The value has been skipped.
+ */
+bool AutoConnectCatalog::_skip(int c) {
+  if (c == '"')
+    return _string(nullptr, 0);
+  if (c == '{' || c == '[') {
+    uint8_t depth = 1;
+    while (depth) {
+      c = _read();
+      if (c < 0)
+        return false;
+      if (c == '"') {
+        if (!_string(nullptr, 0))
+          return false;
+      }
+      else if (c == '{' || c == '[')
+        depth++;
+      else if (c == '}' || c == ']')
+        depth--;
+    }
+    return true;
+  }
+  // A number or a literal such as true, false and null.
+  while (c >= 0 && c != ',' && c != '}' && c != ']' && !isspace(c))
+    c = _read();
+  _back = c;
+  return c >= 0;
+}
+
+/**
+ *  Read the stream skipping the white spaces.
+ *  @return A byte other than the white space, -1 for the timeout.
+ */
+int AutoConnectCatalog::_skipWs(void) {
+  int c;
+  do {
+    c = _read();
+  } while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+  return c;
+}
+
+/**
+ *  Read a string whose opening quotation has been consumed. The escape
+ *  sequences are decoded and the \u sequence is encoded into UTF-8.
+ *  The string exceeding the buffer is truncated.
+ *  @param  buf       A buffer to store the string, nullptr to discard.
+ *  @param  size      Size of the buffer.
+ *  @param  truncated Indicates the string has been truncated.
+ *  @return true  The string has been read.
+ */
+bool AutoConnectCatalog::_string(char* buf, const size_t size, bool* truncated) {
+  size_t  n = 0;
+  bool    over = false;
+
+  auto put = [&](char ch) {
+    if (buf && n < size - sizeof('\0'))
+      buf[n++] = ch;
+    else
+      over = true;
+  };
+
+  for (;;) {
+    int c = _read();
+    if (c < 0)
+      return false;
+    if (c == '"')
+      break;
+    if (c == '\\') {
+      c = _read();
+      switch (c) {
+      case 'b':
+        put('\b');
+        break;
+      case 'f':
+        put('\f');
+        break;
+      case 'n':
+        put('\n');
+        break;
+      case 'r':
+        put('\r');
+        break;
+      case 't':
+        put('\t');
+        break;
+      case 'u': {
+        uint16_t  cp = 0;
+        for (uint8_t i = 0; i < 4; i++) {
+          c = _read();
+          if (!isxdigit(c))
+            return false;
+          cp = (cp << 4) | (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+        }
+        if (cp < 0x80)
+          put(static_cast<char>(cp));
+        else if (cp < 0x800) {
+          put(static_cast<char>(0xc0 | (cp >> 6)));
+          put(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        else {
+          put(static_cast<char>(0xe0 | (cp >> 12)));
+          put(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+          put(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        break;
+      }
+      default:
+        if (c < 0)
+          return false;
+        // Including the quotation, the reverse solidus and the solidus.
+        put(static_cast<char>(c));
+        break;
+      }
+    }
+    else
+      put(static_cast<char>(c));
+  }
+  if (buf)
+    buf[n] = '\0';
+  if (truncated)
+    *truncated = buf && over;
+  return true;
+}
@@ -0,0 +1,66 @@
+/**
+ *  Declaration of AutoConnectCatalog class.
+ *  @file   AutoConnectCatalog.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-08
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTCATALOG_H_
+#define _AUTOCONNECTCATALOG_H_
+
+#include <Arduino.h>
+#include "AutoConnectDefs.h"
+
+/**
+ *  A pull parser for the catalog list responded from the update server.
+ *  It reads the JSON array of the flat objects from the stream byte by
+ *  byte and extracts each entry into the fixed fields, so that the
+ *  catalog is parsed without the JSON document buffer no matter how
+ *  many entries it contains. The unknown keys and the nested values
+ *  are skipped.
+ */
+class AutoConnectCatalog {
+ public:
+  /** An entry of the catalog list */
+  typedef struct {
+    char  name[AUTOCONNECT_UPDATE_CATALOG_NAMELEN]; /**< File name */
+    char  type[sizeof("directory")];                /**< bin, directory or file */
+    char  date[16];                                 /**< File date */
+    char  time[16];                                 /**< File time */
+    char  compression[8];                           /**< Compression of the bin, empty for the raw */
+    long  size;                                     /**< File size */
+    bool  truncated;                                /**< The name exceeded the field */
+  } AutoConnectCatalogST;
+
+  explicit AutoConnectCatalog(Stream& stream, const unsigned long timeout = AUTOCONNECT_UPDATE_TIMEOUT)
+    : _stream(stream), _timeout(timeout), _state(CATALOG_IDLE), _back(-1) {}
+  ~AutoConnectCatalog() {}
+  bool  begin(void);                        /**< Enter the catalog array */
+  bool  hasError(void) const { return _state == CATALOG_ERROR; }  /**< The catalog is broken */
+  bool  next(AutoConnectCatalogST& entry);  /**< Parse the next entry */
+
+ protected:
+  typedef enum {
+    CATALOG_IDLE,           /**< Not entered the array yet */
+    CATALOG_FIRST,          /**< Expecting the first entry */
+    CATALOG_LIST,           /**< Expecting the next entry */
+    CATALOG_END,            /**< Reached the end of the array */
+    CATALOG_ERROR           /**< Malformed or timed out */
+  } AC_CATALOGSTATE_t;
+
+  bool  _fail(void);
+  bool  _number(int c, long* value);
+  int   _read(void);
+  bool  _skip(int c);
+  int   _skipWs(void);
+  bool  _string(char* buf, const size_t size, bool* truncated = nullptr);
+
+  Stream& _stream;            /**< The catalog stream */
+  unsigned long _timeout;     /**< Timeout for a byte to arrive [ms] */
+  AC_CATALOGSTATE_t _state;   /**< Parsing state */
+  int   _back;                /**< A pushed back byte, -1 for none */
+};
+
+#endif // !_AUTOCONNECTCATALOG_H_
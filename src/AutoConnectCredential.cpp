@@ -7,6 +7,7 @@
  *	@copyright	MIT license.
  */
 
+#include <algorithm>
 #include "AutoConnectCredential.h"
 
 #if AC_CREDENTIAL_PREFERENCES == 0
@@ -26,7 +27,7 @@
  *  ssid: SSID string with null termination.
  *  password : Password string with null termination.
  *  bssid : BSSID 6 bytes.
- *  d  : DHCP is in available. 0:DCHP 1:Static IP
+ *  d  : DHCP is in available. 0:DCHP 1:Static IP, the upper nibble holds the last known channel.
  *  ip - dns2 : Optional fields for static IPs configuration, these fields are available when d=1.
  *  ip : Static IP (uint32_t)
  *  gw : Gateway address (uint32_t)
@@ -71,6 +72,38 @@ void AutoConnectCredential::_allocateEntry(void) {
     _containSize = 0;
   }
   _eeprom->end();
+
+  // Index the entries by a single pass through the container.
+  _index.clear();
+  if (_entries) {
+    _eeprom->begin(AC_HEADERSIZE + _containSize);
+    _buildIndex();
+    _eeprom->end();
+  }
+}
+
+/**
+ *  Open the session that keeps the EEPROM buffer during the successive
+ *  loads, it saves the buffer allocation and the flash readout for
+ *  each load. Saving or deleting inside the session is available.
+ *  @retval true    The session is opened.
+ */
+bool AutoConnectCredential::begin(void) {
+  if (!_session) {
+    _eeprom->begin(AC_HEADERSIZE + _containSize);
+    _session = true;
+  }
+  return true;
+}
+
+/**
+ *  Close the session and release the EEPROM buffer.
+ */
+void AutoConnectCredential::end(void) {
+  if (_session) {
+    _eeprom->end();
+    _session = false;
+  }
 }
 
 /**
@@ -91,6 +124,9 @@ bool AutoConnectCredential::del(const char* ssid) {
   station_config_t  entry;
   bool  rc = false;
 
+  // The EEPROM buffer of the session is too small to update the container.
+  const bool  session = _session;
+  end();
   if (load(ssid, &entry) >= 0) {
     // Saved credential detected, _ep has the entry location.
     _eeprom->begin(AC_HEADERSIZE + _containSize);
@@ -111,7 +147,7 @@ bool AutoConnectCredential::del(const char* ssid) {
       _eeprom->write(_dp++, 0xff);
 
     // Erase ip configuration extention
-    if (_eeprom->read(_dp) == STA_STATIC) {
+    if (AC_CREDT_DHCP(_eeprom->read(_dp)) == STA_STATIC) {
       for (uint8_t i = 0; i < sizeof(station_config_t::_config); i++)
         _eeprom->write(_dp++, 0xff);
     }
@@ -123,8 +159,11 @@ bool AutoConnectCredential::del(const char* ssid) {
     // commit it.
     rc = _eeprom->commit();
     delay(10);
+    _buildIndex();
     _eeprom->end();
   }
+  if (session)
+    begin();
   return rc;
 }
 
@@ -138,21 +177,20 @@ bool AutoConnectCredential::del(const char* ssid) {
  *  the specified SSID was not found.
  */
 int8_t AutoConnectCredential::load(const char* ssid, station_config_t* config) {
-  int8_t  entry = -1;
+  const uint32_t  hash = _hashSSID(ssid);
 
-  _dp = AC_HEADERSIZE;
-  if (_entries) {
-    _eeprom->begin(AC_HEADERSIZE + _containSize);
-    for (uint8_t i = 0; i < _entries; i++) {
+  // Only the entries whose hash matches are read from the EEPROM.
+  for (uint8_t i = 0; i < _index.size(); i++) {
+    if (_index[i].hash == hash) {
+      _open();
+      _dp = _index[i].offset;
       _retrieveEntry(config);
-      if (!strcmp(ssid, reinterpret_cast<const char*>(config->ssid))) {
-        entry = i;
-        break;
-      }
+      _close();
+      if (!strcmp(ssid, reinterpret_cast<const char*>(config->ssid)))
+        return static_cast<int8_t>(i);
     }
-    _eeprom->end();
   }
-  return entry;
+  return -1;
 }
 
 /**
@@ -165,12 +203,11 @@ int8_t AutoConnectCredential::load(const char* ssid, station_config_t* config) {
  *          false   The number is not available.
  */
 bool AutoConnectCredential::load(int8_t entry, station_config_t* config) {
-  _dp = AC_HEADERSIZE;
-  if (_entries && entry < _entries) {
-    _eeprom->begin(AC_HEADERSIZE + _containSize);
-    while (entry-- >= 0)
-      _retrieveEntry(config);
-    _eeprom->end();
+  if (entry >= 0 && entry < static_cast<int8_t>(_index.size())) {
+    _open();
+    _dp = _index[entry].offset;
+    _retrieveEntry(config);
+    _close();
     return true;
   }
   else {
@@ -194,9 +231,20 @@ bool AutoConnectCredential::save(const station_config_t* config) {
   bool    rep = false;
   bool    rc;
 
+  // The EEPROM buffer of the session is too small to update the container.
+  const bool  session = _session;
+  end();
+
   // Detect same entry for replacement.
   entry = load(reinterpret_cast<const char*>(config->ssid), &stage);
 
+  // Saving the same content is omitted to avoid the wear of the flash.
+  if (entry >= 0 && _isSame(&stage, config)) {
+    if (session)
+      begin();
+    return true;
+  }
+
   // Saving start.
   _eeprom->begin(AC_HEADERSIZE + _containSize + sizeof(station_config_t));
 
@@ -212,7 +260,7 @@ bool AutoConnectCredential::save(const station_config_t* config) {
     for (uint8_t i = 0; i < sizeof(station_config_t::bssid); i++) {
       _eeprom->write(_dp++, 0xff);  // Clear BSSID
     }
-    uint8_t ss = _eeprom->read(_dp); // Read dhcp assignment flag
+    uint8_t ss = AC_CREDT_DHCP(_eeprom->read(_dp)); // Read dhcp assignment flag
     _eeprom->write(_dp++, 0xff);    // Clear dhcp
     if (ss == (uint8_t)STA_STATIC) {
       for (uint8_t i = 0 ; i < sizeof(station_config_t::_config); i++)
@@ -228,9 +276,6 @@ bool AutoConnectCredential::save(const station_config_t* config) {
     _eeprom->write(i + _offset, _entries);
   }
 
-  rc = _eeprom->commit();
-  delay(10);
-
   // Seek insertion point, evaluate capacity to insert the new entry.
   uint16_t eSize = strlen(reinterpret_cast<const char*>(config->ssid)) + strlen(reinterpret_cast<const char*>(config->password)) + sizeof(station_config_t::bssid) + sizeof(station_config_t::dhcp);
   if (config->dhcp == (uint8_t)STA_STATIC)
@@ -266,7 +311,7 @@ bool AutoConnectCredential::save(const station_config_t* config) {
   } while (c != '\0');
   for (uint8_t i = 0; i < sizeof(station_config_t::bssid); i++)
     _eeprom->write(_dp++, config->bssid[i]);  // write BSSID
-  _eeprom->write(_dp++, config->dhcp); // write dhcp flag
+  _eeprom->write(_dp++, AC_CREDT_PACKDHCP(config->dhcp, config->channel)); // write dhcp flag and channel
   if (config->dhcp == (uint8_t)STA_STATIC) {
     for (uint8_t e = 0; e < sizeof(station_config_t::_config::addr) / sizeof(uint32_t); e++) {
       uint32_t  ip = config->config.addr[e];
@@ -286,10 +331,15 @@ bool AutoConnectCredential::save(const station_config_t* config) {
     _eeprom->write(_offset + sizeof(AC_IDENTIFIER) - 1 + sizeof(uint8_t) + 1, (uint8_t)(_containSize >> 8));
   }
 
-  rc &= _eeprom->commit();
+  // The release of the previous entry and the new entry are written
+  // back together with a single commit.
+  rc = _eeprom->commit();
   delay(10);
+  _buildIndex();
   _eeprom->end();
 
+  if (session)
+    begin();
   return rc;
 }
 
@@ -323,7 +373,9 @@ void AutoConnectCredential::_retrieveEntry(station_config_t* config) {
   for (uint8_t i = 0; i < sizeof(station_config_t::bssid); i++)
     config->bssid[i] = _eeprom->read(_dp++);
   // Extended readout for static IP
-  config->dhcp = _eeprom->read(_dp++);
+  ec = _eeprom->read(_dp++);
+  config->dhcp = AC_CREDT_DHCP(ec);
+  config->channel = AC_CREDT_CHANNEL(ec);
   if (config->dhcp == (uint8_t)STA_STATIC) {
     for (uint8_t e = 0; e < sizeof(station_config_t::_config::addr) / sizeof(uint32_t); e++) {
       uint32_t* ip = &config->config.addr[e];
@@ -336,6 +388,67 @@ void AutoConnectCredential::_retrieveEntry(station_config_t* config) {
   }
 }
 
+/**
+ *  Open EEPROM to read the entry. Inside the session, the buffer
+ *  already opened is used.
+ */
+void AutoConnectCredential::_open(void) {
+  if (!_session)
+    _eeprom->begin(AC_HEADERSIZE + _containSize);
+}
+
+void AutoConnectCredential::_close(void) {
+  if (!_session)
+    _eeprom->end();
+}
+
+/**
+ *  Build the index of the entries which holds the hash of SSID and the
+ *  location in EEPROM for each entry. The EEPROM must be opened.
+ */
+void AutoConnectCredential::_buildIndex(void) {
+  station_config_t  entry;
+
+  _index.clear();
+  _index.reserve(_entries);
+  _dp = AC_HEADERSIZE;
+  for (uint8_t i = 0; i < _entries; i++) {
+    _retrieveEntry(&entry);
+    _index.push_back({ _hashSSID(reinterpret_cast<const char*>(entry.ssid)), static_cast<uint16_t>(_ep) });
+  }
+}
+
+/**
+ *  FNV-1a hash of SSID.
+ *  @param  ssid  SSID string.
+ *  @return Hash value.
+ */
+uint32_t AutoConnectCredential::_hashSSID(const char* ssid) {
+  uint32_t  hash = 2166136261UL;
+  for (uint8_t n = 0; n < sizeof(station_config_t::ssid) && *ssid; n++) {
+    hash ^= static_cast<uint8_t>(*ssid++);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+/**
+ *  Compare the content of the entries to be stored.
+ *  @param  a   A station_config structure.
+ *  @param  b   A station_config structure.
+ *  @retval true  The entries have the same content.
+ */
+bool AutoConnectCredential::_isSame(const station_config_t* a, const station_config_t* b) {
+  if (strncmp(reinterpret_cast<const char*>(a->ssid), reinterpret_cast<const char*>(b->ssid), sizeof(station_config_t::ssid)) ||
+      strncmp(reinterpret_cast<const char*>(a->password), reinterpret_cast<const char*>(b->password), sizeof(station_config_t::password)) ||
+      memcmp(a->bssid, b->bssid, sizeof(station_config_t::bssid)) ||
+      a->dhcp != b->dhcp || a->channel != b->channel)
+    return false;
+  if (a->dhcp == (uint8_t)STA_STATIC)
+    return !memcmp(a->config.addr, b->config.addr, sizeof(station_config_t::_config::addr));
+  return true;
+}
+
 #else
 
 /**
@@ -353,7 +466,7 @@ void AutoConnectCredential::_retrieveEntry(station_config_t* config) {
  *  ssid: SSID string with null termination.
  *  password : Password string with null termination.
  *  bssid : BSSID 6 bytes.
- *  d  : DHCP is in available. 0:DCHP 1:Static IP
+ *  d  : DHCP is in available. 0:DCHP 1:Static IP, the upper nibble holds the last known channel.
  *  ip - dns2 : Optional fields for static IPs configuration, these fields are available when d=1.
  *  ip : Static IP (uint32_t)
  *  gw : Gateway address (uint32_t)
@@ -362,6 +475,8 @@ void AutoConnectCredential::_retrieveEntry(station_config_t* config) {
  *  dns2 : Secondary DNS (uint32_t)
  *  t  : The end of the container is a continuous '\0'.
  *  SSID and PASSWORD are terminated by '\ 0'.
+ *  The credentials are imported only once and are shared with all
+ *  instances as the fixed-size entries sorted by SSID.
  */
 AutoConnectCredential::AutoConnectCredential() {
   _allocateEntry();
@@ -374,31 +489,62 @@ AutoConnectCredential::AutoConnectCredential(uint16_t offset) {
   _allocateEntry();
 }
 
+// The credentials shared with all instances.
+AutoConnectCredential::AC_CREDT_t AutoConnectCredential::_credit;
+bool  AutoConnectCredential::_imported = false;
+bool  AutoConnectCredential::_dirty = false;
+
 void AutoConnectCredential::_allocateEntry(void) {
   _pref.reset(new Preferences);
-  _entries = _import();
+  if (!_imported)
+    _import();
+  _entries = _credit.size();
 }
 
+/**
+ *  The destructor writes back the deferred updates of the session.
+ */
 AutoConnectCredential::~AutoConnectCredential() {
-  _credit.clear();
+  end();
   _pref.reset();
 }
 
+/**
+ *  Open the session that defers writing back to the nvs. Saving and
+ *  deleting inside the session are written back at once by end.
+ *  @retval true    The session is opened.
+ */
+bool AutoConnectCredential::begin(void) {
+  _session = true;
+  return true;
+}
+
+/**
+ *  Close the session and write back the updates inside the session.
+ */
+void AutoConnectCredential::end(void) {
+  if (_session) {
+    _session = false;
+    if (_dirty)
+      _commit();
+  }
+}
+
 /**
  *  Delete the credential entry for the specified SSID in the EEPROM.
  *  @param  ssid    A SSID character string to be deleted.
  *  @retval true    The entry successfully delete.
  *          false   Could not deleted.
  */
-inline bool AutoConnectCredential::del(const char* ssid) {
-  return _del(ssid, true);
+bool AutoConnectCredential::del(const char* ssid) {
+  return _del(ssid, !_session);
 }
 
 /**
  *  Refresh the number of stored credential entries.
  *  @retval A number of entries.
  */
-inline uint8_t AutoConnectCredential::entries(void) {
+uint8_t AutoConnectCredential::entries(void) {
   _entries = _credit.size();
   return _entries;
 }
@@ -413,16 +559,10 @@ inline uint8_t AutoConnectCredential::entries(void) {
  *  the specified SSID was not found.
  */
 int8_t AutoConnectCredential::load(const char* ssid, station_config_t* config) {
-  // Determine the number in entries
-  int8_t  en = 0;
-  _entries = _import(); // Reload the saved credentials
-  for (decltype(_credit)::iterator it = _credit.begin(), e = _credit.end(); it != e; ++it) {
-    String  key = it->first;
-    if (!strcmp(ssid, key.c_str())) {
-      _obtain(it, config);
-      return en;
-    }
-    en++;
+  AC_CREDT_t::iterator  it = _find(ssid);
+  if (it != _credit.end()) {
+    _obtain(it, config);
+    return static_cast<int8_t>(it - _credit.begin());
   }
   return -1;
 }
@@ -437,90 +577,88 @@ int8_t AutoConnectCredential::load(const char* ssid, station_config_t* config) {
  *          false   The number is not available.
  */
 bool AutoConnectCredential::load(int8_t entry, station_config_t* config) {
-  _entries = _import();
-  for (decltype(_credit)::iterator it = _credit.begin(), e = _credit.end(); it != e; ++it) {
-    if (!entry--) {
-      _obtain(it, config);
-      return true;
-    }
+  if (entry >= 0 && entry < static_cast<int8_t>(_credit.size())) {
+    _obtain(_credit.begin() + entry, config);
+    return true;
   }
   return false;
 }
 
 /**
  *  Save SSID and password to Preferences.
- *  When the same SSID already exists, it will be replaced. If the current
- *  entry size insufficient for the new entry, the entry will be appended
- *  and increase whole size. Its previous areas are freed with FF and reused.
+ *  When the same SSID already exists, it will be replaced. Saving the
+ *  same content does not write back, and saving inside the session is
+ *  written back with the end of the session.
  *  @param  config  A pointer to the station_config structure storing SSID and password.
  *  @retval true    Successfully saved.
  *  @retval false   Preferences commit failed.
  */
 bool AutoConnectCredential::save(const station_config_t* config) {
   if (_add(config)) {
+    if (_session || !_dirty)
+      return true;
     return _commit() > 0 ? true : false;
   }
   return false;
 }
 
 /**
- *  Add an entry to internal dictionary that is std::map structure.
- *  It adds an entry by the insert after will delete the same entry
- *  caused std:: map does not accept duplicate keys.
+ *  Add an entry to the internal dictionary keeping the order of SSID.
+ *  The entry which has the same SSID will be replaced. The unused area
+ *  of the entry is cleared so that the entries can be compared as is.
  *  @param  config  A pointer to the station_config structure storing SSID and password.
  *  @retval true    Successfully saved.
  *  @retval false   Preferences commit failed.
  */
 bool AutoConnectCredential::_add(const station_config_t* config) {
-  const String  ssid = String(reinterpret_cast<const char*>(config->ssid));
-  if (ssid.length() > 0) {
-
-    // Remove a same entry to insert a new one.
-    _del(ssid.c_str(), false);
-
-    // Insert
-    AC_CREDTBODY_t  credtBody;
-    credtBody.password = String(reinterpret_cast<const char*>(config->password));
-    memcpy(credtBody.bssid, config->bssid, sizeof(AC_CREDTBODY_t::bssid));
-    credtBody.dhcp = config->dhcp;
-    for (uint8_t e = 0; e < sizeof(AC_CREDTBODY_t::ip) / sizeof(uint32_t); e++)
-      credtBody.ip[e] = credtBody.dhcp == (uint8_t)STA_STATIC ? config->config.addr[e] : 0U;
-    std::pair<AC_CREDT_t::iterator, bool> rc = _credit.insert(std::make_pair(ssid, credtBody));
-    _entries = _credit.size();
-    #ifdef AC_DBG
-    if (!rc.second) {
-      AC_DBG("Failed to save a credential %s\n", config->ssid);
-    }
-    #endif
-    return rc.second;
+  station_config_t  entry;
+
+  memset(&entry, 0x00, sizeof(station_config_t));
+  strncpy(reinterpret_cast<char*>(entry.ssid), reinterpret_cast<const char*>(config->ssid), sizeof(station_config_t::ssid));
+  if (!entry.ssid[0])
+    return false;
+  strncpy(reinterpret_cast<char*>(entry.password), reinterpret_cast<const char*>(config->password), sizeof(station_config_t::password));
+  memcpy(entry.bssid, config->bssid, sizeof(station_config_t::bssid));
+  entry.dhcp = config->dhcp;
+  entry.channel = config->channel;
+  if (entry.dhcp == (uint8_t)STA_STATIC)
+    memcpy(entry.config.addr, config->config.addr, sizeof(station_config_t::_config::addr));
+
+  AC_CREDT_t::iterator  it = std::lower_bound(_credit.begin(), _credit.end(), entry, [](const station_config_t& a, const station_config_t& b) {
+    return strncmp(reinterpret_cast<const char*>(a.ssid), reinterpret_cast<const char*>(b.ssid), sizeof(station_config_t::ssid)) < 0;
+  });
+  if (it != _credit.end() && !strncmp(reinterpret_cast<const char*>(it->ssid), reinterpret_cast<const char*>(entry.ssid), sizeof(station_config_t::ssid))) {
+    // The same content is not necessary to write back.
+    if (!memcmp(&*it, &entry, sizeof(station_config_t)))
+      return true;
+    *it = entry;
   }
-  return false;
+  else
+    _credit.insert(it, entry);
+  _entries = _credit.size();
+  _dirty = true;
+  return true;
 }
 
 /**
  *  Serialize the AutoConnectCredential instance and write it back to NVS.
  */
 size_t AutoConnectCredential::_commit(void) {
-  AC_CREDTBODY_t credtBody;
-  String  ssid;
-
   // Calculate the serialization size for each entry and add the size of 'e' with the size of 'ss' to it.
   size_t  sz = 0;
-  for (const auto& credt : _credit) {
-    ssid = credt.first;
-    credtBody = credt.second;
-    sz += ssid.length() + sizeof('\0') + credtBody.password.length() + sizeof('\0') + sizeof(AC_CREDTBODY_t::bssid) + sizeof(AC_CREDTBODY_t::dhcp);
-    if (credtBody.dhcp == (uint32_t)STA_STATIC) {
-      for (uint8_t e = 0; e < sizeof(AC_CREDTBODY_t::ip) / sizeof(uint32_t); e++)
-        sz += sizeof(uint32_t);
-    }
+  for (const station_config_t& credt : _credit) {
+    sz += strnlen(reinterpret_cast<const char*>(credt.ssid), sizeof(station_config_t::ssid)) + sizeof('\0') + strnlen(reinterpret_cast<const char*>(credt.password), sizeof(station_config_t::password)) + sizeof('\0') + sizeof(station_config_t::bssid) + sizeof(station_config_t::dhcp);
+    if (credt.dhcp == (uint8_t)STA_STATIC)
+      sz += sizeof(station_config_t::_config::addr);
   }
   // When the entry is not empty, the size of container terminator as '\0' must be added.
+  _entries = _credit.size();
   _containSize = sz + (_entries ? sizeof('\0') : 0);
   // Calculate the nvs pool size for saving to NVS. Add size of 'e' and 'ss' field.
   size_t  psz = _containSize + sizeof(uint8_t) + sizeof(uint16_t);
 
   // Dump container to serialization pool and write it back to NVS.
+  sz = 0;
   uint8_t* credtPool = (uint8_t*)malloc(psz);
   if (credtPool) {
     uint16_t dp = 0;
@@ -528,37 +666,38 @@ size_t AutoConnectCredential::_commit(void) {
     credtPool[dp++] = (uint8_t)(psz & 0x00ff); // 'ss' low byte
     credtPool[dp++] = (uint8_t)(psz >> 8);     // 'ss' high byte
     // Starts dump of credential entries
-    for (const auto& credt : _credit) {
-      ssid = credt.first;       // Retrieve SSID
-      credtBody = credt.second; // Retrieve an entry
+    for (const station_config_t& credt : _credit) {
       // SSID
-      size_t  itemLen = ssid.length() + sizeof('\0');
-      ssid.toCharArray(reinterpret_cast<char*>(&credtPool[dp]), itemLen);
+      size_t  itemLen = strnlen(reinterpret_cast<const char*>(credt.ssid), sizeof(station_config_t::ssid));
+      memcpy(&credtPool[dp], credt.ssid, itemLen);
+      dp += itemLen;
+      credtPool[dp++] = '\0';
       // Password
+      itemLen = strnlen(reinterpret_cast<const char*>(credt.password), sizeof(station_config_t::password));
+      memcpy(&credtPool[dp], credt.password, itemLen);
       dp += itemLen;
-      itemLen = credtBody.password.length() + sizeof('\0');
-      credtBody.password.toCharArray(reinterpret_cast<char*>(&credtPool[dp]), itemLen);
+      credtPool[dp++] = '\0';
       // BSSID
-      dp += itemLen;
-      memcpy(&credtPool[dp], credtBody.bssid, sizeof(station_config_t::bssid));
+      memcpy(&credtPool[dp], credt.bssid, sizeof(station_config_t::bssid));
       dp += sizeof(station_config_t::bssid);
       // DHCP/Static IP indicator
-      credtPool[dp++] = (uint8_t)credtBody.dhcp;
+      credtPool[dp++] = AC_CREDT_PACKDHCP(credt.dhcp, credt.channel);
       // Static IP configuration
-      if (credtBody.dhcp == STA_STATIC) {
-        for (uint8_t e = 0; e < sizeof(AC_CREDTBODY_t::ip) / sizeof(uint32_t); e++) {
-          // uint32_t  ip = credtBody.ip[e];
-          for (uint8_t b = 1; b <= sizeof(credtBody.ip[e]); b++)
-            credtPool[dp++] = ((uint8_t*)&credtBody.ip[e])[sizeof(credtBody.ip[e]) - b];
+      if (credt.dhcp == (uint8_t)STA_STATIC) {
+        for (uint8_t e = 0; e < sizeof(station_config_t::_config::addr) / sizeof(uint32_t); e++) {
+          for (uint8_t b = 1; b <= sizeof(uint32_t); b++)
+            credtPool[dp++] = ((const uint8_t*)&credt.config.addr[e])[sizeof(uint32_t) - b];
         }
       }
     }
-    if (_credit.size() > 0)
+    if (_entries > 0)
       credtPool[dp] = '\0'; // Terminates a container
     // Write back to the nvs
     if (_pref->begin(AC_CREDENTIAL_NVSNAME, false)) {
       sz = _pref->putBytes(AC_CREDENTIAL_NVSKEY, credtPool, psz);
       _pref->end();
+      if (sz)
+        _dirty = false;
     }
     #ifdef AC_DBG
     else {
@@ -583,10 +722,11 @@ size_t AutoConnectCredential::_commit(void) {
  *          false   Could not deleted.
  */
 bool AutoConnectCredential::_del(const char* ssid, const bool commit) {
-  decltype(_credit)::iterator it = _credit.find(String(ssid));
+  AC_CREDT_t::iterator  it = _find(ssid);
   if (it != _credit.end()) {
     _credit.erase(it);
     _entries = _credit.size();
+    _dirty = true;
     if (commit)
       _commit();
     return true;
@@ -594,6 +734,20 @@ bool AutoConnectCredential::_del(const char* ssid, const bool commit) {
   return false;
 }
 
+/**
+ *  Find the entry for the specified SSID by the binary search.
+ *  @param  ssid    A SSID character string to be found.
+ *  @return An iterator of the entry, end of the entries if not found.
+ */
+AutoConnectCredential::AC_CREDT_t::iterator AutoConnectCredential::_find(const char* ssid) {
+  AC_CREDT_t::iterator  it = std::lower_bound(_credit.begin(), _credit.end(), ssid, [](const station_config_t& a, const char* b) {
+    return strncmp(reinterpret_cast<const char*>(a.ssid), b, sizeof(station_config_t::ssid)) < 0;
+  });
+  if (it != _credit.end() && !strncmp(reinterpret_cast<const char*>(it->ssid), ssid, sizeof(station_config_t::ssid)))
+    return it;
+  return _credit.end();
+}
+
 /**
  *  Import the credentials bulk data as Preferences from NVS.
  *  In ESP32, AutoConnect stores credentials in NVS from v1.0.0.
@@ -601,35 +755,37 @@ bool AutoConnectCredential::_del(const char* ssid, const bool commit) {
 uint8_t AutoConnectCredential::_import(void) {
   uint8_t cn = 0;
   if (_pref->begin(AC_CREDENTIAL_NVSNAME, true)) {
+    _credit.clear();
     size_t  psz = _getPrefBytesLength<Preferences>(_pref.get(), AC_CREDENTIAL_NVSKEY);
     if (psz) {
       uint8_t* credtPool = (uint8_t*)malloc(psz);
       if (credtPool) {
         _pref->getBytes(AC_CREDENTIAL_NVSKEY, static_cast<void*>(credtPool), psz);
-        _credit.clear();
         uint16_t  dp = 0;
         cn = credtPool[dp++];  // Retrieve 'e'
         _containSize = (uint16_t)credtPool[dp++];
         _containSize += (uint16_t)(credtPool[dp++] << 8); // Retrieve size of 'ss'
+        _credit.reserve(cn);
         // Starts import
         while (dp < psz - sizeof('\0')) {
-          AC_CREDTBODY_t  credtBody;
+          station_config_t  credt;
+          memset(&credt, 0x00, sizeof(station_config_t));
           // SSID
-          String  ssid = String(reinterpret_cast<const char*>(&credtPool[dp]));
+          strncpy(reinterpret_cast<char*>(credt.ssid), reinterpret_cast<const char*>(&credtPool[dp]), sizeof(station_config_t::ssid));
+          dp += strlen(reinterpret_cast<const char*>(&credtPool[dp])) + sizeof('\0');
           // Password
-          dp += ssid.length() + sizeof('\0');
-          credtBody.password = String(reinterpret_cast<const char*>(&credtPool[dp]));
+          strncpy(reinterpret_cast<char*>(credt.password), reinterpret_cast<const char*>(&credtPool[dp]), sizeof(station_config_t::password));
+          dp += strlen(reinterpret_cast<const char*>(&credtPool[dp])) + sizeof('\0');
           // BSSID
-          dp += credtBody.password.length() + sizeof('\0');
-          memcpy(credtBody.bssid, &credtPool[dp], sizeof(AC_CREDTBODY_t::bssid));
-          dp += sizeof(AC_CREDTBODY_t::bssid);
+          memcpy(credt.bssid, &credtPool[dp], sizeof(station_config_t::bssid));
+          dp += sizeof(station_config_t::bssid);
           // DHCP/Static IP indicator
-          credtBody.dhcp = credtPool[dp++];
+          credt.dhcp = AC_CREDT_DHCP(credtPool[dp]);
+          credt.channel = AC_CREDT_CHANNEL(credtPool[dp++]);
           // Static IP configuration
-          for (uint8_t e = 0; e < sizeof(AC_CREDTBODY_t::ip) / sizeof(uint32_t); e++) {
-            uint32_t* ip = &credtBody.ip[e];
-            *ip = 0U;
-            if (credtBody.dhcp == (uint8_t)STA_STATIC) {
+          if (credt.dhcp == (uint8_t)STA_STATIC) {
+            for (uint8_t e = 0; e < sizeof(station_config_t::_config::addr) / sizeof(uint32_t); e++) {
+              uint32_t* ip = &credt.config.addr[e];
               for (uint8_t b = 0; b < sizeof(uint32_t); b++) {
                 *ip <<= 8;
                 *ip += credtPool[dp++];
@@ -637,9 +793,14 @@ uint8_t AutoConnectCredential::_import(void) {
             }
           }
           // Make an entry
-          _credit.insert(std::make_pair(ssid, credtBody));
+          _credit.push_back(credt);
         }
         free(credtPool);
+        // The entries are kept in the order of SSID to find by the binary search.
+        std::sort(_credit.begin(), _credit.end(), [](const station_config_t& a, const station_config_t& b) {
+          return strncmp(reinterpret_cast<const char*>(a.ssid), reinterpret_cast<const char*>(b.ssid), sizeof(station_config_t::ssid)) < 0;
+        });
+        _imported = true;
       }
       #ifdef AC_DBG
       else {
@@ -647,6 +808,8 @@ uint8_t AutoConnectCredential::_import(void) {
       }
       #endif
     }
+    else
+      _imported = true;
     _pref->end();
   }
   #ifdef AC_DBG
@@ -659,20 +822,12 @@ uint8_t AutoConnectCredential::_import(void) {
 
 /**
  *  Obtains an entry pointed to by the specified iterator from the
- *  dictionary as the std::map that maintains the credentials into the
- *  station_config structure.
+ *  entries into the station_config structure.
  *  @param  it  An  iterator to an entry
  *  @param  config  the station_config structure storing SSID and password.
  */
 void AutoConnectCredential::_obtain(AC_CREDT_t::iterator const& it, station_config_t* config) {
-  String  ssid = it->first;
-  AC_CREDTBODY_t&  credtBody = it->second;
-  ssid.toCharArray(reinterpret_cast<char*>(config->ssid), sizeof(station_config_t::ssid));
-  credtBody.password.toCharArray(reinterpret_cast<char*>(config->password), sizeof(station_config_t::password));
-  memcpy(config->bssid, credtBody.bssid, sizeof(station_config_t::bssid));
-  config->dhcp = credtBody.dhcp;
-  for (uint8_t e = 0; e < sizeof(AC_CREDTBODY_t::ip) / sizeof(uint32_t); e++)
-    config->config.addr[e] = credtBody.dhcp == (uint8_t)STA_STATIC ? credtBody.ip[e] : 0U;
+  memcpy(config, &*it, sizeof(station_config_t));
 }
 
 #endif
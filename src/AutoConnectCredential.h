@@ -20,6 +20,7 @@
 
 #include <Arduino.h>
 #include <memory>
+#include <vector>
 #if defined(ARDUINO_ARCH_ESP8266)
 #define AC_CREDENTIAL_PREFERENCES 0
 extern "C" {
@@ -57,11 +58,21 @@ typedef enum {
   STA_STATIC
 } station_config_dhcp;
 
+/**
+ * The stored dhcp indicator byte also holds the last known channel of
+ * the access point in the upper nibble. The records saved before the
+ * channel was introduced have 0 in the upper nibble as unknown channel.
+ */
+#define AC_CREDT_PACKDHCP(d, c) ((uint8_t)((((c) & 0x0f) << 4) | ((d) & 0x0f)))
+#define AC_CREDT_DHCP(b)        ((uint8_t)((b) & 0x0f))
+#define AC_CREDT_CHANNEL(b)     ((uint8_t)(((b) >> 4) & 0x0f))
+
 typedef struct {
   uint8_t ssid[32];
   uint8_t password[64];
   uint8_t bssid[6];
   uint8_t dhcp;   /**< 0:DHCP, 1:Static IP */
+  uint8_t channel;  /**< Last known channel of the access point, 0:unknown */
   union _config {
     uint32_t  addr[5];
     struct _sta {
@@ -79,6 +90,8 @@ class AutoConnectCredentialBase {
   explicit AutoConnectCredentialBase() : _entries(0), _containSize(0) {}
   virtual ~AutoConnectCredentialBase() {}
   virtual uint8_t entries(void) { return _entries; }
+  virtual bool    begin(void) { return true; }  /**< Open the session for the successive loads */
+  virtual void    end(void) {}                  /**< Close the session */
   virtual bool    del(const char* ssid) = 0;
   virtual int8_t  load(const char* ssid, station_config_t* config) = 0;
   virtual bool    load(int8_t entry, station_config_t* config) = 0;
@@ -102,6 +115,8 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
   AutoConnectCredential();
   explicit AutoConnectCredential(uint16_t offset);
   ~AutoConnectCredential();
+  bool    begin(void) override;
+  void    end(void) override;
   bool    del(const char* ssid) override;
   int8_t  load(const char* ssid, station_config_t* config) override;
   bool    load(int8_t entry, station_config_t* config) override;
@@ -112,7 +127,19 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
 
  private:
   void    _retrieveEntry(station_config_t* config);   /**< Read an available entry. */
+  void    _buildIndex(void);                          /**< Index the entries */
+  void    _open(void);                                /**< Open EEPROM outside the session */
+  void    _close(void);                               /**< Close EEPROM outside the session */
+  static uint32_t _hashSSID(const char* ssid);        /**< Hash of SSID */
+  static bool _isSame(const station_config_t* a, const station_config_t* b);  /**< Compare the entries */
 
+  /** An index of the entry */
+  typedef struct {
+    uint32_t  hash;         /**< Hash of SSID */
+    uint16_t  offset;       /**< Location of the entry in EEPROM */
+  } AC_CREDTINDEX_t;
+  std::vector<AC_CREDTINDEX_t>  _index; /**< Index of the entries in the order of storage */
+  bool      _session = false; /**< EEPROM is kept opened by begin */
   int       _dp;            /**< The current address in EEPROM */
   int       _ep;            /**< The current entry address in EEPROM */
   uint16_t  _offset;        /**< The offset for the saved area of credentials in EEPROM. */
@@ -122,7 +149,6 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
 #else
 // #pragma message "AutoConnectCredential applies the Preferences"
 #include <type_traits>
-#include <map>
 #include <Preferences.h>
 #include <nvs.h>
 
@@ -140,6 +166,8 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
   AutoConnectCredential();
   explicit AutoConnectCredential(uint16_t offset);
   ~AutoConnectCredential();
+  bool    begin(void) override;
+  void    end(void) override;
   bool    del(const char* ssid) override;
   uint8_t entries(void) override;
   int8_t  load(const char* ssid, station_config_t* config) override;
@@ -150,18 +178,12 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
   void    _allocateEntry(void) override;  /**< Initialize storage for credentials. */
 
  private:
-  typedef struct {
-    String   password;
-    uint8_t  bssid[6];
-    uint8_t  dhcp;   /**< 1:DHCP, 2:Static IP */
-    uint32_t ip[5];
-  } AC_CREDTBODY_t;         /**< Credential entry */
-  typedef std::map<String, AC_CREDTBODY_t>  AC_CREDT_t;
-  // typedef station_config  station_config_t;
+  typedef std::vector<station_config_t>  AC_CREDT_t; /**< Fixed-size entries sorted by SSID */
 
   bool    _add(const station_config_t* config); /**< Add an entry */
   size_t  _commit(void);    /**< Write back to the nvs */
   bool    _del(const char* ssid, const bool commit);  /**< Deletes an entry */
+  AC_CREDT_t::iterator  _find(const char* ssid);      /**< Find an entry by SSID */
   uint8_t _import(void);    /**< Import from the nvs */
   void    _obtain(AC_CREDT_t::iterator const& it, station_config_t* config);  /**< Obtain an entry from iterator */
   template<typename T>
@@ -183,8 +205,11 @@ class AutoConnectCredential : public AutoConnectCredentialBase {
     return len;
   }
 
-  AC_CREDT_t  _credit;      /**< Dictionary to maintain the credentials */
+  bool    _session = false; /**< Commits are deferred until the end of the session */
   std::unique_ptr<Preferences>  _pref;  /**< Preferences class instance to access the nvs */
+  static AC_CREDT_t _credit;  /**< Credentials shared with all instances */
+  static bool _imported;    /**< The credentials have been imported from the nvs */
+  static bool _dirty;       /**< The credentials have not been written back yet */
 };
 
 #endif
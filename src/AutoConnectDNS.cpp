@@ -0,0 +1,173 @@
+/**
+ *  AutoConnectDNS class implementation.
+ *  Answers the DNS queries with the SoftAP address for the captive portal.
+ *  @file   AutoConnectDNS.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-12
+ *  @copyright  MIT license.
+ */
+
+#include <string.h>
+#include "AutoConnectDNS.h"
+
+namespace {
+  // DNS header flags
+  const uint8_t DNS_QR = 0x80;        // Response
+  const uint8_t DNS_OPCODE = 0x78;    // Opcode, 0 for the standard query
+  const uint8_t DNS_AA = 0x04;        // Authoritative answer
+  const uint8_t DNS_RD = 0x01;        // Recursion desired
+  // Resource record types and class
+  const uint16_t DNS_TYPE_A = 1;
+  const uint16_t DNS_TYPE_ANY = 255;
+  const uint16_t DNS_CLASS_IN = 1;
+}
+
+/**
+ *  Reply the queries queued in the socket. The queries are drained in
+ *  a turn up to AUTOCONNECT_DNS_DRAINCOUNT so that the burst of the
+ *  probes by the joined client will not be left behind over the
+ *  loops.
+ *  @return The number of queries replied.
+ */
+size_t AutoConnectDNS::processRequests(void) {
+  size_t  replied = 0;
+
+  if (!_active)
+    return replied;
+
+  for (unsigned int n = 0; n < AUTOCONNECT_DNS_DRAINCOUNT; n++) {
+    int size = _udp.parsePacket();
+    if (size <= 0)
+      break;
+    // The packet that is too small or too large to be a query is
+    // abandoned as it is, the next parsePacket discards the rest.
+    if (size < static_cast<int>(_headerSize) || size > AUTOCONNECT_DNS_PACKETSIZE)
+      continue;
+    if (!_admit(static_cast<uint32_t>(_udp.remoteIP())))
+      continue;
+    if (_udp.read(_packet, size) != size)
+      continue;
+    size_t  len = _reply(size);
+    if (len) {
+      _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
+      _udp.write(_packet, len);
+      _udp.endPacket();
+      replied++;
+    }
+  }
+  return replied;
+}
+
+/**
+ *  Start listening the queries and format the answer record which
+ *  points to the name of the question by the compression with the
+ *  address to be replied.
+ *  @param  port  The port to listen.
+ *  @param  ip    The address to be answered.
+ *  @return true  The socket is ready.
+ */
+bool AutoConnectDNS::start(const uint16_t port, const IPAddress& ip) {
+  const uint32_t  ttl = AUTOCONNECT_DNS_TTL;
+  const uint8_t answer[_answerSize] = {
+    0xc0, 0x0c,                         // Name, points to the question
+    0x00, DNS_TYPE_A,                   // Type
+    0x00, DNS_CLASS_IN,                 // Class
+    static_cast<uint8_t>(ttl >> 24), static_cast<uint8_t>(ttl >> 16),
+    static_cast<uint8_t>(ttl >> 8), static_cast<uint8_t>(ttl),
+    0x00, 0x04,                         // Length of the address
+    ip[0], ip[1], ip[2], ip[3]
+  };
+
+  memcpy(_answer, answer, sizeof(_answer));
+#if AUTOCONNECT_DNS_RATELIMIT > 0
+  memset(_clients, 0x00, sizeof(_clients));
+#endif
+  stop();
+  _active = _udp.begin(port) == 1;
+  return _active;
+}
+
+/**
+ *  Stop listening.
+ */
+void AutoConnectDNS::stop(void) {
+  if (_active) {
+    _udp.stop();
+    _active = false;
+  }
+}
+
+/**
+ *  Count the query for the sender within the window of a second. The
+ *  sender not found takes over the slot of the oldest window.
+ *  @param  addr  IPv4 address of the sender.
+ *  @return true  The query is within the limit.
+ */
+bool AutoConnectDNS::_admit(const uint32_t addr) {
+#if AUTOCONNECT_DNS_RATELIMIT > 0
+  const unsigned long now = millis();
+  AutoConnectDNSClientST* client = &_clients[0];
+
+  for (AutoConnectDNSClientST& entry : _clients) {
+    if (entry.addr == addr) {
+      client = &entry;
+      break;
+    }
+    if (now - entry.window > now - client->window)
+      client = &entry;
+  }
+  if (client->addr != addr || now - client->window >= 1000) {
+    client->addr = addr;
+    client->window = now;
+    client->count = 0;
+  }
+  if (client->count >= AUTOCONNECT_DNS_RATELIMIT)
+    return false;
+  client->count++;
+#else
+  AC_UNUSED(addr);
+#endif
+  return true;
+}
+
+/**
+ *  Turn the query in the packet buffer into the response. The question
+ *  is kept as it is, and the preformatted answer is appended to it for
+ *  the A record of the internet class. The other types are answered
+ *  with no data. The additional records of the query such as EDNS are
+ *  dropped.
+ *  @param  len   The length of the query.
+ *  @return The length of the response, 0 for the query to be ignored.
+ */
+size_t AutoConnectDNS::_reply(const size_t len) {
+  // Only the standard query with a single question is answered.
+  if ((_packet[2] & (DNS_QR | DNS_OPCODE)) || _packet[4] || _packet[5] != 1)
+    return 0;
+
+  // Step over the labels of the name to locate the type and the class.
+  size_t  pos = _headerSize;
+  while (pos < len && _packet[pos]) {
+    if (_packet[pos] & 0xc0)
+      return 0;
+    pos += _packet[pos] + 1;
+  }
+  pos++;
+  if (pos + 4 > len)
+    return 0;
+  const uint16_t  qtype = (_packet[pos] << 8) | _packet[pos + 1];
+  const uint16_t  qclass = (_packet[pos + 2] << 8) | _packet[pos + 3];
+  pos += 4;
+  const bool  answer = (qtype == DNS_TYPE_A || qtype == DNS_TYPE_ANY) && qclass == DNS_CLASS_IN;
+
+  _packet[2] = DNS_QR | DNS_AA | (_packet[2] & DNS_RD);
+  _packet[3] = 0x00;                    // NOERROR
+  _packet[6] = 0x00;                    // ANCOUNT
+  _packet[7] = answer ? 1 : 0;
+  memset(&_packet[8], 0x00, 4);         // NSCOUNT, ARCOUNT
+  if (answer) {
+    memcpy(&_packet[pos], _answer, sizeof(_answer));
+    pos += sizeof(_answer);
+  }
+  return pos;
+}
@@ -0,0 +1,60 @@
+/**
+ *  Declaration of AutoConnectDNS class.
+ *  @file   AutoConnectDNS.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-12
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTDNS_H_
+#define _AUTOCONNECTDNS_H_
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <WiFiUdp.h>
+#include "AutoConnectDefs.h"
+
+/**
+ *  A DNS responder dedicated to the captive portal. It answers every
+ *  query for the A record with the address of the SoftAP, which is
+ *  the only answer the captive portal needs. The answer record is
+ *  formatted in advance at the start and appended to the question as
+ *  it is, and the queries for the other types such as AAAA are replied
+ *  as no data immediately without the answer so that the client falls
+ *  back to IPv4. All the queued queries are processed in a turn up to
+ *  AUTOCONNECT_DNS_DRAINCOUNT, and the clients that send the queries
+ *  more than AUTOCONNECT_DNS_RATELIMIT per second are ignored until
+ *  the next second.
+ */
+class AutoConnectDNS {
+ public:
+  AutoConnectDNS() : _active(false) {}
+  ~AutoConnectDNS() { stop(); }
+  size_t  processRequests(void);                /**< Reply the queued queries */
+  bool    start(const uint16_t port, const IPAddress& ip);
+  void    stop(void);
+
+ protected:
+  /** A sender of the queries counted within the window */
+  typedef struct {
+    uint32_t      addr;                         /**< IPv4 address, 0 for the vacant */
+    unsigned long window;                       /**< millis when the window opened */
+    uint16_t      count;                        /**< Number of queries in the window */
+  } AutoConnectDNSClientST;
+
+  bool    _admit(const uint32_t addr);
+  size_t  _reply(const size_t len);
+
+  static constexpr size_t _headerSize = 12;     /**< Size of DNS header */
+  static constexpr size_t _answerSize = 16;     /**< Size of the answer record */
+  WiFiUDP _udp;                                 /**< UDP socket */
+  bool    _active;                              /**< The socket is listening */
+  uint8_t _answer[_answerSize];                 /**< The preformatted answer record */
+  uint8_t _packet[AUTOCONNECT_DNS_PACKETSIZE + _answerSize];  /**< The query to be the response */
+#if AUTOCONNECT_DNS_RATELIMIT > 0
+  AutoConnectDNSClientST  _clients[AUTOCONNECT_DNS_CLIENTS];  /**< The recent senders */
+#endif
+};
+
+#endif // !_AUTOCONNECTDNS_H_
@@ -97,17 +97,45 @@
 #define AUTOCONNECT_URI_UPDATE_ACT      AUTOCONNECT_URI "/update_act"
 #define AUTOCONNECT_URI_UPDATE_PROGRESS AUTOCONNECT_URI "/update_progress"
 #define AUTOCONNECT_URI_UPDATE_RESULT   AUTOCONNECT_URI "/update_result"
+#define AUTOCONNECT_URI_CSS     AUTOCONNECT_URI "/css"
+#define AUTOCONNECT_URI_METRICS AUTOCONNECT_URI "/metrics"
 
 // Time-out limitation when AutoConnect::begin [ms]
 #ifndef AUTOCONNECT_TIMEOUT
 #define AUTOCONNECT_TIMEOUT     30000
 #endif // !AUTOCONNECT_TIMEOUT
 
+// Time-out limitation of the directed connection with the last known
+// channel and BSSID at fast reconnect [ms]
+#ifndef AUTOCONNECT_FASTCONNECT_TIMEOUT
+#define AUTOCONNECT_FASTCONNECT_TIMEOUT 5000
+#endif // !AUTOCONNECT_FASTCONNECT_TIMEOUT
+
 // Captive portal timeout value [ms]
 #ifndef AUTOCONNECT_CAPTIVEPORTAL_TIMEOUT
 #define AUTOCONNECT_CAPTIVEPORTAL_TIMEOUT 0
 #endif // !AUTOCONNECT_CAPTIVEPORTAL_TIMEOUT
 
+// Interval of counting the stations associated with SoftAP [ms]
+#ifndef AUTOCONNECT_STATIONCHECK_INTERVAL
+#define AUTOCONNECT_STATIONCHECK_INTERVAL 1000
+#endif // !AUTOCONNECT_STATIONCHECK_INTERVAL
+
+// Idle time of the captive portal to start pacing down with powerSave [ms]
+#ifndef AUTOCONNECT_PORTAL_IDLETIME
+#define AUTOCONNECT_PORTAL_IDLETIME   3000
+#endif // !AUTOCONNECT_PORTAL_IDLETIME
+
+// Pause of the idle captive portal loop with the associated stations [ms]
+#ifndef AUTOCONNECT_PORTAL_PACE
+#define AUTOCONNECT_PORTAL_PACE       10
+#endif // !AUTOCONNECT_PORTAL_PACE
+
+// Pause of the idle captive portal loop without any station [ms]
+#ifndef AUTOCONNECT_PORTAL_PACE_NOSTA
+#define AUTOCONNECT_PORTAL_PACE_NOSTA 100
+#endif // !AUTOCONNECT_PORTAL_PACE_NOSTA
+
 // Advance wait time [s]
 #ifndef AUTOCONNECT_STARTUPTIME
 #define AUTOCONNECT_STARTUPTIME (AUTOCONNECT_TIMEOUT/1000)
@@ -118,6 +146,17 @@
 #define AUTOCONNECT_RESPONSE_WAITTIME "2"
 #endif // !AUTOCONNECT_RESPONSE_WAITTIME
 
+// Interval of querying the result of the connection attempt from the
+// page that informs during a connection attempting, unit:[ms] as String
+#ifndef AUTOCONNECT_RESPONSE_INTERVAL
+#define AUTOCONNECT_RESPONSE_INTERVAL "1000"
+#endif // !AUTOCONNECT_RESPONSE_INTERVAL
+
+// Interval of notifying the progress of the connection attempt [ms]
+#ifndef AUTOCONNECT_CONNECT_TICK
+#define AUTOCONNECT_CONNECT_TICK      300
+#endif // !AUTOCONNECT_CONNECT_TICK
+
 // Default HTTP port
 #ifndef AUTOCONNECT_HTTPPORT
 #define AUTOCONNECT_HTTPPORT    80
@@ -128,6 +167,31 @@
 #define AUTOCONNECT_DNSPORT     53
 #endif // !AUTOCONNECT_DNSPORT
 
+// Maximum number of DNS queries replied in a turn of handleClient
+#ifndef AUTOCONNECT_DNS_DRAINCOUNT
+#define AUTOCONNECT_DNS_DRAINCOUNT  16
+#endif // !AUTOCONNECT_DNS_DRAINCOUNT
+
+// Maximum size of DNS query to be replied
+#ifndef AUTOCONNECT_DNS_PACKETSIZE
+#define AUTOCONNECT_DNS_PACKETSIZE  512
+#endif // !AUTOCONNECT_DNS_PACKETSIZE
+
+// Maximum DNS queries per second from a client, 0 for no limit
+#ifndef AUTOCONNECT_DNS_RATELIMIT
+#define AUTOCONNECT_DNS_RATELIMIT   32
+#endif // !AUTOCONNECT_DNS_RATELIMIT
+
+// Number of clients tracked for the DNS rate limit
+#ifndef AUTOCONNECT_DNS_CLIENTS
+#define AUTOCONNECT_DNS_CLIENTS     4
+#endif // !AUTOCONNECT_DNS_CLIENTS
+
+// TTL of the DNS answer for the captive portal [s]
+#ifndef AUTOCONNECT_DNS_TTL
+#define AUTOCONNECT_DNS_TTL         60
+#endif // !AUTOCONNECT_DNS_TTL
+
 // http response transfer method
 #ifndef AUTOCONNECT_HTTP_TRANSFER
 #define AUTOCONNECT_HTTP_TRANSFER PB_ByteStream
@@ -138,6 +202,90 @@
 #define AUTOCONNECT_CONTENTBUFFER_SIZE  (13 * 1024)
 #endif // !AUTOCONNECT_CONTENTBUFFER_SIZE
 
+// Uncomment the following AUTOCONNECT_USE_CSSCACHE to deliver the style
+// sheets of AutoConnect pages as separate cacheable resources that are
+// placed under AUTOCONNECT_URI_CSS, instead of inlining them into every
+// page response.
+//#define AUTOCONNECT_USE_CSSCACHE
+
+// Lifetime of the cached style sheets on the client [s]
+#ifndef AUTOCONNECT_CSSCACHE_MAXAGE
+#define AUTOCONNECT_CSSCACHE_MAXAGE     31536000
+#endif // !AUTOCONNECT_CSSCACHE_MAXAGE
+
+// Memory budget for caching the constructed pages [bytes]
+// Zero disables the page cache, the page is constructed every time the
+// requested URI changes.
+#ifndef AUTOCONNECT_PAGECACHE_SIZE
+#define AUTOCONNECT_PAGECACHE_SIZE      0
+#endif // !AUTOCONNECT_PAGECACHE_SIZE
+
+// Number of clients whose last page is kept in the request context
+#ifndef AUTOCONNECT_CLIENT_CONTEXTS
+#define AUTOCONNECT_CLIENT_CONTEXTS     2
+#endif // !AUTOCONNECT_CLIENT_CONTEXTS
+
+// Uncomment the following AUTOCONNECT_USE_KEEPALIVE to keep the HTTP
+// connection of the internally hosted ESP8266WebServer alive between
+// the requests. It requires ESP8266 core 3.0.0 or later, and it has no
+// effect with ESP32 whose WebServer closes the connection every time.
+//#define AUTOCONNECT_USE_KEEPALIVE
+
+// Uncomment the following AUTOCONNECT_USE_METRICS to collect the cost
+// of the portal such as the response time of each page and the heap
+// consumption, and to export them from AUTOCONNECT_URI_METRICS in the
+// text format of Prometheus.
+//#define AUTOCONNECT_USE_METRICS
+
+// Uncomment the following AUTOCONNECT_USE_PORTALTASK to serve the portal
+// by the dedicated task after AutoConnect::begin, instead of the calls
+// of AutoConnect::handleClient from the loop of the Sketch. It is
+// available only for ESP32.
+//#define AUTOCONNECT_USE_PORTALTASK
+
+// Core, stack size and priority of the portal task
+#ifndef AUTOCONNECT_PORTALTASK_CORE
+#define AUTOCONNECT_PORTALTASK_CORE     0
+#endif // !AUTOCONNECT_PORTALTASK_CORE
+#ifndef AUTOCONNECT_PORTALTASK_STACK
+#define AUTOCONNECT_PORTALTASK_STACK    8192
+#endif // !AUTOCONNECT_PORTALTASK_STACK
+#ifndef AUTOCONNECT_PORTALTASK_PRIORITY
+#define AUTOCONNECT_PORTALTASK_PRIORITY 1
+#endif // !AUTOCONNECT_PORTALTASK_PRIORITY
+
+// Maximum number of pages whose responses are measured
+#ifndef AUTOCONNECT_METRICS_PAGES
+#define AUTOCONNECT_METRICS_PAGES       16
+#endif // !AUTOCONNECT_METRICS_PAGES
+
+// Uncomment the following AUTOCONNECT_USE_STREAMRENDER to render
+// AutoConnect pages directly into the http response with the chunked
+// transfer, without building the whole page content on the heap.
+//#define AUTOCONNECT_USE_STREAMRENDER
+
+// Size of a block of the arena that supplies the scratch buffers
+// during the rendering of a request
+#ifndef AUTOCONNECT_ARENA_SIZE
+#define AUTOCONNECT_ARENA_SIZE          1024
+#endif // !AUTOCONNECT_ARENA_SIZE
+
+// Size of a chunk to send the page rendered with the stream
+#ifndef AUTOCONNECT_STREAM_CHUNKSIZE
+#define AUTOCONNECT_STREAM_CHUNKSIZE    1024
+#endif // !AUTOCONNECT_STREAM_CHUNKSIZE
+
+// Max age of the cached scan results served to the portal pages and
+// the credential selection [ms], 0 always scans
+#ifndef AUTOCONNECT_SCANCACHE_AGE
+#define AUTOCONNECT_SCANCACHE_AGE 10000
+#endif // !AUTOCONNECT_SCANCACHE_AGE
+
+// Time-out limitation to wait for the scan in progress [ms]
+#ifndef AUTOCONNECT_SCAN_TIMEOUT
+#define AUTOCONNECT_SCAN_TIMEOUT  10000
+#endif // !AUTOCONNECT_SCAN_TIMEOUT
+
 // Number of unit lines in the page that lists available SSIDs
 #ifndef AUTOCONNECT_SSIDPAGEUNIT_LINES
 #define AUTOCONNECT_SSIDPAGEUNIT_LINES  5
@@ -148,6 +296,44 @@
 #define AUTOCONNECT_SD_SPEED    4000000
 #endif // !AUTOCONNECT_SD_SPEED
 
+// SPI transfer speed for SD to retry the mount at when it fails with
+// AUTOCONNECT_SD_SPEED, which allows raising AUTOCONNECT_SD_SPEED up
+// to the card limit such as 20MHz or 25MHz [Hz]
+#ifndef AUTOCONNECT_SD_FALLBACKSPEED
+#define AUTOCONNECT_SD_FALLBACKSPEED  4000000
+#endif // !AUTOCONNECT_SD_FALLBACKSPEED
+
+// Size of the write-behind buffer for the upload to the flash file
+// system, rounded up to the page size. 0 writes each chunk directly [byte]
+#ifndef AUTOCONNECT_UPLOAD_FS_BUFFERSIZE
+#define AUTOCONNECT_UPLOAD_FS_BUFFERSIZE  4096
+#endif // !AUTOCONNECT_UPLOAD_FS_BUFFERSIZE
+
+// Size of the write-behind buffer for the upload to SD, rounded up to
+// the sector size. 0 writes each chunk directly [byte]
+#ifndef AUTOCONNECT_UPLOAD_SD_BUFFERSIZE
+#define AUTOCONNECT_UPLOAD_SD_BUFFERSIZE  4096
+#endif // !AUTOCONNECT_UPLOAD_SD_BUFFERSIZE
+
+// Block size of the OTA buffers which are committed to the flash [byte]
+#ifndef AUTOCONNECT_OTA_BLOCKSIZE
+#define AUTOCONNECT_OTA_BLOCKSIZE   4096
+#endif // !AUTOCONNECT_OTA_BLOCKSIZE
+
+// The OTA buffers are committed to the flash by the background task
+// while the next buffer receives the upload. It is available only
+// for ESP32, and comment out this line to commit in the upload loop.
+#if defined(ARDUINO_ARCH_ESP32)
+#define AUTOCONNECT_OTA_BACKGROUND
+#endif
+// Stack size and priority of the OTA commit task
+#ifndef AUTOCONNECT_OTA_TASKSTACK
+#define AUTOCONNECT_OTA_TASKSTACK   4096
+#endif // !AUTOCONNECT_OTA_TASKSTACK
+#ifndef AUTOCONNECT_OTA_TASKPRIORITY
+#define AUTOCONNECT_OTA_TASKPRIORITY  2
+#endif // !AUTOCONNECT_OTA_TASKPRIORITY
+
 // Flicker signal related factors
 // Flicker cycle during AP operation [ms]
 #ifndef AUTOCONNECT_FLICKER_PERIODAP
@@ -173,6 +359,26 @@
 #define AUTOCONNECT_TICKER_PORT       2
 #endif
 #endif
+// Flicker cycle during the OTA update [ms]
+#ifndef AUTOCONNECT_FLICKER_PERIODOTA
+#define AUTOCONNECT_FLICKER_PERIODOTA 200
+#endif // !AUTOCONNECT_FLICKER_PERIODOTA
+// Flicker pulse width during the OTA update (8bit resolution)
+#ifndef AUTOCONNECT_FLICKER_WIDTHOTA
+#define AUTOCONNECT_FLICKER_WIDTHOTA  128
+#endif // !AUTOCONNECT_FLICKER_WIDTHOTA
+// Uncomment the following AUTOCONNECT_USE_HWTICKER to generate the
+// flicker signal by the peripheral, the LEDC for ESP32 and the timer1
+// waveform for ESP8266, instead of the software Ticker. The ticker
+// with the onPeriod callback remains running by the software Ticker.
+//#define AUTOCONNECT_USE_HWTICKER
+// LEDC channel and its resolution used by the flicker signal of ESP32
+#ifndef AUTOCONNECT_TICKER_LEDC_CHANNEL
+#define AUTOCONNECT_TICKER_LEDC_CHANNEL     15
+#endif // !AUTOCONNECT_TICKER_LEDC_CHANNEL
+#ifndef AUTOCONNECT_TICKER_LEDC_RESOLUTION
+#define AUTOCONNECT_TICKER_LEDC_RESOLUTION  16
+#endif // !AUTOCONNECT_TICKER_LEDC_RESOLUTION
 
 // Lowest WiFi signal strength (RSSI) that can be connected.
 #ifndef AUTOCONNECT_MIN_RSSI
@@ -200,6 +406,21 @@
 #define AUTOCONNECT_UPDATE_TIMEOUT    8000
 #endif // !AUTOCONNECT_UPDATE_TIMEOUT
 
+// Number of times to resume the interrupted download of the updater
+#ifndef AUTOCONNECT_UPDATE_RESUME
+#define AUTOCONNECT_UPDATE_RESUME     5
+#endif // !AUTOCONNECT_UPDATE_RESUME
+
+// Interval to resume the interrupted download [ms]
+#ifndef AUTOCONNECT_UPDATE_RESUME_INTERVAL
+#define AUTOCONNECT_UPDATE_RESUME_INTERVAL  3000
+#endif // !AUTOCONNECT_UPDATE_RESUME_INTERVAL
+
+// Size of the chunk to read the updater from the update server
+#ifndef AUTOCONNECT_UPDATE_CHUNKSIZE
+#define AUTOCONNECT_UPDATE_CHUNKSIZE  1024
+#endif // !AUTOCONNECT_UPDATE_CHUNKSIZE
+
 // Maximum wait time until transitioning  AutoConnectUpdate dialog page [ms]
 #ifndef AUTOCONNECT_UPDATE_DURATION
 #define AUTOCONNECT_UPDATE_DURATION   180000
@@ -230,9 +451,16 @@
 #ifndef AUTOCONNECT_UPDATE_DOWNLOAD
 #define AUTOCONNECT_UPDATE_DOWNLOAD   "/"
 #endif // !AUTOCONNECT_UPDATE_DOWNLOAD
-#ifndef AUTOCONNECT_UPDATE_CATALOG_JSONBUFFER_SIZE
-#define AUTOCONNECT_UPDATE_CATALOG_JSONBUFFER_SIZE  256
-#endif // !AUTOCONNECT_UPDATE_CATALOG_JSONBUFFER_SIZE
+
+// Number of the entries displayed on a page of the update catalog
+#ifndef AUTOCONNECT_UPDATE_CATALOG_LIMIT
+#define AUTOCONNECT_UPDATE_CATALOG_LIMIT    16
+#endif // !AUTOCONNECT_UPDATE_CATALOG_LIMIT
+
+// Maximum length of the file name listed in the update catalog
+#ifndef AUTOCONNECT_UPDATE_CATALOG_NAMELEN
+#define AUTOCONNECT_UPDATE_CATALOG_NAMELEN  64
+#endif // !AUTOCONNECT_UPDATE_CATALOG_NAMELEN
 
 // Explicitly avoiding unused warning with token handler of PageBuilder
 #define AC_UNUSED(expr) do { (void)(expr); } while (0)
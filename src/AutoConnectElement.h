@@ -54,4 +54,59 @@ using AutoConnectText     = AutoConnectTextBasis;
 #define ACStyle(n, ...)    AutoConnectStyle n(#n, ##__VA_ARGS__)
 #define ACText(n, ...)     AutoConnectText n(#n, ##__VA_ARGS__)
 
+/**
+ * A descriptor of AutoConnectElement which can be placed in PROGMEM.
+ * AutoConnectAux::load instantiates the element from the descriptor
+ * without the JSON document. The members not used by the type are
+ * nullptr or 0.
+ */
+typedef struct {
+  ACElement_t   type;         /**< Type of the element */
+  const char*   name;         /**< Element name */
+  const char*   value;        /**< Element value, the items separated by '\n' for AC_Radio and AC_Select */
+  const char*   label;        /**< label, action of AC_Button, uri of AC_Submit and style of AC_Text */
+  const char*   pattern;      /**< pattern of AC_Input and format of AC_Text */
+  const char*   placeholder;  /**< placeholder of AC_Input */
+  uint32_t      checked;      /**< checked of AC_Checkbox and AC_Radio, selected of AC_Select */
+  uint32_t      arrange;      /**< labelPosition of AC_Checkbox, order of AC_Radio and store of AC_File */
+  ACPosterior_t post;         /**< Tag to be generated with posterior */
+  bool          global;       /**< The value available in global scope */
+} ACElementDesc_t;
+
+/**
+ * Support declare the descriptor of AutoConnectElement at the compile
+ * time. These functions take the same arguments as the constructor of
+ * each element.
+ */
+constexpr ACElementDesc_t ACElementDesc(const char* name, const char* value, const ACPosterior_t post = AC_Tag_None) {
+  return { AC_Element, name, value, nullptr, nullptr, nullptr, 0, 0, post, false };
+}
+constexpr ACElementDesc_t ACButtonDesc(const char* name, const char* value, const char* action, const ACPosterior_t post = AC_Tag_None) {
+  return { AC_Button, name, value, action, nullptr, nullptr, 0, 0, post, false };
+}
+constexpr ACElementDesc_t ACCheckboxDesc(const char* name, const char* value, const char* label, const bool checked = false, const ACPosition_t labelPosition = AC_Behind, const ACPosterior_t post = AC_Tag_BR) {
+  return { AC_Checkbox, name, value, label, nullptr, nullptr, checked, static_cast<uint32_t>(labelPosition), post, false };
+}
+constexpr ACElementDesc_t ACFileDesc(const char* name, const char* value, const char* label, const ACFile_t store = AC_File_FS, const ACPosterior_t post = AC_Tag_BR) {
+  return { AC_File, name, value, label, nullptr, nullptr, 0, static_cast<uint32_t>(store), post, false };
+}
+constexpr ACElementDesc_t ACInputDesc(const char* name, const char* value, const char* label, const char* pattern = nullptr, const char* placeholder = nullptr, const ACPosterior_t post = AC_Tag_BR) {
+  return { AC_Input, name, value, label, pattern, placeholder, 0, 0, post, false };
+}
+constexpr ACElementDesc_t ACRadioDesc(const char* name, const char* values, const char* label, const ACArrange_t order = AC_Vertical, const uint8_t checked = 0, const ACPosterior_t post = AC_Tag_BR) {
+  return { AC_Radio, name, values, label, nullptr, nullptr, checked, static_cast<uint32_t>(order), post, false };
+}
+constexpr ACElementDesc_t ACSelectDesc(const char* name, const char* options, const char* label, const uint8_t selected = 0, const ACPosterior_t post = AC_Tag_BR) {
+  return { AC_Select, name, options, label, nullptr, nullptr, selected, 0, post, false };
+}
+constexpr ACElementDesc_t ACStyleDesc(const char* name, const char* value) {
+  return { AC_Style, name, value, nullptr, nullptr, nullptr, 0, 0, AC_Tag_None, false };
+}
+constexpr ACElementDesc_t ACSubmitDesc(const char* name, const char* value, const char* uri, const ACPosterior_t post = AC_Tag_None) {
+  return { AC_Submit, name, value, uri, nullptr, nullptr, 0, 0, post, false };
+}
+constexpr ACElementDesc_t ACTextDesc(const char* name, const char* value, const char* style = nullptr, const char* format = nullptr, const ACPosterior_t post = AC_Tag_None) {
+  return { AC_Text, name, value, style, format, nullptr, 0, 0, post, false };
+}
+
 #endif // _AUTOCONNECTELEMENT_H_
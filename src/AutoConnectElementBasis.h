@@ -13,6 +13,7 @@
 #include <vector>
 #include <memory>
 #include "AutoConnectUpload.h"
+#include "AutoConnectString.h"
 
 // AC_AUTOCONNECTELEMENT_ON_VIRTUAL macro absorbs the difference of
 // inheritance attribute of AutoConnectElement depending on the use of JSON.
@@ -71,11 +72,12 @@ typedef enum {
  */
 class AutoConnectElementBasis {
  public:
-  explicit AutoConnectElementBasis(const char* name = "", const char* value = "", const ACPosterior_t post = AC_Tag_None) : name(String(name)), value(String(value)), post(post), enable(true), global(false) {
+  explicit AutoConnectElementBasis(const char* name = "", const char* value = "", const ACPosterior_t post = AC_Tag_None) : name(String(name)), value(String(value)), post(post), enable(true), global(false), _native(false) {
     _type = AC_Element;
   }
   virtual ~AutoConnectElementBasis() {}
-  virtual const String  toHTML(void) const { return enable ? value : String(""); }
+  size_t  emit(Print& out) const;               /**< Write the HTML into the sink */
+  virtual const String  toHTML(void) const;     /**< Returns the HTML as a String */
   ACElement_t typeOf(void) const { return _type; }
   const String  posterior(const String& s) const;
 #ifndef AUTOCONNECT_USE_JSON
@@ -90,7 +92,16 @@ class AutoConnectElementBasis {
   bool    global;     /**< The value available in global scope */
 
  protected:
+  virtual size_t  _emit(Print& out) const { return enable ? out.print(value) : 0; }  /**< Write the HTML of the element */
+  size_t  _openPosterior(Print& out) const;   /**< Write the tag preceding the element */
+  size_t  _closePosterior(Print& out) const;  /**< Write the tag following the element */
+
   ACElement_t _type;  /**< Element type identifier */
+  bool    _native;    /**< Instantiated by AutoConnect as the exact class, toHTML is not overridden */
+
+  friend class AutoConnectAux;
+  friend class AutoConnectOTA;
+  friend class AutoConnectUpdateAct;
 };
 
 /**
@@ -102,13 +113,14 @@ class AutoConnectElementBasis {
  */
 class AutoConnectButtonBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnectElementBasis {
  public:
-  explicit AutoConnectButtonBasis(const char* name = "", const char* value = "", const String& action = String(""), const ACPosterior_t post = AC_Tag_None) : AutoConnectElementBasis(name, value, post), action(String(action)) {
+  explicit AutoConnectButtonBasis(const char* name = "", const char* value = "", const String& action = String(""), const ACPosterior_t post = AC_Tag_None) : AutoConnectElementBasis(name, value, post), action(action) {
     _type = AC_Button;
   }
   ~AutoConnectButtonBasis() {}
-  const String  toHTML(void) const override;
 
-  String  action;
+  AutoConnectString action;  /**< Script code to execute with the button pushed */
+ protected:
+  size_t  _emit(Print& out) const override;  /**< Write the HTML of the element */
 };
 
 /**
@@ -121,15 +133,16 @@ class AutoConnectButtonBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConne
  */
 class AutoConnectCheckboxBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnectElementBasis {
  public:
-  explicit AutoConnectCheckboxBasis(const char* name = "", const char* value = "", const char* label = "", const bool checked = false, const ACPosition_t labelPosition = AC_Behind, const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, value, post), label(String(label)), checked(checked), labelPosition(labelPosition) {
+  explicit AutoConnectCheckboxBasis(const char* name = "", const char* value = "", const char* label = "", const bool checked = false, const ACPosition_t labelPosition = AC_Behind, const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, value, post), label(label), checked(checked), labelPosition(labelPosition) {
     _type = AC_Checkbox;
   }
   virtual ~AutoConnectCheckboxBasis() {}
-  const String  toHTML(void) const override;
 
-  String  label;      /**< A label for a subsequent input box */
+  AutoConnectString label;  /**< A label for a subsequent input box */
   bool    checked;    /**< The element should be pre-selected */
   ACPosition_t  labelPosition;  /**< Output label according to ACPosition_t */
+ protected:
+  size_t  _emit(Print& out) const override;  /**< Write the HTML of the element */
 };
 
 /**
@@ -142,22 +155,22 @@ class AutoConnectCheckboxBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoCon
  */
 class AutoConnectFileBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnectElementBasis {
  public:
-  explicit AutoConnectFileBasis(const char* name = "", const char* value = "", const char* label = "", const ACFile_t store = AC_File_FS, const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, value, post), label(String(label)), store(store), size(0) {
+  explicit AutoConnectFileBasis(const char* name = "", const char* value = "", const char* label = "", const ACFile_t store = AC_File_FS, const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, value, post), label(label), store(store), size(0) {
     _type = AC_File;
     _upload.reset();
   }
   virtual ~AutoConnectFileBasis() {}
-  const String  toHTML(void) const override;
   bool  attach(const ACFile_t store);
   void  detach(void) { _upload.reset(); }
   AutoConnectUploadHandler*  upload(void) const { return _upload.get(); }
 
-  String   label;     /**< A label for a subsequent input box */
+  AutoConnectString label;  /**< A label for a subsequent input box */
   ACFile_t store;     /**< Type of file store */
   String   mimeType;  /**< Uploading file mime type string */
   size_t   size;      /**< Total uploaded bytes */
 
  protected:
+  size_t  _emit(Print& out) const override;  /**< Write the HTML of the element */
   std::unique_ptr<AutoConnectUploadHandler> _upload;
 };
 
@@ -171,16 +184,17 @@ class AutoConnectFileBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnect
  */
 class AutoConnectInputBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnectElementBasis {
  public:
-  explicit AutoConnectInputBasis(const char* name = "", const char* value = "", const char* label = "", const char* pattern = "", const char* placeholder = "", const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, value, post), label(String(label)), pattern(String(pattern)), placeholder(String(placeholder))  {
+  explicit AutoConnectInputBasis(const char* name = "", const char* value = "", const char* label = "", const char* pattern = "", const char* placeholder = "", const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, value, post), label(label), pattern(pattern), placeholder(placeholder)  {
     _type = AC_Input;
   }
   virtual ~AutoConnectInputBasis() {}
-  const String  toHTML(void) const override;
   bool  isValid(void) const;
 
-  String  label;      /**< A label for a subsequent input box */
-  String  pattern;    /**< Format pattern to aid validation of input value */
-  String  placeholder;  /**< Pre-filled placeholder */
+  AutoConnectString label;        /**< A label for a subsequent input box */
+  AutoConnectString pattern;      /**< Format pattern to aid validation of input value */
+  AutoConnectString placeholder;  /**< Pre-filled placeholder */
+ protected:
+  size_t  _emit(Print& out) const override;  /**< Write the HTML of the element */
 };
 
 /**
@@ -193,26 +207,27 @@ class AutoConnectInputBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnec
  */
 class AutoConnectRadioBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnectElementBasis {
  public:
-  explicit AutoConnectRadioBasis(const char* name = "", std::vector<String> const& values = {}, const char* label = "", const ACArrange_t order = AC_Vertical, const uint8_t checked = 0, const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, "", post), label(label), order(order), checked(checked), _values(values) {
+  explicit AutoConnectRadioBasis(const char* name = "", std::vector<String> const& values = {}, const char* label = "", const ACArrange_t order = AC_Vertical, const uint8_t checked = 0, const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, "", post), label(label), order(order), checked(checked), _values(values.begin(), values.end()) {
     _type = AC_Radio;
   }
   virtual ~AutoConnectRadioBasis() {}
-  const String  toHTML(void) const override;
-  const String& operator[] (const std::size_t n) const { return at(n); }
-  void  add(const String& value) { _values.push_back(String(value)); }
+  String  operator[] (const std::size_t n) const { return at(n); }
+  void  add(const String& value) { _values.push_back(AutoConnectString(value)); }
+  void  add(const __FlashStringHelper* value) { _values.push_back(AutoConnectString(value)); }
   size_t  size(void) const { return _values.size(); }
-  const String& at(const std::size_t n) const { return _values.at(n); }
+  String  at(const std::size_t n) const { return _values.at(n).toString(); }
   void  check(const String& value);
   void  empty(const size_t reserve = 0);
-  const String& value(void) const;
+  String  value(void) const;
 
-  String      label;    /**< A label for a subsequent radio buttons */
+  AutoConnectString label;  /**< A label for a subsequent radio buttons */
   ACArrange_t order;    /**< layout order */
   uint8_t     checked;  /**< Index of check marked item */
   std::vector<String> tags; /**< For private API: Tag of each value */
 
  protected:
-  std::vector<String> _values; /**< Items in a group */
+  size_t  _emit(Print& out) const override;  /**< Write the HTML of the element */
+  std::vector<AutoConnectString> _values; /**< Items in a group */
 };
 
 /**
@@ -225,24 +240,25 @@ class AutoConnectRadioBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnec
  */
 class AutoConnectSelectBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnectElementBasis {
  public:
-  explicit AutoConnectSelectBasis(const char* name = "", std::vector<String> const& options = {}, const char* label = "", const uint8_t selected = 0, const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, "", post), label(String(label)), selected(selected), _options(options) {
+  explicit AutoConnectSelectBasis(const char* name = "", std::vector<String> const& options = {}, const char* label = "", const uint8_t selected = 0, const ACPosterior_t post = AC_Tag_BR) : AutoConnectElementBasis(name, "", post), label(label), selected(selected), _options(options.begin(), options.end()) {
     _type = AC_Select;
   }
   virtual ~AutoConnectSelectBasis() {}
-  const String  toHTML(void) const override;
-  const String& operator[] (const std::size_t n) const { return at(n); }
-  void  add(const String& option) { _options.push_back(String(option)); }
+  String  operator[] (const std::size_t n) const { return at(n); }
+  void  add(const String& option) { _options.push_back(AutoConnectString(option)); }
+  void  add(const __FlashStringHelper* option) { _options.push_back(AutoConnectString(option)); }
   size_t  size(void) const { return _options.size(); }
-  const String& at(const std::size_t n) const { return _options.at(n); }
+  String  at(const std::size_t n) const { return _options.at(n).toString(); }
   void  select(const String& value);
   void  empty(const size_t reserve = 0);
-  const String& value(void) const;
+  String  value(void) const;
 
-  String  label;                /**< A label for a subsequent input box */
+  AutoConnectString label;      /**< A label for a subsequent input box */
   uint8_t selected;             /**< Index of checked value (1-based) */
 
  protected:
-  std::vector<String> _options; /**< List options array */
+  size_t  _emit(Print& out) const override;  /**< Write the HTML of the element */
+  std::vector<AutoConnectString> _options; /**< List options array */
 };
 
 /**
@@ -269,13 +285,14 @@ class AutoConnectStyleBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnec
  */
 class AutoConnectSubmitBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnectElementBasis {
  public:
-  explicit AutoConnectSubmitBasis(const char* name = "", const char* value = "", const char* uri = "", const ACPosterior_t post = AC_Tag_None) : AutoConnectElementBasis(name, value, post), uri(String(uri)) {
+  explicit AutoConnectSubmitBasis(const char* name = "", const char* value = "", const char* uri = "", const ACPosterior_t post = AC_Tag_None) : AutoConnectElementBasis(name, value, post), uri(uri) {
     _type = AC_Submit;
   }
   virtual ~AutoConnectSubmitBasis() {}
-  const String  toHTML(void) const override;
 
-  String  uri;        /**< An url of submitting to */
+  AutoConnectString uri;   /**< An url of submitting to */
+ protected:
+  size_t  _emit(Print& out) const override;  /**< Write the HTML of the element */
 };
 
 /**
@@ -290,14 +307,15 @@ class AutoConnectSubmitBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConne
  */
 class AutoConnectTextBasis : AC_AUTOCONNECTELEMENT_ON_VIRTUAL public AutoConnectElementBasis {
  public:
-  explicit AutoConnectTextBasis(const char* name = "", const char* value = "", const char* style = "", const char* format = "", const ACPosterior_t post = AC_Tag_None) : AutoConnectElementBasis(name, value, post), style(String(style)), format(String(format)) {
+  explicit AutoConnectTextBasis(const char* name = "", const char* value = "", const char* style = "", const char* format = "", const ACPosterior_t post = AC_Tag_None) : AutoConnectElementBasis(name, value, post), style(style), format(format) {
     _type = AC_Text;
   }
   virtual ~AutoConnectTextBasis() {}
-  const String  toHTML(void) const override;
 
-  String  style;      /**< CSS style modifier native code */
-  String  format;     /**< C string that contains the text to be written */
+  AutoConnectString style;  /**< CSS style modifier native code */
+  AutoConnectString format; /**< C string that contains the text to be written */
+ protected:
+  size_t  _emit(Print& out) const override;  /**< Write the HTML of the element */
 };
 
 #ifndef AUTOCONNECT_USE_JSON
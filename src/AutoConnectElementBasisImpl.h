@@ -18,6 +18,37 @@
 #include <regex>
 #endif
 #include "AutoConnectElementBasis.h"
+#include "AutoConnectStream.h"
+#include "AutoConnectArena.h"
+
+/**
+ * Write the HTML of the element into the sink. The AutoConnectAux page
+ * writes the elements with it into the response directly.
+ * The element that AutoConnect instantiated itself is written by _emit
+ * without building the String. The element given by the Sketch may be
+ * derived to override toHTML as the earlier version, so its HTML is
+ * obtained with toHTML.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
+ */
+size_t AutoConnectElementBasis::emit(Print& out) const {
+  if (_native)
+    return _emit(out);
+  const String  html = toHTML();
+  return out.print(html);
+}
+
+/**
+ * Generate the HTML of the element as a String. It collects the
+ * output of _emit.
+ * @return  An HTML string.
+ */
+const String AutoConnectElementBasis::toHTML(void) const {
+  String  html = String("");
+  AutoConnectStringSink out(html);
+  _emit(out);
+  return html;
+}
 
 /**
  * Append post-tag accoring by the post attribute.
@@ -35,19 +66,53 @@ const String AutoConnectElementBasis::posterior(const String& s) const {
   return html;
 }
 
+/**
+ * Write the tag that encloses the element according to the post
+ * attribute, which precedes the element.
+ * @param  out  A sink to write the tag.
+ * @return Size of the written tag.
+ */
+size_t AutoConnectElementBasis::_openPosterior(Print& out) const {
+  return post == AC_Tag_P ? out.print(F("<p>")) : 0;
+}
+
+/**
+ * Write the post-tag according to the post attribute, which follows
+ * the element.
+ * @param  out  A sink to write the tag.
+ * @return Size of the written tag.
+ */
+size_t AutoConnectElementBasis::_closePosterior(Print& out) const {
+  if (post == AC_Tag_BR)
+    return out.print(F("<br>"));
+  else if (post == AC_Tag_P)
+    return out.print(F("</p>"));
+  return 0;
+}
+
 /**
  * Generate an HTML <button> element. The onclick behavior depends on
  * the code held in factionf member.
- * @return  An HTML string.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
  */
-const String AutoConnectButtonBasis::toHTML(void) const {
-  String  html = String("");
+size_t AutoConnectButtonBasis::_emit(Print& out) const {
+  size_t  n = 0;
 
   if (enable) {
-    html = String(F("<button type=\"button\" name=\"")) + name + String(F("\" value=\"")) + value + String(F("\" onclick=\"")) + action + String("\">") + value + String(F("</button>"));
-    html = AutoConnectElementBasis::posterior(html);
+    n += _openPosterior(out);
+    n += out.print(F("<button type=\"button\" name=\""));
+    n += out.print(name);
+    n += out.print(F("\" value=\""));
+    n += out.print(value);
+    n += out.print(F("\" onclick=\""));
+    n += action.printTo(out);
+    n += out.print(F("\">"));
+    n += out.print(value);
+    n += out.print(F("</button>"));
+    n += _closePosterior(out);
   }
-  return html;
+  return n;
 }
 
 /**
@@ -56,27 +121,42 @@ const String AutoConnectButtonBasis::toHTML(void) const {
  * action as the value of "name". If the label member is contained, it
  * is placed to the right side of the checkbox to be labeled.
  * f the label member is empty, only the checkbox is placed.
- * @return  An HTML string.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
  */
-const String AutoConnectCheckboxBasis::toHTML(void) const {
-  String  html = String("");
+size_t AutoConnectCheckboxBasis::_emit(Print& out) const {
+  size_t  n = 0;
 
   if (enable) {
-    html = String(F("<input type=\"checkbox\" name=\"")) + name + String(F("\" value=\"")) + value + String("\"");
+    bool  labeled = label.length() > 0;
+    auto  labelTag = [&]() {
+      n += out.print(F("<label for=\""));
+      n += out.print(name);
+      n += out.print(F("\">"));
+      n += label.printTo(out);
+      n += out.print(F("</label>"));
+    };
+
+    n += _openPosterior(out);
+    if (labeled && labelPosition == AC_Infront)
+      labelTag();
+    n += out.print(F("<input type=\"checkbox\" name=\""));
+    n += out.print(name);
+    n += out.print(F("\" value=\""));
+    n += out.print(value);
+    n += out.print('"');
     if (checked)
-      html += String(F(" checked"));
-    if (label.length())
-      html += String(F(" id=\"")) + name + String("\">");
-    if (label.length()) {
-      String  labelTag = String(F("<label for=\"")) + name + String(F("\">")) + label + String(F("</label>"));
-      if (labelPosition == AC_Infront)
-        html = labelTag + html;
-      else if (labelPosition == AC_Behind)
-        html += labelTag;
+      n += out.print(F(" checked"));
+    if (labeled) {
+      n += out.print(F(" id=\""));
+      n += out.print(name);
+      n += out.print(F("\">"));
+      if (labelPosition == AC_Behind)
+        labelTag();
     }
-    html = AutoConnectElementBasis::posterior(html);
+    n += _closePosterior(out);
   }
-  return html;
+  return n;
 }
 
 /**
@@ -84,18 +164,29 @@ const String AutoConnectCheckboxBasis::toHTML(void) const {
  * The entered value can be obtained using the user callback function
  * registered by AutoConnectAux::on after the form is sent in
  * combination with AutoConnectSubmit.
- * @return String  an HTML string.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
  */
-const String AutoConnectFileBasis::toHTML(void) const {
-  String  html = String("");
+size_t AutoConnectFileBasis::_emit(Print& out) const {
+  size_t  n = 0;
 
   if (enable) {
-    if (label.length())
-      html = String(F("<label for=\"")) + name + String(F("\">")) + label + String(F("</label>"));
-    html += String(F("<input type=\"file\" id=\"")) + name + String(F("\" name=\"")) + name + String("\">");
-    html = AutoConnectElementBasis::posterior(html);
+    n += _openPosterior(out);
+    if (label.length()) {
+      n += out.print(F("<label for=\""));
+      n += out.print(name);
+      n += out.print(F("\">"));
+      n += label.printTo(out);
+      n += out.print(F("</label>"));
+    }
+    n += out.print(F("<input type=\"file\" id=\""));
+    n += out.print(name);
+    n += out.print(F("\" name=\""));
+    n += out.print(name);
+    n += out.print(F("\">"));
+    n += _closePosterior(out);
   }
-  return html;
+  return n;
 }
 
 /**
@@ -121,7 +212,7 @@ bool AutoConnectFileBasis::attach(const ACFile_t store) {
   case AC_File_Extern:
     break;
   }
-  return _upload != false;
+  return static_cast<bool>(_upload);
 }
 
 /**
@@ -130,25 +221,45 @@ bool AutoConnectFileBasis::attach(const ACFile_t store) {
  * attribute. The entered value can be obtained using the user callback
  * function registered by AutoConnectAux::on after the form is sent in
  * combination with AutoConnectSubmit.
- * @return String  an HTML string.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
  */
-const String AutoConnectInputBasis::toHTML(void) const {
-  String  html = String("");
+size_t AutoConnectInputBasis::_emit(Print& out) const {
+  size_t  n = 0;
 
   if (enable) {
-    if (label.length())
-      html = String(F("<label for=\"")) + name + String("\">") + label + String(F("</label>"));
-    html += String(F("<input type=\"text\" id=\"")) + name + String(F("\" name=\"")) + name + String("\"");
-    if (pattern.length())
-      html += String(F(" pattern=\"")) + pattern + String("\"");
-    if (placeholder.length())
-      html += String(F(" placeholder=\"")) + placeholder + String("\"");
-    if (value.length())
-      html += String(F(" value=\"")) + value + String("\"");
-    html += String(">");
-    html = AutoConnectElementBasis::posterior(html);
+    n += _openPosterior(out);
+    if (label.length()) {
+      n += out.print(F("<label for=\""));
+      n += out.print(name);
+      n += out.print(F("\">"));
+      n += label.printTo(out);
+      n += out.print(F("</label>"));
+    }
+    n += out.print(F("<input type=\"text\" id=\""));
+    n += out.print(name);
+    n += out.print(F("\" name=\""));
+    n += out.print(name);
+    n += out.print('"');
+    if (pattern.length()) {
+      n += out.print(F(" pattern=\""));
+      n += pattern.printTo(out);
+      n += out.print('"');
+    }
+    if (placeholder.length()) {
+      n += out.print(F(" placeholder=\""));
+      n += placeholder.printTo(out);
+      n += out.print('"');
+    }
+    if (value.length()) {
+      n += out.print(F(" value=\""));
+      n += out.print(value);
+      n += out.print('"');
+    }
+    n += out.print('>');
+    n += _closePosterior(out);
   }
-  return html;
+  return n;
 }
 
 /**
@@ -162,8 +273,9 @@ bool AutoConnectInputBasis::isValid(void) const {
   if (pattern.length()) {
 #if defined(ARDUINO_ARCH_ESP8266)
     regex_t preg;
-    if (regcomp(&preg, pattern.c_str(), REG_EXTENDED) != 0) {
-      AC_DBG("%s regex compile failed\n", pattern.c_str());
+    String  re = pattern.toString();
+    if (regcomp(&preg, re.c_str(), REG_EXTENDED) != 0) {
+      AC_DBG("%s regex compile failed\n", re.c_str());
       rc = false;
     }
     else {
@@ -185,7 +297,7 @@ bool AutoConnectInputBasis::isValid(void) const {
 */
 void AutoConnectRadioBasis::check(const String& value) {
   for (std::size_t n = 0; n < _values.size(); n++) {
-    if (at(n).equalsIgnoreCase(value)) {
+    if (_values.at(n).equalsIgnoreCase(value)) {
       checked = n + 1;
       break;
     }
@@ -200,7 +312,7 @@ void AutoConnectRadioBasis::check(const String& value) {
  */
 void AutoConnectRadioBasis::empty(const size_t reserve) {
   _values.clear();
-  std::vector<String>().swap(_values);
+  std::vector<AutoConnectString>().swap(_values);
   if (reserve)
     _values.reserve(reserve);
   checked = 0;
@@ -208,41 +320,55 @@ void AutoConnectRadioBasis::empty(const size_t reserve) {
 
 /**
  * Generate an HTML <input type=radio> element with an <option> element.
- * @return String  an HTML string.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
  */
-const String AutoConnectRadioBasis::toHTML(void) const {
-  String  html = String("");
+size_t AutoConnectRadioBasis::_emit(Print& out) const {
+  size_t  n = 0;
 
   if (enable) {
+    n += _openPosterior(out);
     if (label.length()) {
-      html = label;
+      n += label.printTo(out);
       if (order == AC_Vertical)
-        html += String(F("<br>"));
+        n += out.print(F("<br>"));
     }
-    uint8_t n = 0;
-    for (const String value : _values) {
-      n++;
-      String  id = name + "_" + String(n);
-      html += String(F("<input type=\"radio\" name=\"")) + name + String(F("\" id=\"")) + id + String(F("\" value=\"")) + value + String("\"");
-      if (n == checked)
-        html += String(F(" checked"));
-      html += String(F("><label for=\"")) + id + String("\">") + value + String(F("</label>"));
-      if (n <= tags.size())
-        html += tags[n - 1];
+    uint8_t item = 0;
+    for (const AutoConnectString& value : _values) {
+      item++;
+      n += out.print(F("<input type=\"radio\" name=\""));
+      n += out.print(name);
+      n += out.print(F("\" id=\""));
+      n += out.print(name);
+      n += out.print('_');
+      n += out.print(item);
+      n += out.print(F("\" value=\""));
+      n += value.printTo(out);
+      n += out.print('"');
+      if (item == checked)
+        n += out.print(F(" checked"));
+      n += out.print(F("><label for=\""));
+      n += out.print(name);
+      n += out.print('_');
+      n += out.print(item);
+      n += out.print(F("\">"));
+      n += value.printTo(out);
+      n += out.print(F("</label>"));
+      if (item <= tags.size())
+        n += out.print(tags[item - 1]);
       if (order == AC_Vertical)
-        html += String(F("<br>"));
+        n += out.print(F("<br>"));
     }
-    html = AutoConnectElementBasis::posterior(html);
+    n += _closePosterior(out);
   }
-  return html;
+  return n;
 }
 
 /**
  * Returns current selected value in the radio same group
  */
-const String& AutoConnectRadioBasis::value(void) const {
-  static const String _nullString = String();
-  return checked ? _values.at(checked - 1) : _nullString;
+String AutoConnectRadioBasis::value(void) const {
+  return checked ? _values.at(checked - 1).toString() : String();
 }
 
 /**
@@ -253,7 +379,7 @@ const String& AutoConnectRadioBasis::value(void) const {
  */
 void AutoConnectSelectBasis::empty(const size_t reserve) {
   _options.clear();
-  std::vector<String>().swap(_options);
+  std::vector<AutoConnectString>().swap(_options);
   if (reserve)
     _options.reserve(reserve);
   selected = 0;
@@ -265,7 +391,7 @@ void AutoConnectSelectBasis::empty(const size_t reserve) {
 */
 void AutoConnectSelectBasis::select(const String& value) {
   for (std::size_t n = 0; n < _options.size(); n++) {
-    if (at(n).equalsIgnoreCase(value)) {
+    if (_options.at(n).equalsIgnoreCase(value)) {
       selected = n + 1;
       break;
     }
@@ -278,80 +404,109 @@ void AutoConnectSelectBasis::select(const String& value) {
  * AutoConnectSelect class as a string array, which would be stored
  * in the 'options' member. If a label member is contained, the <label>
  * element would be generated the preface of <select>.
- * @return String  an HTML string.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
  */
-const String AutoConnectSelectBasis::toHTML(void) const {
-  String  html = String("");
+size_t AutoConnectSelectBasis::_emit(Print& out) const {
+  size_t  n = 0;
 
   if (enable) {
-    if (label.length())
-      html = String(F("<label for=\"")) + name + String("\">") + label + String(F("</label>"));
-    html += String(F("<select name=\"")) + name + String(F("\" id=\"")) + name + String("\">");
-    uint8_t n = 1;
-    for (const String option : _options) {
-      html += String(F("<option value=\"")) + option + "\"";
-      if (n++ == selected)
-        html += String(F(" selected"));
-      html += ">" + option + String(F("</option>"));
+    n += _openPosterior(out);
+    if (label.length()) {
+      n += out.print(F("<label for=\""));
+      n += out.print(name);
+      n += out.print(F("\">"));
+      n += label.printTo(out);
+      n += out.print(F("</label>"));
+    }
+    n += out.print(F("<select name=\""));
+    n += out.print(name);
+    n += out.print(F("\" id=\""));
+    n += out.print(name);
+    n += out.print(F("\">"));
+    uint8_t item = 1;
+    for (const AutoConnectString& option : _options) {
+      n += out.print(F("<option value=\""));
+      n += option.printTo(out);
+      n += out.print('"');
+      if (item++ == selected)
+        n += out.print(F(" selected"));
+      n += out.print('>');
+      n += option.printTo(out);
+      n += out.print(F("</option>"));
     }
-    html += String(F("</select>"));
-    html = AutoConnectElementBasis::posterior(html);
+    n += out.print(F("</select>"));
+    n += _closePosterior(out);
   }
-  return html;
+  return n;
 }
 
 /**
  * Returns current selected value in the radio same group
  */
-const String& AutoConnectSelectBasis::value(void) const {
-  static const String _nullString = String();
-  return selected ? _options.at(selected - 1) : _nullString;
+String AutoConnectSelectBasis::value(void) const {
+  return selected ? _options.at(selected - 1).toString() : String();
 }
 
 /**
  * Generate an HTML <input type=button> element. This element is used
  * for form submission. An 'onclick' attribute calls fixed JavaScript
  * code as 'sa' named and it's included in the template.
- * @return String  an HTML string.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
  */
-const String AutoConnectSubmitBasis::toHTML(void) const {
-  String  html = String("");
+size_t AutoConnectSubmitBasis::_emit(Print& out) const {
+  size_t  n = 0;
 
   if (enable) {
-    html = String(F("<input type=\"button\" name=\"")) + name + String(F("\" value=\"")) + value + String(F("\" onclick=\"_sa('")) + uri + String("')\">");
-    html = AutoConnectElementBasis::posterior(html);
+    n += _openPosterior(out);
+    n += out.print(F("<input type=\"button\" name=\""));
+    n += out.print(name);
+    n += out.print(F("\" value=\""));
+    n += out.print(value);
+    n += out.print(F("\" onclick=\"_sa('"));
+    n += uri.printTo(out);
+    n += out.print(F("')\">"));
+    n += _closePosterior(out);
   }
-  return html;
+  return n;
 }
 
 /**
  * Generate an HTML text element from a string of the value member. If a style
  * exists, it gives a style attribute.
- * @return String  an HTML string.
+ * @param  out  A sink to write the HTML.
+ * @return Size of the written HTML.
  */
-const String AutoConnectTextBasis::toHTML(void) const {
-  String  html = String("");
+size_t AutoConnectTextBasis::_emit(Print& out) const {
+  size_t  n = 0;
 
   if (enable) {
-    html = String(F("<div id=\"")) + name + String('"');
-    String  value_f = value;
-
-    if (style.length())
-      html += String(F(" style=\"")) + style + String("\"");
-    html += String(">");
+    n += _openPosterior(out);
+    n += out.print(F("<div id=\""));
+    n += out.print(name);
+    n += out.print('"');
+    if (style.length()) {
+      n += out.print(F(" style=\""));
+      n += style.printTo(out);
+      n += out.print('"');
+    }
+    n += out.print('>');
+    char* buffer = nullptr;
     if (format.length()) {
-      int   buflen = (value.length() + format.length() + 16 + 1) & (~0xf);
-      char* buffer;
-      if ((buffer = (char*)malloc(buflen))) {
-        snprintf(buffer, buflen, format.c_str(), value.c_str());
-        value_f = String(buffer);
-        free(buffer);
-      }
+      String  fmt = format.toString();
+      int   buflen = (value.length() + fmt.length() + 16 + 1) & (~0xf);
+      if ((buffer = static_cast<char*>(AutoConnectArena::request().allocate(buflen))))
+        snprintf(buffer, buflen, fmt.c_str(), value.c_str());
     }
-    html += value_f + String(F("</div>"));
-    html = AutoConnectElementBasis::posterior(html);
+    if (buffer)
+      n += out.print(buffer);
+    else
+      n += out.print(value);
+    n += out.print(F("</div>"));
+    n += _closePosterior(out);
   }
-  return html;
+  return n;
 }
 
 #endif // _AUTOCONNECTELEMENTBASISIMPL_H_
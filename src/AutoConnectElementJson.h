@@ -195,7 +195,7 @@ class AutoConnectRadioJson : public AutoConnectElementJson, public AutoConnectRa
  public:
   explicit AutoConnectRadioJson(const char* name = "", std::vector<String> const& values = {}, const char* label = "", const ACArrange_t order = AC_Vertical, const uint8_t checked = 0, const ACPosterior_t post = AC_Tag_BR) {
     AutoConnectRadioBasis::name = String(name);
-    AutoConnectRadioBasis::_values = values;
+    AutoConnectRadioBasis::_values.assign(values.begin(), values.end());
     AutoConnectRadioBasis::label = String(label);
     AutoConnectRadioBasis::order = order;
     AutoConnectRadioBasis::checked = checked;
@@ -220,7 +220,7 @@ class AutoConnectSelectJson : public AutoConnectElementJson, public AutoConnectS
  public:
   explicit AutoConnectSelectJson(const char* name = "", std::vector<String> const& options = {}, const char* label = "", const uint8_t selected = 0, const ACPosterior_t post = AC_Tag_BR) {
     AutoConnectSelectBasis::name = String(name);
-    AutoConnectSelectBasis::_options = options;
+    AutoConnectSelectBasis::_options.assign(options.begin(), options.end());
     AutoConnectSelectBasis::label = String(label);
     AutoConnectSelectBasis::selected = selected;
     AutoConnectSelectBasis::post = post;
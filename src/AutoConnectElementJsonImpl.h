@@ -135,7 +135,7 @@ void AutoConnectButtonJson::serialize(JsonObject& json) {
   _serialize(json);
   json[F(AUTOCONNECT_JSON_KEY_TYPE)] = String(F(AUTOCONNECT_JSON_TYPE_ACBUTTON));
   json[F(AUTOCONNECT_JSON_KEY_VALUE)] = value;
-  json[F(AUTOCONNECT_JSON_KEY_ACTION)] = action;
+  json[F(AUTOCONNECT_JSON_KEY_ACTION)] = action.toString();
 }
 
 /**
@@ -187,7 +187,7 @@ void AutoConnectCheckboxJson::serialize(JsonObject& json) {
   json[F(AUTOCONNECT_JSON_KEY_TYPE)] = String(F(AUTOCONNECT_JSON_TYPE_ACCHECKBOX));
   json[F(AUTOCONNECT_JSON_KEY_NAME)] = name;
   json[F(AUTOCONNECT_JSON_KEY_VALUE)] = value;
-  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label;
+  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label.toString();
   json[F(AUTOCONNECT_JSON_KEY_CHECKED)] = checked;
   if (labelPosition == AC_Infront)
     json[F(AUTOCONNECT_JSON_KEY_LABELPOSITION)] = AUTOCONNECT_JSON_VALUE_INFRONT;
@@ -241,7 +241,7 @@ void AutoConnectFileJson::serialize(JsonObject& json) {
   _serialize(json);
   json[F(AUTOCONNECT_JSON_KEY_TYPE)] = String(F(AUTOCONNECT_JSON_TYPE_ACFILE));
   json[F(AUTOCONNECT_JSON_KEY_VALUE)] = value;
-  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label;
+  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label.toString();
   switch (store) {
   case AC_File_FS:
     json[F(AUTOCONNECT_JSON_KEY_STORE)] = AUTOCONNECT_JSON_VALUE_FS;
@@ -294,9 +294,9 @@ void AutoConnectInputJson::serialize(JsonObject& json) {
   _serialize(json);
   json[F(AUTOCONNECT_JSON_KEY_TYPE)] = String(F(AUTOCONNECT_JSON_TYPE_ACINPUT));
   json[F(AUTOCONNECT_JSON_KEY_VALUE)] = value;
-  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label;
-  json[F(AUTOCONNECT_JSON_KEY_PATTERN)] = pattern;
-  json[F(AUTOCONNECT_JSON_KEY_PLACEHOLDER)] = placeholder;
+  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label.toString();
+  json[F(AUTOCONNECT_JSON_KEY_PATTERN)] = pattern.toString();
+  json[F(AUTOCONNECT_JSON_KEY_PLACEHOLDER)] = placeholder.toString();
 }
 
 /**
@@ -306,7 +306,7 @@ void AutoConnectInputJson::serialize(JsonObject& json) {
 size_t AutoConnectRadioJson::getObjectSize(void) const {
   size_t  size = AutoConnectElementJson::getObjectSize() + JSON_OBJECT_SIZE(3) +  JSON_ARRAY_SIZE(_values.size());
   size += sizeof(AUTOCONNECT_JSON_KEY_LABEL) + label.length() + 1 + sizeof(AUTOCONNECT_JSON_KEY_ARRANGE) + sizeof(AUTOCONNECT_JSON_VALUE_HORIZONTAL) + sizeof(AUTOCONNECT_JSON_KEY_CHECKED);
-  for (const String& _value : _values)
+  for (const AutoConnectString& _value : _values)
     size += _value.length() + 1;
   return size;
 }
@@ -354,10 +354,10 @@ bool AutoConnectRadioJson::loadMember(const JsonObject& json) {
 void AutoConnectRadioJson::serialize(JsonObject& json) {
   _serialize(json);
   json[F(AUTOCONNECT_JSON_KEY_TYPE)] = String(F(AUTOCONNECT_JSON_TYPE_ACRADIO));
-  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label;
+  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label.toString();
   ArduinoJsonArray  values = json.createNestedArray(F(AUTOCONNECT_JSON_KEY_VALUE));
-  for (const String& v : _values)
-    values.add(v);
+  for (const AutoConnectString& v : _values)
+    values.add(v.toString());
   switch (order) {
   case AC_Horizontal:
     json[F(AUTOCONNECT_JSON_KEY_ARRANGE)] = String(F(AUTOCONNECT_JSON_VALUE_HORIZONTAL));
@@ -377,7 +377,7 @@ void AutoConnectRadioJson::serialize(JsonObject& json) {
 size_t AutoConnectSelectJson::getObjectSize(void) const {
   size_t  size = AutoConnectElementJson::getObjectSize() + JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(_options.size());
   size += sizeof(AUTOCONNECT_JSON_KEY_LABEL) + label.length() + 1 + sizeof(AUTOCONNECT_JSON_KEY_SELECTED);
-  for (const String& _option : _options)
+  for (const AutoConnectString& _option : _options)
     size += _option.length() + 1;
   return size;
 }
@@ -415,9 +415,9 @@ void AutoConnectSelectJson::serialize(JsonObject& json) {
   _serialize(json);
   json[F(AUTOCONNECT_JSON_KEY_TYPE)] = String(F(AUTOCONNECT_JSON_TYPE_ACSELECT));
   ArduinoJsonArray options = json.createNestedArray(F(AUTOCONNECT_JSON_KEY_OPTION));
-  for (String o : _options)
-    options.add(o);
-  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label;
+  for (const AutoConnectString& o : _options)
+    options.add(o.toString());
+  json[F(AUTOCONNECT_JSON_KEY_LABEL)] = label.toString();
   if (selected > 0)
     json[F(AUTOCONNECT_JSON_KEY_SELECTED)] = selected;
 }
@@ -482,7 +482,7 @@ void AutoConnectSubmitJson::serialize(JsonObject& json) {
   _serialize(json);
   json[F(AUTOCONNECT_JSON_KEY_TYPE)] = String(F(AUTOCONNECT_JSON_TYPE_ACSUBMIT));
   json[F(AUTOCONNECT_JSON_KEY_VALUE)] = value;
-  json[F(AUTOCONNECT_JSON_KEY_URI)] = uri;
+  json[F(AUTOCONNECT_JSON_KEY_URI)] = uri.toString();
 }
 
 /**
@@ -522,8 +522,8 @@ void AutoConnectTextJson::serialize(JsonObject& json) {
   _serialize(json);
   json[F(AUTOCONNECT_JSON_KEY_TYPE)] = String(F(AUTOCONNECT_JSON_TYPE_ACTEXT));
   json[F(AUTOCONNECT_JSON_KEY_VALUE)] = value;
-  json[F(AUTOCONNECT_JSON_KEY_STYLE)] = style;
-  json[F(AUTOCONNECT_JSON_KEY_FORMAT)] = format;
+  json[F(AUTOCONNECT_JSON_KEY_STYLE)] = style.toString();
+  json[F(AUTOCONNECT_JSON_KEY_FORMAT)] = format.toString();
 }
 
 #endif // _AUTOCONNECTELEMENTJSONIMPL_H_
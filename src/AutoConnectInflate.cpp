@@ -0,0 +1,264 @@
+/**
+ *  AutoConnectInflate class implementation.
+ *  Inflates the gzip stream in chunks with the ESP32 ROM inflater.
+ *  @file   AutoConnectInflate.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-06
+ *  @copyright  MIT license.
+ */
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include "AutoConnectInflate.h"
+
+namespace AutoConnectInflateGzip {
+// Fields of the gzip member header, RFC1952.
+const uint8_t ID1 = 0x1f;
+const uint8_t ID2 = 0x8b;
+const uint8_t CM_DEFLATE = 8;
+const uint8_t FHCRC = 0x02;
+const uint8_t FEXTRA = 0x04;
+const uint8_t FNAME = 0x08;
+const uint8_t FCOMMENT = 0x10;
+const uint8_t FIXED_HEADER_SIZE = 10;
+};
+
+/**
+ *  Allocate the inflater context and the output window. The allocation
+ *  failure can be tested with the bool operator.
+ *  @param  sink  A function that receives the inflated data. It
+ *  returns false to stop inflating.
+ */
+AutoConnectInflate::AutoConnectInflate(InflateSinkFuncT sink)
+  : _sink(sink), _dictPos(0), _state(INFLATE_HEADER), _flags(0), _pos(0), _xlen(0), _crc(0), _inflated(0) {
+  _decomp = static_cast<tinfl_decompressor*>(malloc(sizeof(tinfl_decompressor)));
+  _dict = static_cast<uint8_t*>(AutoConnectMemory::allocate(TINFL_LZ_DICT_SIZE, AC_PSRAM_INFLATE));
+  if (_decomp)
+    tinfl_init(_decomp);
+  if (!_decomp || !_dict)
+    AC_DBG("Inflater unavailable, %u bytes required\n", (unsigned int)(sizeof(tinfl_decompressor) + TINFL_LZ_DICT_SIZE));
+}
+
+/**
+ *  Release the inflater.
+ */
+AutoConnectInflate::~AutoConnectInflate() {
+  AutoConnectMemory::release(_dict);
+  free(_decomp);
+}
+
+/**
+ *  Verify that the fed stream has been completed. The trailer CRC32
+ *  and the size must match the inflated data.
+ *  @return true  The stream has been inflated completely.
+ */
+bool AutoConnectInflate::end(void) {
+  if (_state != INFLATE_DONE) {
+    AC_DBG("Inflate incomplete, state %d\n", (int)_state);
+    return false;
+  }
+  return true;
+}
+
+/**
+ *  Examine the head of the stream is the gzip magic.
+ *  @param  buf   The head of the stream.
+ *  @param  size  Size of the buf.
+ *  @return true  The stream is gzip compressed.
+ */
+bool AutoConnectInflate::isGzip(const uint8_t* buf, const size_t size) {
+  return size >= 2 && buf[0] == AutoConnectInflateGzip::ID1 && buf[1] == AutoConnectInflateGzip::ID2;
+}
+
+/**
+ *  Feed the chunk of the compressed stream. The inflated data will be
+ *  handed over to the sink during this call.
+ *  @param  buf   The chunk of the gzip stream.
+ *  @param  size  Size of the chunk.
+ *  @return true  The chunk has been consumed.
+ *  @return false The stream is broken or the sink refused.
+ */
+bool AutoConnectInflate::write(const uint8_t* buf, size_t size) {
+  if (!_decomp || !_dict)
+    _state = INFLATE_ERROR;
+
+  while (size && _state != INFLATE_ERROR) {
+    size_t  consumed;
+    if (_state < INFLATE_BODY)
+      consumed = _header(buf, size);
+    else if (_state == INFLATE_BODY)
+      consumed = _body(buf, size);
+    else if (_state == INFLATE_TRAILER)
+      consumed = _trailer(buf, size);
+    else
+      // Ignore the trailing garbage after the member such as the padding.
+      break;
+    buf += consumed;
+    size -= consumed;
+  }
+  return _state != INFLATE_ERROR;
+}
+
+/**
+ *  Parse the gzip member header byte by byte. The header may be split
+ *  across the chunks.
+ *  @param  buf   The chunk.
+ *  @param  size  Size of the chunk.
+ *  @return The consumed size.
+ */
+size_t AutoConnectInflate::_header(const uint8_t* buf, size_t size) {
+  size_t  n = 0;
+
+  while (n < size && _state < INFLATE_BODY) {
+    uint8_t c = buf[n++];
+    switch (_state) {
+    case INFLATE_HEADER:
+      if ((_pos == 0 && c != AutoConnectInflateGzip::ID1) || (_pos == 1 && c != AutoConnectInflateGzip::ID2) || (_pos == 2 && c != AutoConnectInflateGzip::CM_DEFLATE)) {
+        AC_DBG("Not a gzip stream\n");
+        _state = INFLATE_ERROR;
+        return n;
+      }
+      if (_pos == 3)
+        _flags = c;
+      if (++_pos >= AutoConnectInflateGzip::FIXED_HEADER_SIZE) {
+        _pos = 0;
+        _state = INFLATE_XLEN;
+      }
+      break;
+    case INFLATE_XLEN:
+      if (!(_flags & AutoConnectInflateGzip::FEXTRA)) {
+        n--;
+        _state = INFLATE_NAME;
+        break;
+      }
+      _xlen |= static_cast<uint16_t>(c) << (_pos * 8);
+      if (++_pos >= sizeof(_xlen)) {
+        _pos = 0;
+        _state = _xlen ? INFLATE_EXTRA : INFLATE_NAME;
+      }
+      break;
+    case INFLATE_EXTRA:
+      if (++_pos >= _xlen) {
+        _pos = 0;
+        _state = INFLATE_NAME;
+      }
+      break;
+    case INFLATE_NAME:
+      if (!(_flags & AutoConnectInflateGzip::FNAME) || !c) {
+        if (!(_flags & AutoConnectInflateGzip::FNAME))
+          n--;
+        _state = INFLATE_COMMENT;
+      }
+      break;
+    case INFLATE_COMMENT:
+      if (!(_flags & AutoConnectInflateGzip::FCOMMENT) || !c) {
+        if (!(_flags & AutoConnectInflateGzip::FCOMMENT))
+          n--;
+        _state = INFLATE_HCRC;
+      }
+      break;
+    case INFLATE_HCRC:
+      if (!(_flags & AutoConnectInflateGzip::FHCRC)) {
+        n--;
+        _state = INFLATE_BODY;
+      }
+      else if (++_pos >= sizeof(uint16_t)) {
+        _pos = 0;
+        _state = INFLATE_BODY;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  return n;
+}
+
+/**
+ *  Inflate the deflate stream and hand over the output to the sink
+ *  each time the output window is filled or the input runs out.
+ *  @param  buf   The chunk.
+ *  @param  size  Size of the chunk.
+ *  @return The consumed size.
+ */
+size_t AutoConnectInflate::_body(const uint8_t* buf, size_t size) {
+  size_t  consumed = 0;
+
+  for (;;) {
+    size_t  inSize = size - consumed;
+    size_t  outSize = TINFL_LZ_DICT_SIZE - _dictPos;
+    tinfl_status  st = tinfl_decompress(_decomp, buf + consumed, &inSize, _dict, _dict + _dictPos, &outSize, TINFL_FLAG_HAS_MORE_INPUT);
+    consumed += inSize;
+    if (outSize) {
+      _crc = _crc32(_crc, _dict + _dictPos, outSize);
+      _inflated += outSize;
+      if (!_sink(_dict + _dictPos, outSize)) {
+        _state = INFLATE_ERROR;
+        break;
+      }
+      _dictPos = (_dictPos + outSize) & (TINFL_LZ_DICT_SIZE - 1);
+    }
+    if (st == TINFL_STATUS_DONE) {
+      _pos = 0;
+      _state = INFLATE_TRAILER;
+      break;
+    }
+    if (st < TINFL_STATUS_DONE) {
+      AC_DBG("Inflate failed(%d)\n", (int)st);
+      _state = INFLATE_ERROR;
+      break;
+    }
+    // The output window has room and the input is exhausted.
+    if (st == TINFL_STATUS_NEEDS_MORE_INPUT && consumed >= size)
+      break;
+  }
+  return consumed;
+}
+
+/**
+ *  Collect the trailer and verify the CRC32 and the inflated size.
+ *  @param  buf   The chunk.
+ *  @param  size  Size of the chunk.
+ *  @return The consumed size.
+ */
+size_t AutoConnectInflate::_trailer(const uint8_t* buf, size_t size) {
+  size_t  n = 0;
+
+  while (n < size && _pos < sizeof(_tail))
+    _tail[_pos++] = buf[n++];
+  if (_pos >= sizeof(_tail)) {
+    uint32_t  crc = static_cast<uint32_t>(_tail[0]) | static_cast<uint32_t>(_tail[1]) << 8 | static_cast<uint32_t>(_tail[2]) << 16 | static_cast<uint32_t>(_tail[3]) << 24;
+    uint32_t  isize = static_cast<uint32_t>(_tail[4]) | static_cast<uint32_t>(_tail[5]) << 8 | static_cast<uint32_t>(_tail[6]) << 16 | static_cast<uint32_t>(_tail[7]) << 24;
+    if (crc != _crc || isize != static_cast<uint32_t>(_inflated)) {
+      AC_DBG("Inflated stream mismatch, CRC %08x:%08x, size %u:%u\n", (unsigned int)crc, (unsigned int)_crc, (unsigned int)isize, (unsigned int)_inflated);
+      _state = INFLATE_ERROR;
+    }
+    else
+      _state = INFLATE_DONE;
+  }
+  return n;
+}
+
+/**
+ *  Calculate the CRC32 of the gzip with the nibble table.
+ *  @param  crc   Current CRC32, 0 for the beginning.
+ *  @param  buf   Data to be calculated.
+ *  @param  size  Size of the data.
+ *  @return Updated CRC32.
+ */
+uint32_t AutoConnectInflate::_crc32(uint32_t crc, const uint8_t* buf, size_t size) {
+  static const uint32_t crcNibble[] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+  };
+
+  crc = ~crc;
+  while (size--) {
+    crc ^= *buf++;
+    crc = (crc >> 4) ^ crcNibble[crc & 0x0f];
+    crc = (crc >> 4) ^ crcNibble[crc & 0x0f];
+  }
+  return ~crc;
+}
+
+#endif // !ARDUINO_ARCH_ESP32
@@ -0,0 +1,78 @@
+/**
+ *  Declaration of AutoConnectInflate class.
+ *  @file   AutoConnectInflate.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-06
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTINFLATE_H_
+#define _AUTOCONNECTINFLATE_H_
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <functional>
+#include <Arduino.h>
+#if __has_include(<esp32/rom/miniz.h>)
+#include <esp32/rom/miniz.h>
+#else
+#include <rom/miniz.h>
+#endif
+#include "AutoConnectDefs.h"
+#include "AutoConnectMemory.h"
+
+/**
+ *  A streaming decoder for the gzip compressed updater. The compressed
+ *  stream is fed in chunks of any size and the inflated data is handed
+ *  over to the sink as it is produced, so that the updater can be
+ *  written to the flash without buffering the whole image. It uses the
+ *  inflater residing in the ESP32 ROM with a 32KB dictionary as the
+ *  output window.
+ *  The ESP8266 does not require it because its Updater accepts the
+ *  gzip image as it is and eboot inflates it at the restart.
+ */
+class AutoConnectInflate {
+ public:
+  typedef std::function<bool(const uint8_t*, size_t)> InflateSinkFuncT;
+  explicit AutoConnectInflate(InflateSinkFuncT sink);
+  ~AutoConnectInflate();
+  explicit operator bool() const { return _decomp && _dict; }  /**< The decoder is available */
+  bool    end(void);                                  /**< Verify the end of the stream */
+  size_t  inflated(void) const { return _inflated; }  /**< Inflated size */
+  bool    write(const uint8_t* buf, size_t size);     /**< Feed the compressed stream */
+  static bool isGzip(const uint8_t* buf, const size_t size);  /**< The stream has the gzip magic */
+
+ protected:
+  typedef enum {
+    INFLATE_HEADER,         /**< Parsing the fixed header */
+    INFLATE_XLEN,           /**< Parsing the length of the extra field */
+    INFLATE_EXTRA,          /**< Skipping the extra field */
+    INFLATE_NAME,           /**< Skipping the original file name */
+    INFLATE_COMMENT,        /**< Skipping the comment */
+    INFLATE_HCRC,           /**< Skipping the header CRC */
+    INFLATE_BODY,           /**< Inflating the deflate stream */
+    INFLATE_TRAILER,        /**< Parsing the CRC32 and the size */
+    INFLATE_DONE,           /**< The stream completed */
+    INFLATE_ERROR           /**< The stream is broken */
+  } AC_INFLATESTATE_t;
+
+  size_t  _header(const uint8_t* buf, size_t size);
+  size_t  _body(const uint8_t* buf, size_t size);
+  size_t  _trailer(const uint8_t* buf, size_t size);
+  static uint32_t _crc32(uint32_t crc, const uint8_t* buf, size_t size);
+
+  InflateSinkFuncT    _sink;        /**< Destination of the inflated data */
+  tinfl_decompressor* _decomp;      /**< ROM inflater context */
+  uint8_t*  _dict;                  /**< The output window */
+  size_t    _dictPos;               /**< Current position of the output window */
+  AC_INFLATESTATE_t _state;         /**< Parsing state */
+  uint8_t   _flags;                 /**< FLG of the gzip header */
+  uint16_t  _pos;                   /**< Position in the current field */
+  uint16_t  _xlen;                  /**< Length of the extra field */
+  uint8_t   _tail[8];               /**< CRC32 and ISIZE of the trailer */
+  uint32_t  _crc;                   /**< CRC32 of the inflated data */
+  size_t    _inflated;              /**< Inflated size */
+};
+
+#endif // !ARDUINO_ARCH_ESP32
+#endif // !_AUTOCONNECTINFLATE_H_
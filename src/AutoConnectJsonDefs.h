@@ -11,6 +11,7 @@
 #define _AUTOCONNECTJSONDEFS_H_
 
 #include <ArduinoJson.h>
+#include "AutoConnectMemory.h"
 
 /**
  * Make the Json types and functions consistent with the ArduinoJson
@@ -42,19 +43,13 @@ using ArduinoJsonObject = JsonObject;
 using ArduinoJsonArray = JsonArray;
 #if defined(BOARD_HAS_PSRAM) && ((ARDUINOJSON_VERSION_MAJOR==6 && ARDUINOJSON_VERSION_MINOR>=10) || ARDUINOJSON_VERSION_MAJOR>6)
 // JsonDocument is assigned to PSRAM by ArduinoJson's custom allocator.
+// The placement follows AutoConnectConfig::psram with AC_PSRAM_JSON.
 struct SpiRamAllocatorST {
   void* allocate(size_t size) {
-    uint32_t  caps;
-    if (psramFound())
-      caps = MALLOC_CAP_SPIRAM;
-    else {
-      caps = MALLOC_CAP_8BIT;
-      AC_DBG("PSRAM not found, JSON buffer allocates to the heap.\n");
-    } 
-    return heap_caps_malloc(size, caps);
+    return AutoConnectMemory::allocate(size, AC_PSRAM_JSON);
   }
   void  deallocate(void* pointer) {
-    heap_caps_free(pointer);
+    AutoConnectMemory::release(pointer);
   }
 };
 #define AUTOCONNECT_JSONBUFFER_PRIMITIVE_SIZE AUTOCONNECT_JSONPSRAM_SIZE
@@ -0,0 +1,168 @@
+/**
+ *  AutoConnectJsonScanner class implementation.
+ *  Walks the JSON document on the stream value by value.
+ *  @file   AutoConnectJsonScanner.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-11
+ *  @copyright  MIT license.
+ */
+
+#include "AutoConnectJsonScanner.h"
+
+/**
+ *  Capture the value at the current position as the raw JSON text.
+ *  The white spaces outside the strings are dropped. The number of
+ *  the members that the value contains is counted to estimate the
+ *  document size required to deserialize it.
+ *  @param  text  A String to append the value, nullptr to discard.
+ *  @param  nodes The number of the members of the objects and arrays
+ *  contained in the value.
+ *  @return true  The value has been captured.
+ */
+bool AutoConnectJsonScanner::capture(String* text, size_t* nodes) {
+  size_t  count = 0;
+  int c = _skipWs();
+
+  if (c == '"') {
+    if (text)
+      *text += '"';
+    if (!_string(text))
+      return _fail();
+    if (text)
+      *text += '"';
+  }
+  else if (c == '{' || c == '[') {
+    unsigned int  depth = 0;
+    for (;;) {
+      if (c == '"') {
+        if (text)
+          *text += '"';
+        if (!_string(text))
+          return _fail();
+        if (text)
+          *text += '"';
+      }
+      else if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+        // Each member of the object or the array needs its own slot,
+        // the members are the separators and the first of each.
+        if (c == '{' || c == '[') {
+          depth++;
+          count++;
+        }
+        else if (c == '}' || c == ']')
+          depth--;
+        else if (c == ',')
+          count++;
+        if (text)
+          *text += static_cast<char>(c);
+      }
+      if (!depth)
+        break;
+      if ((c = _read()) < 0)
+        return _fail();
+    }
+  }
+  else if (c < 0 || c == ',' || c == ':' || c == '}' || c == ']')
+    return _fail();
+  else {
+    // A number or a literal such as true, false and null.
+    while (c >= 0 && c != ',' && c != '}' && c != ']' && !isspace(c)) {
+      if (text)
+        *text += static_cast<char>(c);
+      c = _read();
+    }
+    _back = c;
+  }
+  if (nodes)
+    *nodes = count;
+  return true;
+}
+
+/**
+ *  Read the key of the member and the following colon.
+ *  @param  key   A String to store the key. The escape sequences are
+ *  left as they are.
+ *  @return true  The key has been read.
+ */
+bool AutoConnectJsonScanner::key(String& key) {
+  key = String("");
+  if (!next('"') || !_string(&key) || !next(':'))
+    return _fail();
+  return true;
+}
+
+/**
+ *  Step over the character if it comes next except the white spaces.
+ *  @param  c     The character expected.
+ *  @return true  The character has been consumed.
+ *  @return false The next is the other character, which remains.
+ */
+bool AutoConnectJsonScanner::next(const char c) {
+  int n = _skipWs();
+  if (n == c)
+    return true;
+  _back = n;
+  return false;
+}
+
+/**
+ *  Turn to the error state.
+ *  @return Always false.
+ */
+bool AutoConnectJsonScanner::_fail(void) {
+  AC_DBG("JSON stream malformed\n");
+  _error = true;
+  return false;
+}
+
+/**
+ *  Read a byte from the stream within the timeout of the stream.
+ *  @return A byte read, -1 for the end of the stream or the timeout.
+ */
+int AutoConnectJsonScanner::_read(void) {
+  if (_back >= 0) {
+    int c = _back;
+    _back = -1;
+    return c;
+  }
+  char  c;
+  return _stream.readBytes(&c, 1) == 1 ? static_cast<uint8_t>(c) : -1;
+}
+
+/**
+ *  Read the stream skipping the white spaces.
+ *  @return A byte other than the white space, -1 for the end.
+ */
+int AutoConnectJsonScanner::_skipWs(void) {
+  int c;
+  do {
+    c = _read();
+  } while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+  return c;
+}
+
+/**
+ *  Read a string whose opening quotation has been consumed, up to the
+ *  closing quotation. The content is appended as it is including the
+ *  escape sequences.
+ *  @param  text  A String to append the content, nullptr to discard.
+ *  @return true  The string has been read.
+ */
+bool AutoConnectJsonScanner::_string(String* text) {
+  for (;;) {
+    int c = _read();
+    if (c < 0)
+      return false;
+    if (c == '"')
+      return true;
+    if (text)
+      *text += static_cast<char>(c);
+    if (c == '\\') {
+      if ((c = _read()) < 0)
+        return false;
+      if (text)
+        *text += static_cast<char>(c);
+    }
+  }
+}
@@ -0,0 +1,45 @@
+/**
+ *  Declaration of AutoConnectJsonScanner class.
+ *  @file   AutoConnectJsonScanner.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-11
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTJSONSCANNER_H_
+#define _AUTOCONNECTJSONSCANNER_H_
+
+#include <Arduino.h>
+#include <Stream.h>
+#include "AutoConnectDefs.h"
+
+/**
+ *  A scanner that walks the structure of the JSON document on the
+ *  stream without building the document. It steps over the brackets,
+ *  the separators and the keys of the enclosing objects, and captures
+ *  the value at the current position as the raw JSON text, so that the
+ *  values can be deserialized one by one with the buffer only as large
+ *  as each of them. The bytes are read with the timeout of the stream.
+ */
+class AutoConnectJsonScanner {
+ public:
+  explicit AutoConnectJsonScanner(Stream& stream) : _stream(stream), _back(-1), _error(false) {}
+  ~AutoConnectJsonScanner() {}
+  bool  capture(String* text, size_t* nodes = nullptr);  /**< Capture the next value as the raw text */
+  bool  hasError(void) const { return _error; }          /**< The document is broken */
+  bool  key(String& key);                                /**< Read the key of the member */
+  bool  next(const char c);                              /**< Step over the expected character */
+
+ protected:
+  bool  _fail(void);
+  int   _read(void);
+  int   _skipWs(void);
+  bool  _string(String* text);
+
+  Stream& _stream;          /**< The JSON stream */
+  int   _back;              /**< A pushed back byte, -1 for none */
+  bool  _error;             /**< Malformed or timed out */
+};
+
+#endif // !_AUTOCONNECTJSONSCANNER_H_
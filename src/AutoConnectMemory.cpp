@@ -0,0 +1,39 @@
+/**
+ *  AutoConnectMemory class implementation.
+ *  Places the buffers in PSRAM or the internal RAM by the usage.
+ *  @file   AutoConnectMemory.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-16
+ *  @copyright  MIT license.
+ */
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <esp32-hal-psram.h>
+#endif
+#include "AutoConnectMemory.h"
+
+uint16_t AutoConnectMemory::_psram = AC_PSRAM_DEFAULT;
+
+/**
+ *  Allocate the buffer according to the placement policy.
+ *  @param  size  Size of the buffer.
+ *  @param  usage The usage of the buffer.
+ *  @return The buffer allocated, nullptr if the allocation failed.
+ */
+void* AutoConnectMemory::allocate(const size_t size, const AC_PSRAM_t usage) {
+#if defined(ARDUINO_ARCH_ESP32)
+  void* buffer = nullptr;
+  if ((_psram & usage) && psramFound()) {
+    buffer = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!buffer)
+      AC_DBG("PSRAM %u bytes unavailable, allocates to the heap\n", (unsigned int)size);
+  }
+  if (!buffer)
+    buffer = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  return buffer;
+#else
+  AC_UNUSED(usage);
+  return malloc(size);
+#endif
+}
@@ -0,0 +1,53 @@
+/**
+ *  Declaration of AutoConnectMemory class.
+ *  @file   AutoConnectMemory.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-16
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTMEMORY_H_
+#define _AUTOCONNECTMEMORY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#if defined(ARDUINO_ARCH_ESP32)
+#include <esp_heap_caps.h>
+#endif
+#include "AutoConnectDefs.h"
+
+/**< The buffers that can be placed in PSRAM with AutoConnectConfig::psram. */
+typedef enum AC_PSRAM {
+  AC_PSRAM_NONE     = 0x0000,
+  AC_PSRAM_JSON     = 0x0001,   /**< JSON document of AutoConnectAux */
+  AC_PSRAM_STREAM   = 0x0002,   /**< Chunk buffer of the page rendered into the stream */
+  AC_PSRAM_INFLATE  = 0x0004,   /**< Dictionary of the compressed OTA updater */
+  AC_PSRAM_OTA      = 0x0008,   /**< Block buffers of the OTA update */
+  AC_PSRAM_ARENA    = 0x0010,   /**< Scratch buffers of the request */
+  AC_PSRAM_DEFAULT  = AC_PSRAM_JSON | AC_PSRAM_STREAM | AC_PSRAM_INFLATE | AC_PSRAM_ARENA
+} AC_PSRAM_t;
+
+/**
+ *  Allocates the buffers of AutoConnect according to the placement
+ *  policy. With ESP32, the buffer whose usage is contained in the
+ *  policy is placed in PSRAM if it is available, and the others are
+ *  placed in the internal RAM explicitly, so that a latency-critical
+ *  buffer does not move into PSRAM even if the core allows malloc to
+ *  use PSRAM. A buffer which could not be allocated in PSRAM falls
+ *  back to the internal RAM. ESP8266 allocates all buffers from the
+ *  heap as malloc does.
+ */
+class AutoConnectMemory {
+ public:
+  static void*  allocate(const size_t size, const AC_PSRAM_t usage);
+  static void   release(void* buffer) { free(buffer); }   /**< Release the buffer allocated */
+  static void   policy(const uint16_t psram) { _psram = psram; }  /**< Set the usages placed in PSRAM */
+  static uint16_t policy(void) { return _psram; }         /**< Returns the usages placed in PSRAM */
+
+ protected:
+  static uint16_t _psram;       /**< A compound value of the usages placed in PSRAM */
+};
+
+#endif // !_AUTOCONNECTMEMORY_H_
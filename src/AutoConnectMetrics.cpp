@@ -0,0 +1,236 @@
+/**
+ *  AutoConnectMetrics class implementation.
+ *  Collects the cost of the portal and exports it.
+ *  @file   AutoConnectMetrics.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-13
+ *  @copyright  MIT license.
+ */
+
+#include "AutoConnectMetrics.h"
+
+namespace {
+  /**
+   *  Write the TYPE line of the metric family.
+   *  @param  out   A sink to write.
+   *  @param  name  The name of the metric in PROGMEM.
+   *  @param  type  The type of the metric in PROGMEM.
+   *  @return Bytes written.
+   */
+  size_t printType(Print& out, PGM_P name, PGM_P type) {
+    size_t  n = out.print(F("# TYPE autoconnect_"));
+    n += out.print(FPSTR(name));
+    n += out.print(' ');
+    n += out.print(FPSTR(type));
+    n += out.print('\n');
+    return n;
+  }
+
+  /**
+   *  Write the name of the sample with a label.
+   *  @param  out   A sink to write.
+   *  @param  name  The name of the metric in PROGMEM.
+   *  @param  label The label name in PROGMEM, nullptr for no label.
+   *  @param  value The label value.
+   *  @return Bytes written.
+   */
+  size_t printName(Print& out, PGM_P name, PGM_P label, const char* value) {
+    size_t  n = out.print(F("autoconnect_"));
+    n += out.print(FPSTR(name));
+    if (label) {
+      n += out.print('{');
+      n += out.print(FPSTR(label));
+      n += out.print(F("=\""));
+      n += out.print(value);
+      n += out.print(F("\"}"));
+    }
+    n += out.print(' ');
+    return n;
+  }
+
+  /**
+   *  Write a sample of the metric. The line ends with LF only as the
+   *  text format requires.
+   *  @param  out   A sink to write.
+   *  @param  name  The name of the metric in PROGMEM.
+   *  @param  value The value of the sample.
+   *  @param  label The label name in PROGMEM, nullptr for no label.
+   *  @param  lv    The label value.
+   *  @return Bytes written.
+   */
+  size_t printSample(Print& out, PGM_P name, const uint32_t value, PGM_P label = nullptr, const char* lv = nullptr) {
+    size_t  n = printName(out, name, label, lv);
+    n += out.print(value);
+    n += out.print('\n');
+    return n;
+  }
+
+  size_t printSample(Print& out, PGM_P name, const double value, PGM_P label = nullptr, const char* lv = nullptr) {
+    size_t  n = printName(out, name, label, lv);
+    n += out.print(value, 6);
+    n += out.print('\n');
+    return n;
+  }
+}
+
+AutoConnectMetrics::AutoConnectMetrics() : _current(-1), _start(0), _dnsQueries(0), _connectTime(0) {
+  _heapMin = ESP.getFreeHeap();
+  _blockMin = _maxFreeBlock();
+  _connects[0] = _connects[1] = 0;
+}
+
+/**
+ *  Start measuring the response of the page. The page seen for the
+ *  first time is added up to AUTOCONNECT_METRICS_PAGES, and the others
+ *  are not measured.
+ *  @param  uri   A URI of the page.
+ */
+void AutoConnectMetrics::beginPage(const String& uri) {
+  _sampleHeap();
+  _current = -1;
+  for (size_t n = 0; n < _page.size(); n++)
+    if (_page[n].uri == uri) {
+      _current = static_cast<int>(n);
+      break;
+    }
+  if (_current < 0 && _page.size() < AUTOCONNECT_METRICS_PAGES) {
+    _page.push_back({ uri, 0, 0, 0, 0, UINT32_MAX });
+    _current = static_cast<int>(_page.size() - 1);
+  }
+  _start = micros();
+}
+
+/**
+ *  Finish measuring the response of the page in progress. It has no
+ *  effect if no page is in the response.
+ */
+void AutoConnectMetrics::endPage(void) {
+  if (_current < 0)
+    return;
+  PageMetricsST&  page = _page[_current];
+  const uint32_t  elapsed = micros() - _start;
+  page.count++;
+  page.total += elapsed;
+  if (elapsed > page.peak)
+    page.peak = elapsed;
+  _sampleHeap();
+  const uint32_t  heap = ESP.getFreeHeap();
+  if (heap < page.heapMin)
+    page.heapMin = heap;
+  _current = -1;
+}
+
+/**
+ *  Count the connection attempt.
+ *  @param  elapsed     Time taken for the attempt [ms].
+ *  @param  established The connection has been established.
+ */
+void AutoConnectMetrics::connect(const unsigned long elapsed, const bool established) {
+  _connects[established ? 1 : 0]++;
+  _connectTime = elapsed;
+}
+
+/**
+ *  Count the bytes sent for the page in the response.
+ *  @param  bytes Bytes of the content sent.
+ */
+void AutoConnectMetrics::sent(const size_t bytes) {
+  if (_current >= 0)
+    _page[_current].bytes += bytes;
+}
+
+/**
+ *  Export the metrics in the text format of Prometheus.
+ *  @param  out           A sink to write.
+ *  @param  scanTime      Time taken for the last WiFi scan [ms].
+ *  @param  otaThroughput Throughput of the last OTA update [KB/s].
+ *  @return Bytes written.
+ */
+size_t AutoConnectMetrics::printTo(Print& out, const unsigned long scanTime, const uint32_t otaThroughput) const {
+  static const char counter[] PROGMEM = "counter";
+  static const char gauge[] PROGMEM = "gauge";
+  static const char uriLabel[] PROGMEM = "uri";
+  static const char resultLabel[] PROGMEM = "result";
+  static const char pageCount[] PROGMEM = "page_responses_total";
+  static const char pageTotal[] PROGMEM = "page_response_seconds_total";
+  static const char pagePeak[] PROGMEM = "page_response_seconds_max";
+  static const char pageBytes[] PROGMEM = "page_sent_bytes_total";
+  static const char pageHeap[] PROGMEM = "page_free_heap_min_bytes";
+  static const char heapFree[] PROGMEM = "heap_free_bytes";
+  static const char heapMin[] PROGMEM = "heap_free_min_bytes";
+  static const char blockFree[] PROGMEM = "heap_max_block_bytes";
+  static const char blockMin[] PROGMEM = "heap_max_block_min_bytes";
+  static const char dnsQueries[] PROGMEM = "dns_queries_total";
+  static const char connects[] PROGMEM = "connect_attempts_total";
+  static const char connectTime[] PROGMEM = "connect_last_seconds";
+  static const char scanLast[] PROGMEM = "scan_last_seconds";
+  static const char otaRate[] PROGMEM = "ota_throughput_kilobytes_per_second";
+  static const char uptime[] PROGMEM = "uptime_seconds";
+  size_t  n = 0;
+
+  n += printType(out, pageCount, counter);
+  for (const PageMetricsST& page : _page)
+    n += printSample(out, pageCount, page.count, uriLabel, page.uri.c_str());
+  n += printType(out, pageTotal, counter);
+  for (const PageMetricsST& page : _page)
+    n += printSample(out, pageTotal, page.total / 1000000.0, uriLabel, page.uri.c_str());
+  n += printType(out, pagePeak, gauge);
+  for (const PageMetricsST& page : _page)
+    n += printSample(out, pagePeak, page.peak / 1000000.0, uriLabel, page.uri.c_str());
+  n += printType(out, pageBytes, counter);
+  for (const PageMetricsST& page : _page)
+    n += printSample(out, pageBytes, page.bytes, uriLabel, page.uri.c_str());
+  n += printType(out, pageHeap, gauge);
+  for (const PageMetricsST& page : _page)
+    if (page.count)
+      n += printSample(out, pageHeap, page.heapMin, uriLabel, page.uri.c_str());
+
+  n += printType(out, heapFree, gauge);
+  n += printSample(out, heapFree, ESP.getFreeHeap());
+  n += printType(out, heapMin, gauge);
+  n += printSample(out, heapMin, _heapMin);
+  n += printType(out, blockFree, gauge);
+  n += printSample(out, blockFree, _maxFreeBlock());
+  n += printType(out, blockMin, gauge);
+  n += printSample(out, blockMin, _blockMin);
+
+  n += printType(out, dnsQueries, counter);
+  n += printSample(out, dnsQueries, _dnsQueries);
+  n += printType(out, connects, counter);
+  n += printSample(out, connects, _connects[1], resultLabel, "established");
+  n += printSample(out, connects, _connects[0], resultLabel, "failed");
+  n += printType(out, connectTime, gauge);
+  n += printSample(out, connectTime, _connectTime / 1000.0);
+  n += printType(out, scanLast, gauge);
+  n += printSample(out, scanLast, scanTime / 1000.0);
+  n += printType(out, otaRate, gauge);
+  n += printSample(out, otaRate, otaThroughput);
+  n += printType(out, uptime, gauge);
+  n += printSample(out, uptime, static_cast<uint32_t>(millis() / 1000));
+  return n;
+}
+
+/**
+ *  Update the low-water marks of the heap.
+ */
+void AutoConnectMetrics::_sampleHeap(void) {
+  const uint32_t  heap = ESP.getFreeHeap();
+  const uint32_t  block = _maxFreeBlock();
+  if (heap < _heapMin)
+    _heapMin = heap;
+  if (block < _blockMin)
+    _blockMin = block;
+}
+
+/**
+ *  Get the largest block that can be allocated.
+ *  @return Size of the largest free block [bytes].
+ */
+uint32_t AutoConnectMetrics::_maxFreeBlock(void) {
+#if defined(ARDUINO_ARCH_ESP8266)
+  return ESP.getMaxFreeBlockSize();
+#elif defined(ARDUINO_ARCH_ESP32)
+  return ESP.getMaxAllocHeap();
+#endif
+}
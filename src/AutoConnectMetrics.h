@@ -0,0 +1,62 @@
+/**
+ *  Declaration of AutoConnectMetrics class.
+ *  @file   AutoConnectMetrics.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-13
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTMETRICS_H_
+#define _AUTOCONNECTMETRICS_H_
+
+#include <vector>
+#include <Arduino.h>
+#include <Print.h>
+#include "AutoConnectDefs.h"
+
+/**
+ *  Collects the cost of the portal, such as the response time of each
+ *  page, the heap consumption, the DNS queries served and the time
+ *  of the connection attempts, and exports them in the text format of
+ *  Prometheus. The response time of the page is measured from the
+ *  classification of the request until the web server returns from
+ *  handling it. The bytes sent are counted for the pages rendered with
+ *  the stream.
+ */
+class AutoConnectMetrics {
+ public:
+  AutoConnectMetrics();
+  ~AutoConnectMetrics() {}
+  void  beginPage(const String& uri);           /**< The response of the page has started */
+  void  endPage(void);                          /**< The response of the page has finished */
+  void  connect(const unsigned long elapsed, const bool established);  /**< A connection attempt has finished */
+  void  dns(const size_t queries) { _dnsQueries += queries; }         /**< The DNS queries have been replied */
+  void  sent(const size_t bytes);               /**< The page content has been sent */
+  size_t  printTo(Print& out, const unsigned long scanTime, const uint32_t otaThroughput) const;
+
+ protected:
+  /** Metrics of each page */
+  typedef struct {
+    String    uri;                              /**< URI of the page */
+    uint32_t  count;                            /**< Number of the responses */
+    uint64_t  total;                            /**< Total response time [us], does not wrap around */
+    uint32_t  peak;                             /**< Longest response time [us] */
+    uint32_t  bytes;                            /**< Total bytes sent */
+    uint32_t  heapMin;                          /**< Lowest free heap after the response */
+  } PageMetricsST;
+
+  void    _sampleHeap(void);
+  static uint32_t _maxFreeBlock(void);
+
+  std::vector<PageMetricsST>  _page;            /**< Metrics of the pages */
+  int       _current;                           /**< Index of the page in the response, -1 for none */
+  uint32_t  _start;                             /**< micros when the response started */
+  uint32_t  _heapMin;                           /**< Low-water mark of the free heap */
+  uint32_t  _blockMin;                          /**< Low-water mark of the largest free block */
+  uint32_t  _dnsQueries;                        /**< Number of the DNS queries replied */
+  uint32_t  _connects[2];                       /**< Number of the failed and the established connections */
+  unsigned long _connectTime;                   /**< Time of the last connection attempt [ms] */
+};
+
+#endif // !_AUTOCONNECTMETRICS_H_
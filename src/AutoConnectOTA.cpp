@@ -22,6 +22,7 @@
  * A destructor. Release the OTA operation pages.
  */
 AutoConnectOTA::~AutoConnectOTA() {
+  _releaseBuffer();
   _auxUpdate.reset(nullptr);
   _auxResult.reset(nullptr);
 }
@@ -35,6 +36,8 @@ AutoConnectOTA::~AutoConnectOTA() {
 void AutoConnectOTA::attach(AutoConnect& portal) {
   AutoConnectAux* updatePage;
 
+  _portal = &portal;
+
   updatePage = new AutoConnectAux(String(FPSTR(_pageUpdate.uri)), String(FPSTR(_pageUpdate.title)), _pageUpdate.menu);
   _buildAux(updatePage, &_pageUpdate, lengthOf(_elmUpdate));
   _auxUpdate.reset(updatePage);
@@ -50,6 +53,18 @@ void AutoConnectOTA::attach(AutoConnect& portal) {
   portal.join(*_auxResult.get());
 }
 
+/**
+ * Set the port of the flicker signal during the update.
+ * @param  pin  GPIO for flicker, -1 not to flicker.
+ * @param  on   A signal for flicker turn on.
+ */
+void AutoConnectOTA::setTicker(int8_t pin, uint8_t on) {
+  if (pin != -1)
+    _ticker.reset(new AutoConnectTicker(static_cast<uint8_t>(pin), on));
+  else
+    _ticker.reset();
+}
+
 /**
  * Create the update operation pages using a predefined page structure
  * with two structures as ACPage_t and ACElementProp_t which describe
@@ -65,15 +80,17 @@ void AutoConnectOTA::_buildAux(AutoConnectAux* aux, const AutoConnectOTA::ACPage
   for (size_t n = 0; n < elementNum; n++) {
     if (page->element[n].type == AC_Button) {
       AutoConnectButton* element = new AutoConnectButton;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
       if (page->element[n].value)
         element->value = String(FPSTR(page->element[n].value));
       if (page->element[n].peculiar)
-        element->action = String(FPSTR(page->element[n].peculiar));
+        element->action = FPSTR(page->element[n].peculiar);
       aux->add(reinterpret_cast<AutoConnectElement&>(*element));
     }
     else if (page->element[n].type == AC_Element) {
       AutoConnectElement* element = new AutoConnectElement;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
       if (page->element[n].value)
         element->value = String(FPSTR(page->element[n].value));
@@ -81,13 +98,15 @@ void AutoConnectOTA::_buildAux(AutoConnectAux* aux, const AutoConnectOTA::ACPage
     }
     else if (page->element[n].type == AC_File) {
       AutoConnectFile* element = new AutoConnectFile;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
-      element->label = String(FPSTR(page->element[n].peculiar));
+      element->label = FPSTR(page->element[n].peculiar);
       element->store = ACFile_t::AC_File_Extern;
       aux->add(reinterpret_cast<AutoConnectElement&>(*element));
     }
     else if (page->element[n].type ==  AC_Style) {
       AutoConnectStyle* element = new AutoConnectStyle;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
       if (page->element[n].value)
         element->value = String(FPSTR(page->element[n].value));
@@ -95,11 +114,12 @@ void AutoConnectOTA::_buildAux(AutoConnectAux* aux, const AutoConnectOTA::ACPage
     }
     else if (page->element[n].type == AC_Text) {
       AutoConnectText* element = new AutoConnectText;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
       if (page->element[n].value)
         element->value = String(FPSTR(page->element[n].value));
       if (page->element[n].peculiar)
-        element->style = String(FPSTR(page->element[n].peculiar));
+        element->style = FPSTR(page->element[n].peculiar);
       aux->add(reinterpret_cast<AutoConnectText&>(*element));
     }
   }
@@ -122,8 +142,9 @@ bool AutoConnectOTA::_open(const char* filename, const char* mode) {
   uint32_t  maxSketchSpace = (ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000;
   // It only supports FLASH as a sketch area for updating.
   if (Update.begin(maxSketchSpace, U_FLASH)) {
-    if (_tickerPort != -1)
-      pinMode(static_cast<uint8_t>(_tickerPort), OUTPUT);
+    _startTicker();
+    if (!_allocateBuffer())
+      AC_DBG("OTA block buffer unavailable, writes each chunk\n");
     _status = OTA_START;
     AC_DBG("%s updating start\n", filename);
     return true;
@@ -134,22 +155,75 @@ bool AutoConnectOTA::_open(const char* filename, const char* mode) {
 
 /**
  * Writes received updater to the flash.
+ * The received chunks are accumulated into the block buffer, and the
+ * filled block is committed to the flash. With the background commit,
+ * the next block receives the upload while the previous block is
+ * being written. On the ESP32, the gzip compressed updater is inflated
+ * on the way to the block buffer. The ESP8266 Updater accepts it as it
+ * is.
  * This function overrides AutoConnectUploadHandler::_write.
  * @param  buf  Buffer address where received update file was stored.
  * @param  size Size to be written.
  * @return      the amount written
  */
 size_t AutoConnectOTA::_write(const uint8_t *buf, const size_t size) {
-  size_t  wsz = 0;
-  if (_tickerPort != -1)
-    digitalWrite(_tickerPort, digitalRead(_tickerPort) ^ 0x01);
-  if (!_err.length()) {
-    _status = OTA_PROGRESS;
-    wsz = Update.write(const_cast<uint8_t*>(buf), size);
-    if (wsz != size)
+  if (_err.length())
+    return 0;
+
+  _status = OTA_PROGRESS;
+#if defined(ARDUINO_ARCH_ESP32)
+  if (!_amount && AutoConnectInflate::isGzip(buf, size)) {
+    _inflate.reset(new AutoConnectInflate(std::bind(&AutoConnectOTA::_store, this, std::placeholders::_1, std::placeholders::_2)));
+    if (!*_inflate) {
+      _err = String(F("No memory to inflate"));
+      _status = OTA_FAIL;
+      return 0;
+    }
+    AC_DBG("%s is gzip, inflating\n", _binName.c_str());
+  }
+  if (_inflate) {
+    if (!_inflate->write(buf, size)) {
+      if (!_err.length()) {
+        _err = String(F("Inflate failed"));
+        _status = OTA_FAIL;
+      }
+      return 0;
+    }
+    return size;
+  }
+#endif
+  return _store(buf, size) ? size : 0;
+}
+
+/**
+ * Accumulate the updater into the block buffer and commit it when the
+ * block is filled. Without the block buffer, it is written as it is.
+ * @param  buf  The updater to be written.
+ * @param  size Size of the updater.
+ * @return true The updater has been stored.
+ */
+bool AutoConnectOTA::_store(const uint8_t* buf, size_t size) {
+  if (!_buffer[0]) {
+    if (Update.write(const_cast<uint8_t*>(buf), size) != size) {
       _setError();
+      return false;
+    }
+    return true;
   }
-  return wsz;
+
+  while (size) {
+    size_t  len = AUTOCONNECT_OTA_BLOCKSIZE - _fill;
+    if (len > size)
+      len = size;
+    memcpy(_buffer[_bank] + _fill, buf, len);
+    _fill += len;
+    buf += len;
+    size -= len;
+    if (_fill >= AUTOCONNECT_OTA_BLOCKSIZE)
+      if (!_commit())
+        return false;
+  }
+  return true;
 }
 
 /**
@@ -159,6 +233,21 @@ size_t AutoConnectOTA::_write(const uint8_t *buf, const size_t size) {
  * @param  status Updater binary upload completion status.
  */
 void AutoConnectOTA::_close(const HTTPUploadStatus status) {
+#if defined(ARDUINO_ARCH_ESP32)
+  if (_inflate) {
+    if (status == UPLOAD_FILE_END && !_err.length() && !_inflate->end()) {
+      _err = String(F("Incomplete gzip"));
+      _status = OTA_FAIL;
+    }
+    AC_DBG("OTA inflated %u bytes\n", (unsigned int)_inflate->inflated());
+    _inflate.reset();
+  }
+#endif
+  // Write out the remaining block and wait for the commits.
+  if (status == UPLOAD_FILE_END)
+    _flush();
+  _releaseBuffer();
+
   AC_DBG("OTA update");
   if (!_err.length()) {
     if (status == UPLOAD_FILE_END) {
@@ -178,8 +267,7 @@ void AutoConnectOTA::_close(const HTTPUploadStatus status) {
   AC_DBG_DUMB(". %s\n", _err.c_str());
   if (_err.length())
       Update.end(false);
-  if (_tickerPort != -1)
-    digitalWrite(_tickerPort, !_tickerOn);
+  _stopTicker();
 }
 
 /**
@@ -218,6 +306,185 @@ String AutoConnectOTA::_updated(AutoConnectAux& result, PageArgument& args) {
   return String("");
 }
 
+/**
+ * Start the flicker signal of the update. The ticker of the portal is
+ * suspended during the update since both tickers drive the port and
+ * the peripheral generating the signal.
+ */
+void AutoConnectOTA::_startTicker(void) {
+  if (!_ticker)
+    return;
+  _suspended = nullptr;
+  if (_portal && _portal->_ticker && _portal->_ticker->isActive()) {
+    _suspended = _portal->_ticker.get();
+    _suspended->stop();
+  }
+  _ticker->start(AUTOCONNECT_FLICKER_PERIODOTA, (uint8_t)AUTOCONNECT_FLICKER_WIDTHOTA);
+}
+
+/**
+ * Stop the flicker signal of the update and resume the ticker of the
+ * portal with its previous cycle, regardless of the update result.
+ */
+void AutoConnectOTA::_stopTicker(void) {
+  if (!_ticker)
+    return;
+  _ticker->stop();
+  if (_suspended) {
+    _suspended->start();
+    _suspended = nullptr;
+  }
+}
+
+/**
+ * Prepare the block buffers. With the background commit, two blocks
+ * and the commit task are prepared, otherwise a single block is
+ * committed in the upload loop.
+ * @return true   The block buffer is ready.
+ * @return false  The chunks should be written as it is.
+ */
+bool AutoConnectOTA::_allocateBuffer(void) {
+  uint8_t banks = 1;
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_OTA_BACKGROUND)
+  banks = 2;
+#endif
+
+  _releaseBuffer();
+  for (uint8_t n = 0; n < banks; n++) {
+    _buffer[n] = static_cast<uint8_t*>(AutoConnectMemory::allocate(AUTOCONNECT_OTA_BLOCKSIZE, AC_PSRAM_OTA));
+    if (!_buffer[n]) {
+      _releaseBuffer();
+      return false;
+    }
+  }
+  _bank = 0;
+  _fill = 0;
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_OTA_BACKGROUND)
+  _commitFailed = false;
+  _filled = xQueueCreate(banks, sizeof(OTABlock_t));
+  _vacant = xQueueCreate(banks, sizeof(uint8_t));
+  _done = xSemaphoreCreateBinary();
+  if (_filled && _vacant && _done) {
+    // The block 0 is filled first, the block 1 is vacant.
+    const uint8_t vacant = 1;
+    xQueueSend(_vacant, &vacant, 0);
+    if (xTaskCreate(_commitTask, "ACOTA", AUTOCONNECT_OTA_TASKSTACK, this, AUTOCONNECT_OTA_TASKPRIORITY, &_committer) != pdPASS)
+      _committer = nullptr;
+  }
+  if (!_committer)
+    AC_DBG("OTA commit task unavailable\n");
+#endif
+  return true;
+}
+
+/**
+ * Stop the commit task and release the block buffers. The blocks have
+ * not been committed are discarded.
+ */
+void AutoConnectOTA::_releaseBuffer(void) {
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_OTA_BACKGROUND)
+  if (_committer) {
+    const OTABlock_t  term = { 0, 0 };
+    xQueueSend(_filled, &term, portMAX_DELAY);
+    xSemaphoreTake(_done, portMAX_DELAY);
+    _committer = nullptr;
+  }
+  if (_filled) {
+    vQueueDelete(_filled);
+    _filled = nullptr;
+  }
+  if (_vacant) {
+    vQueueDelete(_vacant);
+    _vacant = nullptr;
+  }
+  if (_done) {
+    vSemaphoreDelete(_done);
+    _done = nullptr;
+  }
+#endif
+  for (uint8_t n = 0; n < sizeof(_buffer) / sizeof(_buffer[0]); n++) {
+    if (_buffer[n]) {
+      AutoConnectMemory::release(_buffer[n]);
+      _buffer[n] = nullptr;
+    }
+  }
+  _fill = 0;
+}
+
+/**
+ * Commit the filled block to the flash. With the background commit,
+ * the block is passed to the commit task and the vacant block is taken
+ * for the next. It waits for the commit only if both blocks are filled.
+ * @return true   The block committed.
+ * @return false  Update.write failed.
+ */
+bool AutoConnectOTA::_commit(void) {
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_OTA_BACKGROUND)
+  if (_committer) {
+    const OTABlock_t  block = { _bank, _fill };
+    xQueueSend(_filled, &block, portMAX_DELAY);
+    xQueueReceive(_vacant, &_bank, portMAX_DELAY);
+    _fill = 0;
+    if (_commitFailed) {
+      _setError();
+      return false;
+    }
+    return true;
+  }
+#endif
+
+  const bool  rc = Update.write(_buffer[_bank], _fill) == _fill;
+  _fill = 0;
+  if (!rc)
+    _setError();
+  return rc;
+}
+
+/**
+ * Commit the remaining block and wait until the commit task completes
+ * all blocks.
+ */
+void AutoConnectOTA::_flush(void) {
+  if (_buffer[0] && _fill && !_err.length())
+    _commit();
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_OTA_BACKGROUND)
+  if (_committer) {
+    const OTABlock_t  term = { 0, 0 };
+    xQueueSend(_filled, &term, portMAX_DELAY);
+    xSemaphoreTake(_done, portMAX_DELAY);
+    _committer = nullptr;
+    if (_commitFailed && !_err.length())
+      _setError();
+  }
+#endif
+}
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_OTA_BACKGROUND)
+/**
+ * The task to commit the filled blocks to the flash. The block of size
+ * 0 terminates the task.
+ * @param  pvParameters  AutoConnectOTA instance.
+ */
+void AutoConnectOTA::_commitTask(void* pvParameters) {
+  AutoConnectOTA* ota = static_cast<AutoConnectOTA*>(pvParameters);
+  OTABlock_t  block;
+
+  for (;;) {
+    if (xQueueReceive(ota->_filled, &block, portMAX_DELAY) != pdTRUE)
+      continue;
+    if (!block.size)
+      break;
+    if (!ota->_commitFailed)
+      if (Update.write(ota->_buffer[block.bank], block.size) != block.size)
+        ota->_commitFailed = true;
+    xQueueSend(ota->_vacant, &block.bank, portMAX_DELAY);
+  }
+  xSemaphoreGive(ota->_done);
+  vTaskDelete(NULL);
+}
+#endif
+
 /**
  * Save the last error
  */
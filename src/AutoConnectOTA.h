@@ -18,8 +18,18 @@
 #define _AUTOCONNECTOTA_H_
 
 #include <memory>
+#include "AutoConnectDefs.h"
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_OTA_BACKGROUND)
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
 #include "AutoConnect.h"
 #include "AutoConnectUpload.h"
+#if defined(ARDUINO_ARCH_ESP32)
+#include "AutoConnectInflate.h"
+#endif
 
 class AutoConnectOTA : public AutoConnectUploadHandler {
  public:
@@ -33,13 +43,13 @@ class AutoConnectOTA : public AutoConnectUploadHandler {
     OTA_FAIL                /**< Failed to save binary updater by Update class */
   } AC_OTAStatus_t;
 
-  AutoConnectOTA() : _status(OTA_IDLE), _tickerPort(-1), _tickerOn(LOW) {}
+  AutoConnectOTA() : _status(OTA_IDLE), _portal(nullptr), _suspended(nullptr), _fill(0) { _buffer[0] = _buffer[1] = nullptr; }
   ~AutoConnectOTA();
   void  attach(AutoConnect& portal);
   String  error(void) const { return _err; }                /**< Returns current error string */
   void  menu(const bool post) { _auxUpdate->menu(post); };  /**< Enabel or disable arranging a created AutoConnectOTA page in the menu. */
   AC_OTAStatus_t  status(void) const { return _status; }    /**< Return current error status of the Update class */
-  void  setTicker(int8_t pin, uint8_t on) { _tickerPort = pin, _tickerOn = on; }  /**< Set ticker LED port */
+  void  setTicker(int8_t pin, uint8_t on);                  /**< Set ticker LED port */
 
  protected:
   // Attribute definition of the element to be placed on the update page.
@@ -71,10 +81,37 @@ class AutoConnectOTA : public AutoConnectUploadHandler {
 
  private:
   void  _setError(void);
+  bool  _allocateBuffer(void);  /**< Prepare the block buffers and the commit task */
+  void  _releaseBuffer(void);   /**< Stop the commit task and release the block buffers */
+  bool  _commit(void);          /**< Commit the filled block */
+  bool  _store(const uint8_t* buf, size_t size);  /**< Accumulate the updater into the block */
+  void  _flush(void);           /**< Commit the remaining block and wait for all commits */
+  void  _startTicker(void);     /**< Flicker during the update */
+  void  _stopTicker(void);      /**< Stop flicker and resume the ticker of the portal */
 
   AC_OTAStatus_t  _status;      /**< Status for update progress */
-  int8_t  _tickerPort;          /**< GPIO for flicker */
-  uint8_t _tickerOn;            /**< A signal for flicker turn on */
+  AutoConnect*  _portal;        /**< Hosted AutoConnect */
+  std::unique_ptr<AutoConnectTicker> _ticker;  /**< Flicker during the update */
+  AutoConnectTicker*  _suspended; /**< The ticker of the portal suspended during the update */
+  uint8_t*  _buffer[2];         /**< Double buffered blocks */
+  uint8_t _bank;                /**< The block being filled */
+  size_t  _fill;                /**< Filled size of the block */
+#if defined(ARDUINO_ARCH_ESP32) && defined(AUTOCONNECT_OTA_BACKGROUND)
+  /** A filled block to be committed */
+  typedef struct {
+    uint8_t bank;               /**< The block index */
+    size_t  size;               /**< Size to write, 0 terminates the task */
+  } OTABlock_t;
+  static void _commitTask(void* pvParameters);  /**< The task to commit the blocks */
+  TaskHandle_t      _committer = nullptr;   /**< The commit task */
+  QueueHandle_t     _filled = nullptr;      /**< Blocks to be committed */
+  QueueHandle_t     _vacant = nullptr;      /**< Blocks available to be filled */
+  SemaphoreHandle_t _done = nullptr;        /**< The commit task finished */
+  volatile bool     _commitFailed;          /**< Update.write failed in the commit task */
+#endif
+#if defined(ARDUINO_ARCH_ESP32)
+  std::unique_ptr<AutoConnectInflate> _inflate; /**< Decoder for the gzip updater */
+#endif
   String  _binName;             /**< An updater file name */
   String  _err;                 /**< Occurred error stamp */
 
@@ -15,7 +15,6 @@ extern "C" {
 #elif defined(ARDUINO_ARCH_ESP32)
 #include <esp_spi_flash.h>
 #include <WiFi.h>
-#define ENC_TYPE_NONE WIFI_AUTH_OPEN
 #endif
 #include "AutoConnect.h"
 #include "AutoConnectPage.h"
@@ -762,7 +761,7 @@ const char  AutoConnect::_PAGE_CONNECTING[] PROGMEM = {
     "</div>"
     "<script type=\"text/javascript\">"
       "setTimeout(\"link()\"," AUTOCONNECT_RESPONSE_WAITTIME ");"
-      "function link(){location.href='" AUTOCONNECT_URI_RESULT "';}"
+      "function link(){location.href='" AUTOCONNECT_URI_RESULT "';setTimeout(\"link()\"," AUTOCONNECT_RESPONSE_INTERVAL ");}"
     "</script>"
   "</body>"
   "</html>"
@@ -870,6 +869,82 @@ const char  AutoConnect::_PAGE_DISCONN[] PROGMEM = {
   "</html>"
 };
 
+/**< The replies to the connectivity checks of the client OS. */
+const char  AutoConnect::_RESP_NOCONTENT[] PROGMEM = {
+  "HTTP/1.1 204 No Content\r\n"
+  "Content-Length: 0\r\n"
+  "Connection: close\r\n"
+  "\r\n"
+};
+
+const char  AutoConnect::_RESP_SUCCESS[] PROGMEM = {
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/html\r\n"
+  "Content-Length: 68\r\n"
+  "Connection: close\r\n"
+  "\r\n"
+  "<HTML><HEAD><TITLE>Success</TITLE></HEAD><BODY>Success</BODY></HTML>"
+};
+
+const char  AutoConnect::_RESP_MSCONNECT[] PROGMEM = {
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/plain\r\n"
+  "Content-Length: 22\r\n"
+  "Connection: close\r\n"
+  "\r\n"
+  "Microsoft Connect Test"
+};
+
+const char  AutoConnect::_RESP_MSNCSI[] PROGMEM = {
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/plain\r\n"
+  "Content-Length: 14\r\n"
+  "Connection: close\r\n"
+  "\r\n"
+  "Microsoft NCSI"
+};
+
+const char  AutoConnect::_RESP_FIREFOX[] PROGMEM = {
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/plain\r\n"
+  "Content-Length: 8\r\n"
+  "Connection: close\r\n"
+  "\r\n"
+  "success\n"
+};
+
+// The hosts that the client OS probes to detect the captive portal.
+// While the portal is awaiting the connection, they are redirected to
+// the portal the same as the other hosts. Once the connection is
+// established, each receives the reply that its OS expects to find
+// out the internet is reachable, so the captive portal window of the
+// client can close.
+const AutoConnect::CaptiveProbeST AutoConnect::_captiveProbeHost[] PROGMEM = {
+  { "connectivitycheck.gstatic.com", _RESP_NOCONTENT },
+  { "connectivitycheck.android.com", _RESP_NOCONTENT },
+  { "clients3.google.com",           _RESP_NOCONTENT },
+  { "captive.apple.com",             _RESP_SUCCESS },
+  { "www.apple.com",                 _RESP_SUCCESS },
+  { "www.msftconnecttest.com",       _RESP_MSCONNECT },
+  { "www.msftncsi.com",              _RESP_MSNCSI },
+  { "detectportal.firefox.com",      _RESP_FIREFOX },
+  { "connectivity-check.ubuntu.com", _RESP_NOCONTENT },
+  { "nmcheck.gnome.org",             _RESP_NOCONTENT }
+};
+
+/**
+ *  Find the host in the connectivity check hosts of the client OS.
+ *  @param  host  A host name of the request.
+ *  @return The reply which the OS expects for the online, nullptr if
+ *  the host is not a connectivity check.
+ */
+PGM_P AutoConnect::_captiveProbe(const String& host) {
+  for (uint8_t n = 0; n < sizeof(_captiveProbeHost) / sizeof(CaptiveProbeST); n++)
+    if (!strcmp_P(host.c_str(), _captiveProbeHost[n].host))
+      return reinterpret_cast<PGM_P>(pgm_read_ptr(&_captiveProbeHost[n].reply));
+  return nullptr;
+}
+
 // Each page of AutoConnect is http transferred by the content transfer
 // mode of Page Builder. The default transfer mode is
 // AUTOCONNECT_HTTP_TRANSFER defined in AutoConnectDefs.h. The page to
@@ -889,6 +964,106 @@ const AutoConnect::PageTranserModeST AutoConnect::_pageBuildMode[] = {
   { AUTOCONNECT_URI_FAIL,    AUTOCONNECT_HTTP_TRANSFER, 0 }
 };
 
+#ifdef AUTOCONNECT_USE_CSSCACHE
+// The style sheets of AutoConnect pages are delivered as the independent
+// resources from the following URIs with AUTOCONNECT_USE_CSSCACHE. Each
+// page refers to them with the @import rule instead of inlining the
+// PROGMEM content, so the client can keep them in its cache.
+const AutoConnect::CSSResourceST AutoConnect::_cssResource[] = {
+  { AUTOCONNECT_URI_CSS "/base.css",   _CSS_BASE },
+  { AUTOCONNECT_URI_CSS "/ul.css",     _CSS_UL },
+  { AUTOCONNECT_URI_CSS "/lock.css",   _CSS_ICON_LOCK },
+  { AUTOCONNECT_URI_CSS "/button.css", _CSS_INPUT_BUTTON },
+  { AUTOCONNECT_URI_CSS "/text.css",   _CSS_INPUT_TEXT },
+  { AUTOCONNECT_URI_CSS "/table.css",  _CSS_TABLE },
+  { AUTOCONNECT_URI_CSS "/spinner.css", _CSS_SPINNER },
+  { AUTOCONNECT_URI_CSS "/luxbar.css", _CSS_LUXBAR }
+};
+
+/**
+ *  Register the handlers for each style sheet resource to the hosted
+ *  web server. The handlers must be registered ahead of the PageBuilder
+ *  of AutoConnect pages so that the style sheet request does not
+ *  purge the current page.
+ */
+void AutoConnect::_registerCSS(void) {
+  for (uint8_t n = 0; n < sizeof(_cssResource) / sizeof(CSSResourceST); n++)
+    _webServer->on(String(_cssResource[n].uri), HTTP_GET, std::bind(&AutoConnect::_serveCSS, this, n));
+}
+
+/**
+ *  Respond the style sheet with the validator. The response allows
+ *  the client to keep it permanently because the URI that refers to
+ *  the style sheet contains the digest of its content.
+ *  @param  id  An index of _cssResource.
+ */
+void AutoConnect::_serveCSS(const uint8_t id) {
+  char  etag[11];
+  snprintf_P(etag, sizeof(etag), PSTR("\"%08x\""), static_cast<unsigned int>(_digestCSS(id)));
+  _webServer->sendHeader(String(F("Cache-Control")), String(F("public, max-age=" AUTOCONNECT_STRING_DEPLOY(AUTOCONNECT_CSSCACHE_MAXAGE) ", immutable")));
+  _webServer->sendHeader(String(F("ETag")), String(etag));
+  if (_webServer->header(String(F("If-None-Match"))) == etag) {
+    _webServer->send(304);
+    return;
+  }
+  _webServer->send_P(200, PSTR("text/css"), _cssResource[id].css);
+}
+
+/**
+ *  Calculate the digest of the style sheet by FNV-1a. The digest is
+ *  calculated once per resource and it keeps until the reboot since
+ *  the content resides in the flash.
+ *  @param  id  An index of _cssResource.
+ *  @return The digest value.
+ */
+uint32_t AutoConnect::_digestCSS(const uint8_t id) {
+  static uint32_t digest[sizeof(_cssResource) / sizeof(CSSResourceST)] = { 0 };
+
+  if (!digest[id]) {
+    uint32_t  hash = 2166136261U;
+    PGM_P     p = _cssResource[id].css;
+    char      c;
+    while ((c = static_cast<char>(pgm_read_byte(p++))))
+      hash = (hash ^ static_cast<uint8_t>(c)) * 16777619U;
+    digest[id] = hash;
+  }
+  return digest[id];
+}
+#endif // !AUTOCONNECT_USE_CSSCACHE
+
+/**
+ *  Deploy the style sheet to the page. With AUTOCONNECT_USE_CSSCACHE,
+ *  it generates the @import rule for the style sheet resource instead
+ *  of the style sheet itself.
+ *  @param  css   A style sheet content stored in PROGMEM.
+ *  @return A string to be deployed inside the style element.
+ */
+String AutoConnect::_attachCSS(PGM_P css) {
+#ifdef AUTOCONNECT_USE_CSSCACHE
+  for (uint8_t n = 0; n < sizeof(_cssResource) / sizeof(CSSResourceST); n++)
+    if (_cssResource[n].css == css) {
+      char  rule[sizeof(AUTOCONNECT_URI_CSS) + 40];
+      snprintf_P(rule, sizeof(rule), PSTR("@import url(\"%s?v=%08x\");"), _cssResource[n].uri, static_cast<unsigned int>(_digestCSS(n)));
+      return String(rule);
+    }
+#endif // !AUTOCONNECT_USE_CSSCACHE
+  return String(FPSTR(css));
+}
+
+/**
+ *  Write the style sheet into the sink as same as _attachCSS. The style
+ *  sheet is written straight from PROGMEM without the String copy.
+ *  @param  out   A sink to write the style sheet.
+ *  @param  css   A style sheet content stored in PROGMEM.
+ */
+void AutoConnect::_emitCSS(Print& out, PGM_P css) {
+#ifdef AUTOCONNECT_USE_CSSCACHE
+  out.print(_attachCSS(css));
+#else
+  out.print(FPSTR(css));
+#endif // !AUTOCONNECT_USE_CSSCACHE
+}
+
 uint32_t AutoConnect::_getChipId() {
 #if defined(ARDUINO_ARCH_ESP8266)
   return ESP.getChipId();
@@ -909,37 +1084,37 @@ uint32_t AutoConnect::_getFlashChipRealSize() {
 
 String AutoConnect::_token_CSS_BASE(PageArgument& args) {
   AC_UNUSED(args);
-  return String(FPSTR(_CSS_BASE));
+  return _attachCSS(_CSS_BASE);
 }
 
 String AutoConnect::_token_CSS_UL(PageArgument& args) {
   AC_UNUSED(args);
-  return String(FPSTR(_CSS_UL));
+  return _attachCSS(_CSS_UL);
 }
 
 String AutoConnect::_token_CSS_ICON_LOCK(PageArgument& args) {
   AC_UNUSED(args);
-  return String(FPSTR(_CSS_ICON_LOCK));
+  return _attachCSS(_CSS_ICON_LOCK);
 }
 
 String AutoConnect::_token_CSS_INPUT_BUTTON(PageArgument& args) {
   AC_UNUSED(args);
-  return String(FPSTR(_CSS_INPUT_BUTTON));
+  return _attachCSS(_CSS_INPUT_BUTTON);
 }
 
 String AutoConnect::_token_CSS_INPUT_TEXT(PageArgument& args) {
   AC_UNUSED(args);
-  return String(FPSTR(_CSS_INPUT_TEXT));
+  return _attachCSS(_CSS_INPUT_TEXT);
 }
 
 String AutoConnect::_token_CSS_TABLE(PageArgument& args) {
   AC_UNUSED(args);
-  return String(FPSTR(_CSS_TABLE));
+  return _attachCSS(_CSS_TABLE);
 }
 
 String AutoConnect::_token_CSS_SPINNER(PageArgument& args) {
   AC_UNUSED(args);
-  return String(FPSTR(_CSS_SPINNER));
+  return _attachCSS(_CSS_SPINNER);
 }
 
 String AutoConnect::_token_HEAD(PageArgument& args) {
@@ -978,7 +1153,7 @@ String AutoConnect::_token_MENU_POST(PageArgument& args) {
 
 String AutoConnect::_token_CSS_LUXBAR(PageArgument& args) {
   AC_UNUSED(args);
-  return String(FPSTR(_CSS_LUXBAR));
+  return _attachCSS(_CSS_LUXBAR);
 }
 
 String AutoConnect::_token_ESTAB_SSID(PageArgument& args) {
@@ -1156,7 +1331,14 @@ String AutoConnect::_token_FREE_HEAP(PageArgument& args) {
   return String(_freeHeapSize);
 }
 
-String AutoConnect::_token_LIST_SSID(PageArgument& args) {
+/**
+ *  Write the list of available SSIDs into the sink. Each line of the
+ *  list is formatted into a small line buffer and written immediately,
+ *  so the whole list is never held on the heap.
+ *  @param  out   A sink to write the list.
+ *  @param  args  A reference of PageArgument of the current request.
+ */
+void AutoConnect::_emitListSSID(Print& out, PageArgument& args) {
   // Obtain the page number to display.
   // When the display request is the first page, it will be obtained
   // from the scan results of the WiFiScan class if it has already been
@@ -1165,19 +1347,13 @@ String AutoConnect::_token_LIST_SSID(PageArgument& args) {
   if (args.hasArg(String(F("page"))))
     page = args.arg("page").toInt();
   else {
-    // Scan at a first time
-    WiFi.scanDelete();
-    _scanCount = WiFi.scanNetworks(false, true);
-    AC_DBG("%d network(s) found\n", (int)_scanCount);
-  }
-  // Prepare SSID list content building buffer
-  size_t  bufSize = sizeof('\0') + 192 * (_scanCount > AUTOCONNECT_SSIDPAGEUNIT_LINES ? AUTOCONNECT_SSIDPAGEUNIT_LINES : _scanCount);
-  bufSize += 88 * (_scanCount > AUTOCONNECT_SSIDPAGEUNIT_LINES ? (_scanCount > (AUTOCONNECT_SSIDPAGEUNIT_LINES * 2) ? 2 : 1) : 0);
-  char* ssidList = (char*)malloc(bufSize);
-  if (!ssidList) {
-    AC_DBG("ssidList buffer(%d) allocation failed\n", (int)bufSize);
-    return _emptyString;
+    // The first page is rendered from the cached scan results without
+    // waiting for the scan, and they are refreshed in the background
+    // for the next request.
+    if (_scan.snapshot(_apConfig.scanCache) && !_rfConnecting)
+      _scan.refresh();
   }
+  _scanCount = _scan.count();
   AC_DBG_DUMB("\n");
   // Locate to the page and build SSD list content.
   static const char _ssidList[] PROGMEM =
@@ -1187,21 +1363,20 @@ String AutoConnect::_token_LIST_SSID(PageArgument& args) {
     "<span class=\"img-lock\"></span>";
   static const char _ssidPage[] PROGMEM =
     "<button type=\"submit\" name=\"page\" value=\"%d\" formaction=\"" AUTOCONNECT_URI_CONFIG "\">%s</button>&emsp;";
+  char  line[192];
   _hiddenSSIDCount = 0;
   uint8_t validCount = 0;
   uint8_t dispCount = 0;
-  char* slBuf = ssidList;
-  *slBuf = '\0';
-  for (uint8_t i = 0; i < _scanCount; i++) {
-    String ssid = WiFi.SSID(i);
-    if (ssid.length() > 0) {
+  for (int16_t i = 0; i < _scanCount; i++) {
+    const AutoConnectScan::AutoConnectScanST& ap = _scan[i];
+    if (strlen(ap.ssid) > 0) {
       // An available SSID may be listed.
       // AUTOCONNECT_SSIDPAGEUNIT_LINES determines the number of lines
       // per page in the available SSID list.
       if (validCount >= page * AUTOCONNECT_SSIDPAGEUNIT_LINES && validCount <= (page + 1) * AUTOCONNECT_SSIDPAGEUNIT_LINES - 1) {
         if (++dispCount <= AUTOCONNECT_SSIDPAGEUNIT_LINES) {
-          snprintf_P(slBuf, bufSize - (slBuf - ssidList), (PGM_P)_ssidList, ssid.c_str(), AutoConnect::_toWiFiQuality(WiFi.RSSI(i)), WiFi.channel(i), WiFi.encryptionType(i) != ENC_TYPE_NONE ? (PGM_P)_ssidEnc : "");
-          slBuf += strlen(slBuf);
+          snprintf_P(line, sizeof(line), (PGM_P)_ssidList, ap.ssid, AutoConnect::_toWiFiQuality(ap.rssi), (int)ap.channel, ap.encrypted ? (PGM_P)_ssidEnc : "");
+          out.print(line);
         }
       }
       // The validCount counts the found SSIDs that is not the Hidden
@@ -1213,17 +1388,14 @@ String AutoConnect::_token_LIST_SSID(PageArgument& args) {
   }
   // Prepare perv. button
   if (page >= 1) {
-    snprintf_P(slBuf, bufSize - (slBuf - ssidList), (PGM_P)_ssidPage, page - 1, PSTR("Prev."));
-    slBuf = ssidList + strlen(ssidList);
+    snprintf_P(line, sizeof(line), (PGM_P)_ssidPage, page - 1, PSTR("Prev."));
+    out.print(line);
   }
   // Prepare next button
   if (validCount > (page + 1) * AUTOCONNECT_SSIDPAGEUNIT_LINES) {
-    snprintf_P(slBuf, bufSize - (slBuf - ssidList), (PGM_P)_ssidPage, page + 1, PSTR("Next"));
+    snprintf_P(line, sizeof(line), (PGM_P)_ssidPage, page + 1, PSTR("Next"));
+    out.print(line);
   }
-  // return ssidList;
-  String ssidListStr = String(ssidList);
-  free(ssidList);
-  return ssidListStr;
 }
 
 String AutoConnect::_token_SSID_COUNT(PageArgument& args) {
@@ -1253,9 +1425,12 @@ String AutoConnect::_token_CONFIG_STAIP(PageArgument& args) {
     { PSTR(AUTOCONNECT_PARAMID_DNS1), PSTR("DNS1") },
     { PSTR(AUTOCONNECT_PARAMID_DNS2), PSTR("DNS2") }
   };
-  char  liCont[600];
+  static const size_t  liSize = 600;
+  char* liCont = static_cast<char*>(AutoConnectArena::request().allocate(liSize));
   char* liBuf = liCont;
 
+  if (!liCont)
+    return _emptyString;
   for (uint8_t i = 0; i < 5; i++) {
     IPAddress*  ip = nullptr;
     if (i == 0)
@@ -1269,7 +1444,7 @@ String AutoConnect::_token_CONFIG_STAIP(PageArgument& args) {
     else if (i == 4)
       ip = &_apConfig.dns2;
     String  ipStr = ip != nullptr ? ip->toString() : String(F("0.0.0.0"));
-    snprintf_P(liBuf, sizeof(liCont) - (liBuf - liCont), (PGM_P)_configIPList, reps[i].lid, reps[i].lbl, reps[i].lid, reps[i].lid, ipStr.c_str());
+    snprintf_P(liBuf, liSize - (liBuf - liCont), (PGM_P)_configIPList, reps[i].lid, reps[i].lbl, reps[i].lid, reps[i].lid, ipStr.c_str());
     liBuf += strlen(liBuf);
   }
   return String(liCont);
@@ -1282,40 +1457,43 @@ String AutoConnect::_token_OPEN_SSID(PageArgument& args) {
   static const char _ssidNA[]   PROGMEM = "N/A";
   static const char _ssidLock[] PROGMEM = "<span class=\"img-lock\"></span>";
   static const char _ssidNull[] PROGMEM = "";
-  String ssidList;
+  static const size_t  slSize = 176;
   station_config_t  entry;
-  char  slCont[176];
   char  rssiCont[32];
   AutoConnectCredential credit(_apConfig.boundaryOffset);
 
   uint8_t creEntries = credit.entries();
-  if (creEntries > 0) {
-    ssidList = String("");
-    _scanCount = WiFi.scanNetworks(false, true);
-  }
-  else
-    ssidList = String(F("<p><b>" AUTOCONNECT_TEXT_NOSAVEDCREDENTIALS "</b></p>"));
+  if (creEntries == 0)
+    return String(F("<p><b>" AUTOCONNECT_TEXT_NOSAVEDCREDENTIALS "</b></p>"));
+
+  // The list is built in the arena and copied to the String at once.
+  char* ssidList = static_cast<char*>(AutoConnectArena::request().allocate(creEntries * slSize));
+  if (!ssidList)
+    return _emptyString;
+  char* slCont = ssidList;
+  *slCont = '\0';
+  _scan.snapshot(_apConfig.scanCache);
 
+  credit.begin();
   for (uint8_t i = 0; i < creEntries; i++) {
     rssiCont[0] = '\0';
     PGM_P rssiSym = _ssidNA;
     PGM_P ssidLock = _ssidNull;
     credit.load(i, &entry);
     AC_DBG("A credential #%d loaded\n", (int)i);
-    for (int8_t sc = 0; sc < (int8_t)_scanCount; sc++) {
-      if (!memcmp(entry.bssid, WiFi.BSSID(sc), sizeof(station_config_t::bssid))) {
-        _connectCh = WiFi.channel(sc);
-        snprintf_P(rssiCont, sizeof(rssiCont), (PGM_P)_ssidRssi, AutoConnect::_toWiFiQuality(WiFi.RSSI(sc)), _connectCh);
-        rssiSym = rssiCont;
-        if (WiFi.encryptionType(sc) != ENC_TYPE_NONE)
-          ssidLock = _ssidLock;
-        break;
-      }
+    int16_t sc = _scan.find(entry.bssid);
+    if (sc >= 0) {
+      _connectCh = _scan[sc].channel;
+      snprintf_P(rssiCont, sizeof(rssiCont), (PGM_P)_ssidRssi, AutoConnect::_toWiFiQuality(_scan[sc].rssi), _connectCh);
+      rssiSym = rssiCont;
+      if (_scan[sc].encrypted)
+        ssidLock = _ssidLock;
     }
-    snprintf_P(slCont, sizeof(slCont), (PGM_P)_ssidList, AUTOCONNECT_PARAMID_CRED, reinterpret_cast<char*>(entry.ssid), rssiSym, ssidLock);
-    ssidList += String(slCont);
+    snprintf_P(slCont, slSize, (PGM_P)_ssidList, AUTOCONNECT_PARAMID_CRED, reinterpret_cast<char*>(entry.ssid), rssiSym, ssidLock);
+    slCont += strlen(slCont);
   }
-  return ssidList;
+  credit.end();
+  return String(ssidList);
 }
 
 String AutoConnect::_token_UPTIME(PageArgument& args) {
@@ -1391,6 +1569,64 @@ String AutoConnect::_attachMenuItem(const AC_MENUITEM_t item) {
   return String(li);
 }
 
+/**
+ *  Deploy the page to the PageElement which is handed over to the
+ *  PageBuilder. With AUTOCONNECT_USE_STREAMRENDER, the PageElement
+ *  has only one token that renders the page directly into the http
+ *  response. Otherwise, the mold and the token handlers of the page
+ *  are deployed to the PageElement as usual.
+ *  @param  page  A page to deploy. The ownership is transferred.
+ *  @return A PageElement of the page.
+ */
+PageElement* AutoConnect::_deployPage(AutoConnectPageStream* page) {
+  PageElement*  elm = new PageElement();
+
+#ifdef AUTOCONNECT_USE_STREAMRENDER
+  if (page->streamable) {
+    std::shared_ptr<AutoConnectPageStream>  stream(page);
+    elm->setMold(PSTR("{{STREAM}}"));
+    elm->addToken(String(FPSTR("STREAM")), std::bind(&AutoConnect::_streamPage, this, stream, std::placeholders::_1));
+    // The PageBuilder must not send anything before the stream.
+    _reserve(0);
+    _chunked(PB_ByteStream);
+    return elm;
+  }
+#endif // !AUTOCONNECT_USE_STREAMRENDER
+
+  page->deploy(*elm);
+  delete page;
+  return elm;
+}
+
+#ifdef AUTOCONNECT_USE_STREAMRENDER
+/**
+ *  Render the page directly into the http response with the chunked
+ *  transfer. The content built by the PageBuilder is discarded since
+ *  the response has already been sent.
+ *  @param  page  A page to render.
+ *  @param  args  A reference of PageArgument of the current request.
+ *  @return An empty string.
+ */
+String AutoConnect::_streamPage(std::shared_ptr<AutoConnectPageStream> page, PageArgument& args) {
+  if (page->prologue(args)) {
+    _webServer->sendHeader(String(F("Cache-Control")), String(F("no-cache, no-store, must-revalidate")));
+    _webServer->sendHeader(String(F("Pragma")), String(F("no-cache")));
+    _webServer->sendHeader(String(F("Expires")), String("-1"));
+    _webServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _webServer->send(200, String(F("text/html")), _emptyString);
+    AutoConnectSink sink(*_webServer);
+    page->render(sink, args);
+    sink.end();
+    AC_DBG("%d bytes streamed\n", (int)sink.amount());
+#ifdef AUTOCONNECT_USE_METRICS
+    _metrics.sent(sink.amount());
+#endif // !AUTOCONNECT_USE_METRICS
+  }
+  _responsePage->cancel();
+  return _emptyString;
+}
+#endif // !AUTOCONNECT_USE_STREAMRENDER
+
 /**
  *  This function dynamically build up the response pages that conform to
  *  the requested URI. A PageBuilder instance is stored in _responsePage
@@ -1400,7 +1636,7 @@ String AutoConnect::_attachMenuItem(const AC_MENUITEM_t item) {
  *  @retval false Requested uri is not defined.
  */
 PageElement* AutoConnect::_setupPage(String& uri) {
-  PageElement *elm = new PageElement();
+  AutoConnectPageStream* page = new AutoConnectPageStream();
 
   // Restore menu title
   _menuTitle = _apConfig.title;
@@ -1410,154 +1646,154 @@ PageElement* AutoConnect::_setupPage(String& uri) {
 
     // Setup /auto
     _freeHeapSize = ESP.getFreeHeap();
-    elm->setMold(_PAGE_STAT);
-    elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_BASE")), std::bind(&AutoConnect::_token_CSS_BASE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_TABLE")), std::bind(&AutoConnect::_token_CSS_TABLE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_LUXBAR")), std::bind(&AutoConnect::_token_CSS_LUXBAR, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_PRE")), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_AUX")), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_POST")), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("ESTAB_SSID")), std::bind(&AutoConnect::_token_ESTAB_SSID, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("WIFI_MODE")), std::bind(&AutoConnect::_token_WIFI_MODE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("WIFI_STATUS")), std::bind(&AutoConnect::_token_WIFI_STATUS, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("LOCAL_IP")), std::bind(&AutoConnect::_token_LOCAL_IP, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("SOFTAP_IP")), std::bind(&AutoConnect::_token_SOFTAP_IP, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("GATEWAY")), std::bind(&AutoConnect::_token_GATEWAY, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("NETMASK")), std::bind(&AutoConnect::_token_NETMASK, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("AP_MAC")), std::bind(&AutoConnect::_token_AP_MAC, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("STA_MAC")), std::bind(&AutoConnect::_token_STA_MAC, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CHANNEL")), std::bind(&AutoConnect::_token_CHANNEL, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("DBM")), std::bind(&AutoConnect::_token_DBM, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CPU_FREQ")), std::bind(&AutoConnect::_token_CPU_FREQ, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("FLASH_SIZE")), std::bind(&AutoConnect::_token_FLASH_SIZE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CHIP_ID")), std::bind(&AutoConnect::_token_CHIP_ID, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("FREE_HEAP")), std::bind(&AutoConnect::_token_FREE_HEAP, this, std::placeholders::_1));
+    page->setMold(_PAGE_STAT);
+    page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
+    page->addStream(F("CSS_BASE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_BASE));
+    page->addStream(F("CSS_TABLE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_TABLE));
+    page->addStream(F("CSS_LUXBAR"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_LUXBAR));
+    page->addToken(F("MENU_PRE"), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
+    page->addToken(F("MENU_AUX"), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
+    page->addToken(F("MENU_POST"), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
+    page->addToken(F("ESTAB_SSID"), std::bind(&AutoConnect::_token_ESTAB_SSID, this, std::placeholders::_1));
+    page->addToken(F("WIFI_MODE"), std::bind(&AutoConnect::_token_WIFI_MODE, this, std::placeholders::_1));
+    page->addToken(F("WIFI_STATUS"), std::bind(&AutoConnect::_token_WIFI_STATUS, this, std::placeholders::_1));
+    page->addToken(F("LOCAL_IP"), std::bind(&AutoConnect::_token_LOCAL_IP, this, std::placeholders::_1));
+    page->addToken(F("SOFTAP_IP"), std::bind(&AutoConnect::_token_SOFTAP_IP, this, std::placeholders::_1));
+    page->addToken(F("GATEWAY"), std::bind(&AutoConnect::_token_GATEWAY, this, std::placeholders::_1));
+    page->addToken(F("NETMASK"), std::bind(&AutoConnect::_token_NETMASK, this, std::placeholders::_1));
+    page->addToken(F("AP_MAC"), std::bind(&AutoConnect::_token_AP_MAC, this, std::placeholders::_1));
+    page->addToken(F("STA_MAC"), std::bind(&AutoConnect::_token_STA_MAC, this, std::placeholders::_1));
+    page->addToken(F("CHANNEL"), std::bind(&AutoConnect::_token_CHANNEL, this, std::placeholders::_1));
+    page->addToken(F("DBM"), std::bind(&AutoConnect::_token_DBM, this, std::placeholders::_1));
+    page->addToken(F("CPU_FREQ"), std::bind(&AutoConnect::_token_CPU_FREQ, this, std::placeholders::_1));
+    page->addToken(F("FLASH_SIZE"), std::bind(&AutoConnect::_token_FLASH_SIZE, this, std::placeholders::_1));
+    page->addToken(F("CHIP_ID"), std::bind(&AutoConnect::_token_CHIP_ID, this, std::placeholders::_1));
+    page->addToken(F("FREE_HEAP"), std::bind(&AutoConnect::_token_FREE_HEAP, this, std::placeholders::_1));
   }
   else if (uri == String(AUTOCONNECT_URI_CONFIG) && (_apConfig.menuItems & AC_MENUITEM_CONFIGNEW)) {
 
     // Setup /auto/config
-    elm->setMold(_PAGE_CONFIGNEW);
-    elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_BASE")), std::bind(&AutoConnect::_token_CSS_BASE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_UL")), std::bind(&AutoConnect::_token_CSS_UL, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_ICON_LOCK")), std::bind(&AutoConnect::_token_CSS_ICON_LOCK, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_INPUT_BUTTON")), std::bind(&AutoConnect::_token_CSS_INPUT_BUTTON, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_INPUT_TEXT")), std::bind(&AutoConnect::_token_CSS_INPUT_TEXT, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_LUXBAR")), std::bind(&AutoConnect::_token_CSS_LUXBAR, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_PRE")), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_AUX")), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_POST")), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("LIST_SSID")), std::bind(&AutoConnect::_token_LIST_SSID, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("SSID_COUNT")), std::bind(&AutoConnect::_token_SSID_COUNT, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("HIDDEN_COUNT")), std::bind(&AutoConnect::_token_HIDDEN_COUNT, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CONFIG_IP")), std::bind(&AutoConnect::_token_CONFIG_STAIP, this, std::placeholders::_1));
+    page->setMold(_PAGE_CONFIGNEW);
+    page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
+    page->addStream(F("CSS_BASE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_BASE));
+    page->addStream(F("CSS_UL"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_UL));
+    page->addStream(F("CSS_ICON_LOCK"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_ICON_LOCK));
+    page->addStream(F("CSS_INPUT_BUTTON"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_INPUT_BUTTON));
+    page->addStream(F("CSS_INPUT_TEXT"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_INPUT_TEXT));
+    page->addStream(F("CSS_LUXBAR"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_LUXBAR));
+    page->addToken(F("MENU_PRE"), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
+    page->addToken(F("MENU_AUX"), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
+    page->addToken(F("MENU_POST"), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
+    page->addStream(F("LIST_SSID"), std::bind(&AutoConnect::_emitListSSID, this, std::placeholders::_1, std::placeholders::_2));
+    page->addToken(F("SSID_COUNT"), std::bind(&AutoConnect::_token_SSID_COUNT, this, std::placeholders::_1));
+    page->addToken(F("HIDDEN_COUNT"), std::bind(&AutoConnect::_token_HIDDEN_COUNT, this, std::placeholders::_1));
+    page->addToken(F("CONFIG_IP"), std::bind(&AutoConnect::_token_CONFIG_STAIP, this, std::placeholders::_1));
   }
   else if (uri == String(AUTOCONNECT_URI_CONNECT) && (_apConfig.menuItems & AC_MENUITEM_CONFIGNEW || _apConfig.menuItems & AC_MENUITEM_OPENSSIDS)) {
 
     // Setup /auto/connect
     _menuTitle = FPSTR(AUTOCONNECT_MENUTEXT_CONNECTING);
-    elm->setMold(_PAGE_CONNECTING);
-    elm->addToken(String(FPSTR("REQ")), std::bind(&AutoConnect::_induceConnect, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_BASE")), std::bind(&AutoConnect::_token_CSS_BASE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_SPINNER")), std::bind(&AutoConnect::_token_CSS_SPINNER, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_LUXBAR")), std::bind(&AutoConnect::_token_CSS_LUXBAR, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_PRE")), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_POST")), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CUR_SSID")), std::bind(&AutoConnect::_token_CURRENT_SSID, this, std::placeholders::_1));
+    page->setMold(_PAGE_CONNECTING);
+    page->addToken(F("REQ"), std::bind(&AutoConnect::_induceConnect, this, std::placeholders::_1));
+    page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
+    page->addStream(F("CSS_BASE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_BASE));
+    page->addStream(F("CSS_SPINNER"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_SPINNER));
+    page->addStream(F("CSS_LUXBAR"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_LUXBAR));
+    page->addToken(F("MENU_PRE"), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
+    page->addToken(F("MENU_POST"), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
+    page->addToken(F("CUR_SSID"), std::bind(&AutoConnect::_token_CURRENT_SSID, this, std::placeholders::_1));
  }
   else if (uri == String(AUTOCONNECT_URI_OPEN) && (_apConfig.menuItems & AC_MENUITEM_OPENSSIDS)) {
 
     // Setup /auto/open
-    elm->setMold(_PAGE_OPENCREDT);
-    elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_BASE")), std::bind(&AutoConnect::_token_CSS_BASE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_ICON_LOCK")), std::bind(&AutoConnect::_token_CSS_ICON_LOCK, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_INPUT_BUTTON")), std::bind(&AutoConnect::_token_CSS_INPUT_BUTTON, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_LUXBAR")), std::bind(&AutoConnect::_token_CSS_LUXBAR, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_PRE")), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_AUX")), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_POST")), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("OPEN_SSID")), std::bind(&AutoConnect::_token_OPEN_SSID, this, std::placeholders::_1));
+    page->setMold(_PAGE_OPENCREDT);
+    page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
+    page->addStream(F("CSS_BASE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_BASE));
+    page->addStream(F("CSS_ICON_LOCK"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_ICON_LOCK));
+    page->addStream(F("CSS_INPUT_BUTTON"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_INPUT_BUTTON));
+    page->addStream(F("CSS_LUXBAR"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_LUXBAR));
+    page->addToken(F("MENU_PRE"), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
+    page->addToken(F("MENU_AUX"), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
+    page->addToken(F("MENU_POST"), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
+    page->addToken(F("OPEN_SSID"), std::bind(&AutoConnect::_token_OPEN_SSID, this, std::placeholders::_1));
   }
   else if (uri == String(AUTOCONNECT_URI_DISCON) && (_apConfig.menuItems & AC_MENUITEM_DISCONNECT)) {
 
     // Setup /auto/disc
     _menuTitle = FPSTR(AUTOCONNECT_MENUTEXT_DISCONNECT);
-    elm->setMold(_PAGE_DISCONN);
-    elm->addToken(String(FPSTR("DISCONNECT")), std::bind(&AutoConnect::_induceDisconnect, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_BASE")), std::bind(&AutoConnect::_token_CSS_BASE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_LUXBAR")), std::bind(&AutoConnect::_token_CSS_LUXBAR, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_PRE")), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_POST")), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
+    page->setMold(_PAGE_DISCONN);
+    page->addToken(F("DISCONNECT"), std::bind(&AutoConnect::_induceDisconnect, this, std::placeholders::_1));
+    page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
+    page->addStream(F("CSS_BASE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_BASE));
+    page->addStream(F("CSS_LUXBAR"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_LUXBAR));
+    page->addToken(F("MENU_PRE"), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
+    page->addToken(F("MENU_POST"), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
   }
   else if (uri == String(AUTOCONNECT_URI_RESET) && (_apConfig.menuItems & AC_MENUITEM_RESET)) {
 
     // Setup /auto/reset
-    elm->setMold(_PAGE_RESETTING);
-    elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("BOOTURI")), std::bind(&AutoConnect::_token_BOOTURI, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("UPTIME")), std::bind(&AutoConnect::_token_UPTIME, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("RESET")), std::bind(&AutoConnect::_induceReset, this, std::placeholders::_1));
+    page->setMold(_PAGE_RESETTING);
+    page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
+    page->addToken(F("BOOTURI"), std::bind(&AutoConnect::_token_BOOTURI, this, std::placeholders::_1));
+    page->addToken(F("UPTIME"), std::bind(&AutoConnect::_token_UPTIME, this, std::placeholders::_1));
+    page->addToken(F("RESET"), std::bind(&AutoConnect::_induceReset, this, std::placeholders::_1));
   }
   else if (uri == String(AUTOCONNECT_URI_RESULT)) {
 
     // Setup /auto/result
-    elm->setMold("{{RESULT}}");
-    elm->addToken(String(FPSTR("RESULT")), std::bind(&AutoConnect::_invokeResult, this, std::placeholders::_1));
+    page->setMold(PSTR("{{RESULT}}"));
+    // The result page responds with the redirection by itself.
+    page->streamable = false;
+    page->addToken(F("RESULT"), std::bind(&AutoConnect::_invokeResult, this, std::placeholders::_1));
   }
   else if (uri == String(AUTOCONNECT_URI_SUCCESS)) {
 
     // Setup /auto/success
-    elm->setMold(_PAGE_SUCCESS);
-    elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_BASE")), std::bind(&AutoConnect::_token_CSS_BASE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_TABLE")), std::bind(&AutoConnect::_token_CSS_TABLE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_LUXBAR")), std::bind(&AutoConnect::_token_CSS_LUXBAR, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_PRE")), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_AUX")), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_POST")), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("ESTAB_SSID")), std::bind(&AutoConnect::_token_ESTAB_SSID, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("WIFI_MODE")), std::bind(&AutoConnect::_token_WIFI_MODE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("WIFI_STATUS")), std::bind(&AutoConnect::_token_WIFI_STATUS, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("LOCAL_IP")), std::bind(&AutoConnect::_token_LOCAL_IP, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("GATEWAY")), std::bind(&AutoConnect::_token_GATEWAY, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("NETMASK")), std::bind(&AutoConnect::_token_NETMASK, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CHANNEL")), std::bind(&AutoConnect::_token_CHANNEL, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("DBM")), std::bind(&AutoConnect::_token_DBM, this, std::placeholders::_1));
+    page->setMold(_PAGE_SUCCESS);
+    page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
+    page->addStream(F("CSS_BASE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_BASE));
+    page->addStream(F("CSS_TABLE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_TABLE));
+    page->addStream(F("CSS_LUXBAR"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_LUXBAR));
+    page->addToken(F("MENU_PRE"), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
+    page->addToken(F("MENU_AUX"), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
+    page->addToken(F("MENU_POST"), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
+    page->addToken(F("ESTAB_SSID"), std::bind(&AutoConnect::_token_ESTAB_SSID, this, std::placeholders::_1));
+    page->addToken(F("WIFI_MODE"), std::bind(&AutoConnect::_token_WIFI_MODE, this, std::placeholders::_1));
+    page->addToken(F("WIFI_STATUS"), std::bind(&AutoConnect::_token_WIFI_STATUS, this, std::placeholders::_1));
+    page->addToken(F("LOCAL_IP"), std::bind(&AutoConnect::_token_LOCAL_IP, this, std::placeholders::_1));
+    page->addToken(F("GATEWAY"), std::bind(&AutoConnect::_token_GATEWAY, this, std::placeholders::_1));
+    page->addToken(F("NETMASK"), std::bind(&AutoConnect::_token_NETMASK, this, std::placeholders::_1));
+    page->addToken(F("CHANNEL"), std::bind(&AutoConnect::_token_CHANNEL, this, std::placeholders::_1));
+    page->addToken(F("DBM"), std::bind(&AutoConnect::_token_DBM, this, std::placeholders::_1));
   }
   else if (uri == String(AUTOCONNECT_URI_FAIL)) {
 
     // Setup /auto/fail
     _menuTitle = FPSTR(AUTOCONNECT_MENUTEXT_FAILED);
-    elm->setMold(_PAGE_FAIL);
-    elm->addToken(String(FPSTR("HEAD")), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_BASE")), std::bind(&AutoConnect::_token_CSS_BASE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_TABLE")), std::bind(&AutoConnect::_token_CSS_TABLE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("CSS_LUXBAR")), std::bind(&AutoConnect::_token_CSS_LUXBAR, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_PRE")), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_AUX")), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("MENU_POST")), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
-    elm->addToken(String(FPSTR("STATION_STATUS")), std::bind(&AutoConnect::_token_STATION_STATUS, this, std::placeholders::_1));
+    page->setMold(_PAGE_FAIL);
+    page->addToken(F("HEAD"), std::bind(&AutoConnect::_token_HEAD, this, std::placeholders::_1));
+    page->addStream(F("CSS_BASE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_BASE));
+    page->addStream(F("CSS_TABLE"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_TABLE));
+    page->addStream(F("CSS_LUXBAR"), std::bind(&AutoConnect::_emitCSS, this, std::placeholders::_1, _CSS_LUXBAR));
+    page->addToken(F("MENU_PRE"), std::bind(&AutoConnect::_token_MENU_PRE, this, std::placeholders::_1));
+    page->addToken(F("MENU_AUX"), std::bind(&AutoConnect::_token_MENU_AUX, this, std::placeholders::_1));
+    page->addToken(F("MENU_POST"), std::bind(&AutoConnect::_token_MENU_POST, this, std::placeholders::_1));
+    page->addToken(F("STATION_STATUS"), std::bind(&AutoConnect::_token_STATION_STATUS, this, std::placeholders::_1));
   }
   else {
-    delete elm;
-    elm = nullptr;
+    delete page;
+    return nullptr;
   }
 
   // Restore the page transfer mode and the content build buffer
   // reserved size corresponding to each URI defined in structure
   // _pageBuildMode.
-  if (elm) {
-    for (uint8_t n = 0; n < sizeof(_pageBuildMode) / sizeof(PageTranserModeST); n++)
-      if (!strcmp(_pageBuildMode[n].uri, uri.c_str())) {
-        _responsePage->reserve(_pageBuildMode[n].rSize);
-        _responsePage->chunked(_pageBuildMode[n].transMode);
-        break;
-      }
-  }
+  for (uint8_t n = 0; n < sizeof(_pageBuildMode) / sizeof(PageTranserModeST); n++)
+    if (!strcmp(_pageBuildMode[n].uri, uri.c_str())) {
+      _reserve(_pageBuildMode[n].rSize);
+      _chunked(_pageBuildMode[n].transMode);
+      break;
+    }
 
-  return elm;
+  return _deployPage(page);
 }
@@ -0,0 +1,163 @@
+/**
+ *  AutoConnectScan class implementation.
+ *  Provides the snapshot of the WiFi scan results that is shared with
+ *  the consumers within the max age.
+ *  @file   AutoConnectScan.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-02
+ *  @copyright  MIT license.
+ */
+
+#include <algorithm>
+#include "AutoConnectScan.h"
+#if defined(ARDUINO_ARCH_ESP32)
+#define ENC_TYPE_NONE WIFI_AUTH_OPEN
+#endif
+
+/**
+ *  Returns the elapsed time since the snapshot was taken.
+ *  @return Elapsed time [ms]. If no snapshot has been taken, returns
+ *  the maximum value.
+ */
+unsigned long AutoConnectScan::age(void) const {
+  return _stamp ? millis() - _stamp : ~0UL;
+}
+
+/**
+ *  Discard the snapshot. The background scan in progress will be
+ *  abandoned.
+ */
+void AutoConnectScan::clear(void) {
+  if (_scanning) {
+    WiFi.scanDelete();
+    _scanning = false;
+  }
+  _ap.clear();
+  _ap.shrink_to_fit();
+  _stamp = 0;
+}
+
+/**
+ *  Find the AP of the specified BSSID from the snapshot.
+ *  @param  bssid  BSSID to find.
+ *  @return An index of the snapshot, -1 if not found.
+ */
+int16_t AutoConnectScan::find(const uint8_t* bssid) const {
+  for (size_t n = 0; n < _ap.size(); n++)
+    if (!memcmp(_ap[n].bssid, bssid, sizeof(AutoConnectScanST::bssid)))
+      return static_cast<int16_t>(n);
+  return -1;
+}
+
+/**
+ *  Find the AP of the specified SSID from the snapshot. Since the
+ *  snapshot is sorted by RSSI, the strongest AP is found for the SSID
+ *  that has multiple APs.
+ *  @param  ssid  SSID to find.
+ *  @return An index of the snapshot, -1 if not found.
+ */
+int16_t AutoConnectScan::find(const char* ssid) const {
+  for (size_t n = 0; n < _ap.size(); n++)
+    if (!strncmp(_ap[n].ssid, ssid, sizeof(AutoConnectScanST::ssid) - sizeof('\0')))
+      return static_cast<int16_t>(n);
+  return -1;
+}
+
+/**
+ *  Start the scan in the background. The result will be taken in by
+ *  update.
+ *  @return true  The scan has started or is already in progress.
+ */
+bool AutoConnectScan::refresh(void) {
+  if (!_scanning) {
+    WiFi.scanDelete();
+    _begin = millis();
+    _scanning = WiFi.scanNetworks(true, true) == WIFI_SCAN_RUNNING;
+    AC_DBG("Background scan %s\n", _scanning ? "started" : "failed");
+  }
+  return _scanning;
+}
+
+/**
+ *  Make the snapshot available that is within the max age. If the
+ *  current snapshot has expired, it waits for the completion of the
+ *  background scan in progress or scans synchronously.
+ *  @param  maxAge  The max age of the snapshot [ms]. 0 always scans.
+ *  @return true  The current snapshot was served as the cache.
+ *  @return false A new snapshot was taken.
+ */
+bool AutoConnectScan::snapshot(const unsigned long maxAge) {
+  update();
+  if (maxAge && age() <= maxAge)
+    return true;
+
+  int16_t nn;
+  if (_scanning) {
+    // Join to the background scan in progress.
+    unsigned long tm = millis();
+    while ((nn = WiFi.scanComplete()) == WIFI_SCAN_RUNNING) {
+      if (millis() - tm > AUTOCONNECT_SCAN_TIMEOUT)
+        break;
+      delay(10);
+    }
+  }
+  else {
+    WiFi.scanDelete();
+    _begin = millis();
+    nn = WiFi.scanNetworks(false, true);
+  }
+  _collect(nn);
+  return false;
+}
+
+/**
+ *  Take in the result of the background scan if it has completed.
+ *  @return true  The snapshot has been renewed.
+ */
+bool AutoConnectScan::update(void) {
+  if (_scanning) {
+    int16_t nn = WiFi.scanComplete();
+    if (nn != WIFI_SCAN_RUNNING) {
+      _collect(nn);
+      return nn >= 0;
+    }
+  }
+  return false;
+}
+
+/**
+ *  Copy the scan results in WiFiScan into the snapshot and release
+ *  them. The snapshot is sorted by RSSI in descending order.
+ *  @param  nn  Number of the found APs, a negative value is failure.
+ */
+void AutoConnectScan::_collect(const int16_t nn) {
+  _scanning = false;
+  _duration = millis() - _begin;
+  if (nn < 0) {
+    AC_DBG("Scan failed(%d)\n", (int)nn);
+    WiFi.scanDelete();
+    return;
+  }
+
+  _ap.clear();
+  _ap.reserve(nn);
+  for (int16_t n = 0; n < nn; n++) {
+    AutoConnectScanST ap;
+    *ap.ssid = '\0';
+    strncat(ap.ssid, WiFi.SSID(n).c_str(), sizeof(ap.ssid) - sizeof('\0'));
+    memcpy(ap.bssid, WiFi.BSSID(n), sizeof(ap.bssid));
+    ap.rssi = static_cast<int8_t>(WiFi.RSSI(n));
+    ap.channel = static_cast<uint8_t>(WiFi.channel(n));
+    ap.encrypted = WiFi.encryptionType(n) != ENC_TYPE_NONE;
+    _ap.push_back(ap);
+  }
+  WiFi.scanDelete();
+  std::stable_sort(_ap.begin(), _ap.end(), [](const AutoConnectScanST& a, const AutoConnectScanST& b) {
+    return a.rssi > b.rssi;
+  });
+  // 0 is reserved to indicate that no snapshot has been taken.
+  if (!(_stamp = millis()))
+    _stamp = 1;
+  AC_DBG("%d network(s) found\n", (int)nn);
+}
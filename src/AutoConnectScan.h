@@ -0,0 +1,64 @@
+/**
+ *  Declaration of AutoConnectScan class.
+ *  @file   AutoConnectScan.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-05-02
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTSCAN_H_
+#define _AUTOCONNECTSCAN_H_
+
+#include <vector>
+#if defined(ARDUINO_ARCH_ESP8266)
+#include <ESP8266WiFi.h>
+#elif defined(ARDUINO_ARCH_ESP32)
+#include <WiFi.h>
+#endif
+#include "AutoConnectDefs.h"
+
+/**
+ *  Holds the snapshot of the WiFi scan results shared with the portal
+ *  pages and the credential selection. The results are kept in a
+ *  compact array sorted by RSSI in descending order with the time it
+ *  was taken, and the WiFiScan results are released as soon as they
+ *  are copied. The scan can run asynchronously in the background
+ *  while the portal serves the page from the current snapshot.
+ */
+class AutoConnectScan {
+ public:
+  /** A compact entry of the scan result */
+  typedef struct {
+    char      ssid[32 + sizeof('\0')];  /**< SSID, an empty string for hidden */
+    uint8_t   bssid[6];                 /**< BSSID */
+    int8_t    rssi;                     /**< RSSI [dBm] */
+    uint8_t   channel;                  /**< Channel */
+    bool      encrypted;                /**< The AP requires the authentication */
+  } AutoConnectScanST;
+
+  AutoConnectScan() : _scanning(false), _stamp(0), _begin(0), _duration(0) {}
+  ~AutoConnectScan() {}
+  const AutoConnectScanST&  operator[](const size_t n) const { return _ap[n]; }
+  unsigned long age(void) const;                /**< Elapsed time since the snapshot taken [ms] */
+  void    clear(void);                          /**< Discard the snapshot */
+  int16_t count(void) const { return static_cast<int16_t>(_ap.size()); }  /**< Number of the found APs */
+  unsigned long duration(void) const { return _duration; }  /**< Time taken for the last scan [ms] */
+  int16_t find(const uint8_t* bssid) const;     /**< Find the AP by BSSID */
+  int16_t find(const char* ssid) const;         /**< Find the AP by SSID */
+  bool    isScanning(void) const { return _scanning; }  /**< The background scan is in progress */
+  bool    refresh(void);                        /**< Start the background scan */
+  bool    snapshot(const unsigned long maxAge); /**< Ensure the snapshot within the max age */
+  bool    update(void);                         /**< Take in the result of the background scan */
+
+ protected:
+  void    _collect(const int16_t nn);           /**< Copy the scan results into the snapshot */
+
+  std::vector<AutoConnectScanST>  _ap;          /**< Snapshot of the scan results */
+  bool          _scanning;                      /**< The background scan is in progress */
+  unsigned long _stamp;                         /**< millis when the snapshot taken, 0 is not yet */
+  unsigned long _begin;                         /**< millis when the scan started */
+  unsigned long _duration;                      /**< Time taken for the last scan [ms] */
+};
+
+#endif // !_AUTOCONNECTSCAN_H_
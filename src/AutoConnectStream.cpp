@@ -0,0 +1,219 @@
+/**
+ *  Implementation of the streaming renderer for AutoConnect pages.
+ *  @file   AutoConnectStream.cpp
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-04-25
+ *  @copyright  MIT license.
+ */
+
+#include "AutoConnect.h"
+#include "AutoConnectStream.h"
+
+// Maximum length of the token name in the mold
+#define AC_STREAM_TOKENLEN  32
+
+/**
+ *  Allocate the chunk buffer. If the allocation fails, the sink sends
+ *  the written content as the chunk at each time.
+ */
+AutoConnectSink::AutoConnectSink(WebServerClass& server, const size_t size)
+: _server(server), _size(size), _length(0), _amount(0) {
+  _buffer = static_cast<char*>(AutoConnectMemory::allocate(_size, AC_PSRAM_STREAM));
+  if (!_buffer) {
+    AC_DBG("Sink buffer(%d) allocation failed\n", (int)_size);
+    _size = 0;
+  }
+}
+
+/**
+ *  Release the chunk buffer. The remaining content has not been sent
+ *  yet will be discarded.
+ */
+AutoConnectSink::~AutoConnectSink() {
+  if (_buffer)
+    AutoConnectMemory::release(_buffer);
+}
+
+size_t AutoConnectSink::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+/**
+ *  Accumulate the content into the chunk buffer. Each time the buffer
+ *  fills, it is sent as a chunk.
+ *  @param  buffer  Content to write.
+ *  @param  size    Size of the content.
+ *  @return Written size.
+ */
+size_t AutoConnectSink::write(const uint8_t* buffer, size_t size) {
+  if (!_buffer) {
+    // Without the chunk buffer, it sends the content as is.
+    _server.sendContent_P(reinterpret_cast<PGM_P>(buffer), size);
+    _amount += size;
+    return size;
+  }
+
+  size_t  remain = size;
+  while (remain) {
+    size_t  len = _size - _length;
+    if (len > remain)
+      len = remain;
+    memcpy(_buffer + _length, buffer, len);
+    _length += len;
+    buffer += len;
+    remain -= len;
+    if (_length >= _size)
+      _send();
+  }
+  return size;
+}
+
+/**
+ *  Send the remaining content and terminate the chunked transfer.
+ */
+void AutoConnectSink::end(void) {
+  _send();
+  _server.sendContent(String(""));
+}
+
+void AutoConnectSink::_send(void) {
+  // A zero length chunk indicates the end of the transfer, it must
+  // not be sent in the middle of the content.
+  if (_length) {
+    _server.sendContent_P(_buffer, _length);
+    _amount += _length;
+    _length = 0;
+  }
+}
+
+/**
+ *  Accumulate the content into the String.
+ *  @param  buffer  Content to write.
+ *  @param  size    Size of the content.
+ *  @return Written size.
+ */
+size_t AutoConnectStringSink::write(const uint8_t* buffer, size_t size) {
+  _content.reserve(_content.length() + size);
+  for (size_t n = 0; n < size; n++)
+    _content += static_cast<char>(buffer[n]);
+  return size;
+}
+
+/**
+ *  Register the token handler that returns the String as same as the
+ *  token handler of PageBuilder.
+ *  @param  token   A name of the token stored in PROGMEM.
+ *  @param  handler A token handler.
+ */
+void AutoConnectPageStream::addToken(const __FlashStringHelper* token, HandleFuncT handler) {
+  _token.push_back({ reinterpret_cast<PGM_P>(token), handler, nullptr });
+}
+
+/**
+ *  Register the token handler that writes the content into the sink.
+ *  @param  token   A name of the token stored in PROGMEM.
+ *  @param  handler A token handler.
+ */
+void AutoConnectPageStream::addStream(const __FlashStringHelper* token, TokenSinkFuncT handler) {
+  _token.push_back({ reinterpret_cast<PGM_P>(token), nullptr, handler });
+}
+
+/**
+ *  Deploy the mold and the token handlers to the PageElement for
+ *  building the page by PageBuilder as usual. The token handler that
+ *  writes into the sink is wrapped to return the String.
+ *  @param  element  A reference of PageElement to deploy.
+ */
+void AutoConnectPageStream::deploy(PageElement& element) {
+  element.setMold(_mold);
+  for (TokenST& t : _token) {
+    if (t.builder)
+      element.addToken(String(FPSTR(t.token)), t.builder);
+    else {
+      TokenSinkFuncT  sink = t.sink;
+      element.addToken(String(FPSTR(t.token)), [sink](PageArgument& args) {
+        String  content;
+        AutoConnectStringSink out(content);
+        sink(out, args);
+        return content;
+      });
+    }
+  }
+}
+
+/**
+ *  Render the page into the sink. It walks the mold and writes the
+ *  literal segment to the sink directly, and invokes the token handler
+ *  for each token.
+ *  @param  out   A sink to write the page.
+ *  @param  args  A reference of PageArgument of the current request.
+ */
+void AutoConnectPageStream::render(Print& out, PageArgument& args) {
+  char    literal[64];
+  size_t  len = 0;
+  PGM_P   mp = _mold;
+  char    c;
+
+  if (!mp)
+    return;
+
+  while ((c = static_cast<char>(pgm_read_byte(mp))) != '\0') {
+    if (c == '{' && static_cast<char>(pgm_read_byte(mp + 1)) == '{') {
+      // Extract the token name
+      char    token[AC_STREAM_TOKENLEN];
+      uint8_t tl = 0;
+      PGM_P   tp = mp + 2;
+      char    tc = '\0';
+      while (tl < sizeof(token) - 1) {
+        tc = static_cast<char>(pgm_read_byte(tp));
+        if (tc == '\0' || tc == '}')
+          break;
+        token[tl++] = tc;
+        tp++;
+      }
+      token[tl] = '\0';
+      // An unregistered or unterminated token passes through as it is.
+      if (tc == '}' && static_cast<char>(pgm_read_byte(tp + 1)) == '}') {
+        // Flush the literal segment before the token content.
+        if (len) {
+          out.write(reinterpret_cast<const uint8_t*>(literal), len);
+          len = 0;
+        }
+        if (_emit(out, token, args)) {
+          mp = tp + 2;
+          continue;
+        }
+      }
+    }
+    literal[len++] = c;
+    if (len >= sizeof(literal)) {
+      out.write(reinterpret_cast<const uint8_t*>(literal), len);
+      len = 0;
+    }
+    mp++;
+  }
+  if (len)
+    out.write(reinterpret_cast<const uint8_t*>(literal), len);
+}
+
+/**
+ *  Invoke the token handler which has the specified name.
+ *  @param  out   A sink to write the content.
+ *  @param  token A name of the token.
+ *  @param  args  A reference of PageArgument of the current request.
+ *  @return true  The token handler was invoked.
+ *  @return false The token is not registered.
+ */
+bool AutoConnectPageStream::_emit(Print& out, const char* token, PageArgument& args) {
+  for (TokenST& t : _token) {
+    if (!strcmp_P(token, t.token)) {
+      if (t.sink)
+        t.sink(out, args);
+      else if (t.builder)
+        out.print(t.builder(args));
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,109 @@
+/**
+ *  Declaration of the streaming renderer for AutoConnect pages.
+ *  @file   AutoConnectStream.h
+ *  @author hieromon@gmail.com
+ *  @version    1.1.7
+ *  @date   2020-04-25
+ *  @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTSTREAM_H_
+#define _AUTOCONNECTSTREAM_H_
+
+#include <vector>
+#include <functional>
+#include <Print.h>
+#include <PageBuilder.h>
+#include "AutoConnectDefs.h"
+#include "AutoConnectMemory.h"
+
+// A type of the token handler that writes the content into the sink
+// instead of returning the String.
+typedef std::function<void(Print&, PageArgument&)>  TokenSinkFuncT;
+
+// A type of the function which is called ahead of the rendering.
+// The rendering will be canceled if it returns false.
+typedef std::function<bool(PageArgument&)>  PrologueFuncT;
+
+/**
+ *  A sink that sends the page content to the http client currently
+ *  connected with the chunked transfer. The content written to the
+ *  sink is accumulated into a fixed-size buffer, and it will be sent
+ *  as a chunk whenever the buffer fills up.
+ *  @param  server  A reference of the WebServerClass which is in the
+ *  http response.
+ *  @param  size    Size of a chunk.
+ */
+class AutoConnectSink : public Print {
+ public:
+  explicit AutoConnectSink(WebServerClass& server, const size_t size = AUTOCONNECT_STREAM_CHUNKSIZE);
+  ~AutoConnectSink();
+  size_t  write(uint8_t c) override;
+  size_t  write(const uint8_t* buffer, size_t size) override;
+  void    end(void);                                /**< Send the remaining content and the last chunk */
+  size_t  amount(void) const { return _amount; }    /**< Total amount of sent content */
+
+ protected:
+  void    _send(void);                              /**< Send the accumulated content as a chunk */
+  WebServerClass& _server;  /**< WebServer to respond */
+  char*   _buffer;          /**< Chunk buffer */
+  size_t  _size;            /**< Size of the chunk buffer */
+  size_t  _length;          /**< Length of accumulated content */
+  size_t  _amount;          /**< Total amount of sent content */
+};
+
+/**
+ *  A sink that accumulates the content into the String. It is used to
+ *  obtain the content of the token handler on the sink as the String
+ *  that is required by the PageBuilder token handler.
+ *  @param  content A reference of the String to accumulate.
+ */
+class AutoConnectStringSink : public Print {
+ public:
+  explicit AutoConnectStringSink(String& content) : _content(content) {}
+  ~AutoConnectStringSink() {}
+  size_t  write(uint8_t c) override { _content += static_cast<char>(c); return 1; }
+  size_t  write(const uint8_t* buffer, size_t size) override;
+
+ protected:
+  String& _content;         /**< Accumulation of the content */
+};
+
+/**
+ *  Holds the mold and its token handlers of a page, and renders the
+ *  page into the sink. Literal segments of the mold are written into
+ *  the sink straight from the flash, and the token handler registered
+ *  with addStream writes its content into the sink directly.
+ *  The token handler that returns the String as same as the
+ *  PageBuilder is also available with addToken.
+ *  @param  mold  A mold of the page which can be stored in PROGMEM.
+ */
+class AutoConnectPageStream {
+ public:
+  explicit AutoConnectPageStream(PGM_P mold = nullptr) : streamable(true), _mold(mold), _prologue(nullptr) {}
+  ~AutoConnectPageStream() { _token.clear(); }
+  void  setMold(PGM_P mold) { _mold = mold; }                                     /**< Set the mold of the page */
+  void  addToken(const __FlashStringHelper* token, HandleFuncT handler);          /**< Register the token handler that returns String */
+  void  addStream(const __FlashStringHelper* token, TokenSinkFuncT handler);      /**< Register the token handler that writes into the sink */
+  void  onPrologue(PrologueFuncT prologue) { _prologue = prologue; }             /**< Register the function called ahead of the rendering */
+  bool  prologue(PageArgument& args) { return _prologue ? _prologue(args) : true; }
+  void  deploy(PageElement& element);                                             /**< Deploy the mold and tokens to the PageElement */
+  void  render(Print& out, PageArgument& args);                                   /**< Render the page into the sink */
+
+  bool  streamable;         /**< The page can be rendered into the sink */
+
+ protected:
+  typedef struct {
+    PGM_P           token;    /**< Token name stored in PROGMEM */
+    HandleFuncT     builder;  /**< Token handler returns String */
+    TokenSinkFuncT  sink;     /**< Token handler writes into the sink */
+  } TokenST;
+
+  bool  _emit(Print& out, const char* token, PageArgument& args);                /**< Invoke the token handler */
+
+  PGM_P _mold;              /**< A mold of the page */
+  std::vector<TokenST>  _token; /**< Registered token handlers */
+  PrologueFuncT _prologue;  /**< A function called ahead of the rendering */
+};
+
+#endif // !_AUTOCONNECTSTREAM_H_
@@ -0,0 +1,159 @@
+/**
+ * Declaration of AutoConnectString class.
+ * @file   AutoConnectString.h
+ * @author hieromon@gmail.com
+ * @version    1.1.7
+ * @date   2020-05-10
+ * @copyright  MIT license.
+ */
+
+#ifndef _AUTOCONNECTSTRING_H_
+#define _AUTOCONNECTSTRING_H_
+
+#include <Arduino.h>
+
+/**
+ * A copy-on-write string for the attributes of AutoConnectElements.
+ * It refers to the string in PROGMEM given as __FlashStringHelper
+ * without allocating the heap until it is written, and turns into
+ * String at the first write. It provides the String API which sketches
+ * use for the element attributes; the read accessors work on the
+ * PROGMEM string as it is or on a transient copy, and only the
+ * modifiers and str() move the string to RAM for good. c_str() also
+ * needs the copy with ESP8266 whose flash is not readable by byte.
+ * The string given as const char* or String is always copied, since
+ * its lifetime is not known.
+ */
+class AutoConnectString {
+ public:
+  AutoConnectString() : _flash(nullptr) {}
+  AutoConnectString(const char* s) : _flash(nullptr), _str(s) {}
+  AutoConnectString(const String& s) : _flash(nullptr), _str(s) {}
+  AutoConnectString(const __FlashStringHelper* s) : _flash(s) {}
+  ~AutoConnectString() {}
+  AutoConnectString& operator=(const char* s) { _flash = nullptr; _str = s; return *this; }
+  AutoConnectString& operator=(const String& s) { _flash = nullptr; _str = s; return *this; }
+  AutoConnectString& operator=(const __FlashStringHelper* s) { _flash = s; _str = String(); return *this; }
+  template<typename T>
+  AutoConnectString& operator+=(const T& s) { _write() += s; return *this; }
+  template<typename T>
+  StringSumHelper operator+(const T& s) const { StringSumHelper sum(toString()); sum += s; return sum; }
+  operator String() const { return toString(); }  /**< A transient copy, the PROGMEM string stays */
+  char  operator[](const unsigned int index) const { return charAt(index); }
+  bool  operator==(const String& s) const { return equals(s); }
+  bool  operator==(const char* s) const { return equals(s); }
+  bool  operator!=(const String& s) const { return !equals(s); }
+  bool  operator!=(const char* s) const { return !equals(s); }
+
+  /**
+   * Returns the string as C string. It refers to the PROGMEM string
+   * directly with ESP32 whose flash is readable by byte, and it needs
+   * the copy to RAM with ESP8266.
+   * @return A pointer to C string.
+   */
+  const char* c_str(void) const {
+#if defined(ARDUINO_ARCH_ESP32)
+    if (_flash)
+      return reinterpret_cast<const char*>(_flash);
+#endif
+    return _read().c_str();
+  }
+
+  char  charAt(const unsigned int index) const {
+    if (_flash)
+      return index < length() ? static_cast<char>(pgm_read_byte(reinterpret_cast<PGM_P>(_flash) + index)) : '\0';
+    return _str.charAt(index);
+  }
+
+  bool  equals(const String& s) const { return _flash ? !strcmp_P(s.c_str(), reinterpret_cast<PGM_P>(_flash)) : _str.equals(s); }
+  bool  equals(const char* s) const { return _flash ? !strcmp_P(s, reinterpret_cast<PGM_P>(_flash)) : _str.equals(s); }
+
+  /**
+   * Compares the string ignoring the case without copying the PROGMEM
+   * string to RAM.
+   * @param  s  A string to be compared.
+   * @return true  The strings are equal.
+   */
+  bool  equalsIgnoreCase(const String& s) const {
+    if (!_flash)
+      return _str.equalsIgnoreCase(s);
+    PGM_P p = reinterpret_cast<PGM_P>(_flash);
+    for (unsigned int n = 0; ; n++) {
+      char  c = static_cast<char>(pgm_read_byte(p + n));
+      if (tolower(c) != tolower(s[n]))
+        return false;
+      if (!c)
+        return n == s.length();
+    }
+  }
+
+  bool  isFlash(void) const { return _flash != nullptr; }  /**< The string refers to PROGMEM */
+  unsigned int  length(void) const { return _flash ? strlen_P(reinterpret_cast<PGM_P>(_flash)) : _str.length(); }
+  size_t  printTo(Print& p) const { return _flash ? p.print(_flash) : p.print(_str); }  /**< Writes the string without copying */
+
+  /**
+   * Returns the string in RAM as the mutable String. The PROGMEM string
+   * is copied to RAM at this point, and the reference stays valid as
+   * long as the AutoConnectString lives and is not re-assigned.
+   * @return A reference of the string in RAM.
+   */
+  String& str(void) { return _write(); }
+  String  toString(void) const { return _flash ? String(_flash) : _str; }  /**< Returns a copy as String */
+
+  // The String read accessors. They work on a transient copy with the
+  // PROGMEM string and leave it in flash.
+  int   compareTo(const String& s) const { return _flash ? String(_flash).compareTo(s) : _str.compareTo(s); }
+  bool  endsWith(const String& s) const { return _flash ? String(_flash).endsWith(s) : _str.endsWith(s); }
+  void  getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index = 0) const { _flash ? String(_flash).getBytes(buf, bufsize, index) : _str.getBytes(buf, bufsize, index); }
+  int   indexOf(char ch, unsigned int fromIndex = 0) const { return _flash ? String(_flash).indexOf(ch, fromIndex) : _str.indexOf(ch, fromIndex); }
+  int   indexOf(const String& s, unsigned int fromIndex = 0) const { return _flash ? String(_flash).indexOf(s, fromIndex) : _str.indexOf(s, fromIndex); }
+  bool  isEmpty(void) const { return _flash ? !pgm_read_byte(reinterpret_cast<PGM_P>(_flash)) : !_str.length(); }
+  int   lastIndexOf(char ch) const { return _flash ? String(_flash).lastIndexOf(ch) : _str.lastIndexOf(ch); }
+  int   lastIndexOf(const String& s) const { return _flash ? String(_flash).lastIndexOf(s) : _str.lastIndexOf(s); }
+  bool  startsWith(const String& s) const { return _flash ? String(_flash).startsWith(s) : _str.startsWith(s); }
+  String  substring(unsigned int beginIndex) const { return _flash ? String(_flash).substring(beginIndex) : _str.substring(beginIndex); }
+  String  substring(unsigned int beginIndex, unsigned int endIndex) const { return _flash ? String(_flash).substring(beginIndex, endIndex) : _str.substring(beginIndex, endIndex); }
+  void  toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const { getBytes(reinterpret_cast<unsigned char*>(buf), bufsize, index); }
+  float toFloat(void) const { return _flash ? String(_flash).toFloat() : _str.toFloat(); }
+  long  toInt(void) const { return _flash ? String(_flash).toInt() : _str.toInt(); }
+
+  // The String modifiers. They move the PROGMEM string to RAM.
+  template<typename T>
+  bool  concat(const T& s) { return _write().concat(s); }
+  void  remove(unsigned int index) { _write().remove(index); }
+  void  remove(unsigned int index, unsigned int count) { _write().remove(index, count); }
+  void  replace(char find, char replace) { _write().replace(find, replace); }
+  void  replace(const String& find, const String& replace) { _write().replace(find, replace); }
+  bool  reserve(unsigned int size) { return _write().reserve(size); }
+  void  setCharAt(unsigned int index, char c) { _write().setCharAt(index, c); }
+  void  toLowerCase(void) { _write().toLowerCase(); }
+  void  toUpperCase(void) { _write().toUpperCase(); }
+  void  trim(void) { _write().trim(); }
+
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, const AutoConnectString& rhs) {
+    return rhs._flash ? lhs + rhs._flash : lhs + rhs._str;
+  }
+
+ protected:
+  /**
+   * Copy the PROGMEM string to RAM for the read accessors that need it.
+   * @return A reference of the string in RAM.
+   */
+  const String& _read(void) const {
+    if (_flash) {
+      _str = String(_flash);
+      _flash = nullptr;
+    }
+    return _str;
+  }
+
+  String& _write(void) {
+    _read();
+    return _str;
+  }
+
+  mutable const __FlashStringHelper* _flash;  /**< The string in PROGMEM, nullptr for RAM */
+  mutable String  _str;                        /**< The string in RAM */
+};
+
+#endif // !_AUTOCONNECTSTRING_H_
@@ -28,10 +28,32 @@ void AutoConnectTicker::start(const uint32_t cycle, const uint32_t duty) {
  */
 void AutoConnectTicker::start(void) {
   pinMode(_port, OUTPUT);
+  _active = true;
   _pulse.detach();
+#ifdef AUTOCONNECT_USE_HWTICKER
+  // The peripheral cannot call back at every cycle.
+  if (!_callback) {
+    _period.detach();
+    if (_startHardware())
+      return;
+  }
+#endif // !AUTOCONNECT_USE_HWTICKER
   _period.attach_ms<AutoConnectTicker*>(_cycle, AutoConnectTicker::_onPeriod, this);
 }
 
+/**
+ * Stop ticker cycle and turn off the flicker signal
+ */
+void AutoConnectTicker::stop(void) {
+  _period.detach();
+  _pulse.detach();
+#ifdef AUTOCONNECT_USE_HWTICKER
+  _stopHardware();
+#endif // !AUTOCONNECT_USE_HWTICKER
+  digitalWrite(_port, !_turnOn);
+  _active = false;
+}
+
 /**
  * Turn on the flicker signal and reserves a ticker to turn off the
  * signal. This behavior will perform every cycle to generate the
@@ -54,3 +76,57 @@ void AutoConnectTicker::_onPeriod(AutoConnectTicker* t) {
 void AutoConnectTicker::_onPulse(AutoConnectTicker* t) {
   digitalWrite(t->_port, !(t->_turnOn));
 }
+
+#ifdef AUTOCONNECT_USE_HWTICKER
+/**
+ * Let the peripheral generate the flicker signal. ESP32 drives the
+ * port with the LEDC PWM, ESP8266 with the waveform generator of the
+ * core on the timer1. No software runs for each cycle after that.
+ * A signal without the pulse or without the pause is output as the
+ * steady level.
+ * @return true   The peripheral generates the signal.
+ * @return false  The ticker cycle cannot be generated by the peripheral.
+ */
+bool AutoConnectTicker::_startHardware(void) {
+  _stopHardware();
+  if (!_cycle)
+    return false;
+  if (_duty == 0 || _duty >= _cycle) {
+    digitalWrite(_port, _duty ? _turnOn : !_turnOn);
+    return true;
+  }
+
+#if defined(ARDUINO_ARCH_ESP8266)
+  const uint32_t  pulse = _duty * 1000;
+  const uint32_t  pause = (_cycle - _duty) * 1000;
+  if (startWaveform(_port, _turnOn ? pulse : pause, _turnOn ? pause : pulse, 0))
+    _hardware = true;
+
+#elif defined(ARDUINO_ARCH_ESP32)
+  const uint32_t  range = 1UL << AUTOCONNECT_TICKER_LEDC_RESOLUTION;
+  if (ledcSetup(AUTOCONNECT_TICKER_LEDC_CHANNEL, 1000.0 / _cycle, AUTOCONNECT_TICKER_LEDC_RESOLUTION) > 0) {
+    uint32_t  level = (uint32_t)(((uint64_t)_duty << AUTOCONNECT_TICKER_LEDC_RESOLUTION) / _cycle);
+    ledcAttachPin(_port, AUTOCONNECT_TICKER_LEDC_CHANNEL);
+    ledcWrite(AUTOCONNECT_TICKER_LEDC_CHANNEL, _turnOn ? level : range - level);
+    _hardware = true;
+  }
+#endif
+  return _hardware;
+}
+
+/**
+ * Release the port from the peripheral.
+ */
+void AutoConnectTicker::_stopHardware(void) {
+  if (!_hardware)
+    return;
+#if defined(ARDUINO_ARCH_ESP8266)
+  stopWaveform(_port);
+#elif defined(ARDUINO_ARCH_ESP32)
+  ledcWrite(AUTOCONNECT_TICKER_LEDC_CHANNEL, 0);
+  ledcDetachPin(_port);
+  pinMode(_port, OUTPUT);
+#endif
+  _hardware = false;
+}
+#endif // !AUTOCONNECT_USE_HWTICKER
@@ -18,10 +18,13 @@
 #endif
 #include <Ticker.h>
 #include "AutoConnectDefs.h"
+#if defined(ARDUINO_ARCH_ESP8266) && defined(AUTOCONNECT_USE_HWTICKER)
+#include <core_esp8266_waveform.h>
+#endif
 
 class AutoConnectTicker {
  public:
-	explicit AutoConnectTicker(const uint8_t port = AUTOCONNECT_TICKER_PORT, const uint8_t active = LOW, const uint32_t cycle = 0, uint32_t duty = 0) : _cycle(cycle), _duty(duty), _port(port), _turnOn(active), _callback(nullptr) {
+	explicit AutoConnectTicker(const uint8_t port = AUTOCONNECT_TICKER_PORT, const uint8_t active = LOW, const uint32_t cycle = 0, uint32_t duty = 0) : _cycle(cycle), _duty(duty), _port(port), _turnOn(active), _active(false), _hardware(false), _callback(nullptr) {
     if (_duty > _cycle)
       _duty = _cycle;
   }
@@ -33,7 +36,8 @@ class AutoConnectTicker {
   void start(const uint32_t cycle, const uint32_t duty);
   void start(const uint32_t cycle, const uint8_t width) { start(cycle, (uint32_t)((cycle * width) >> 8)); }
   void start(void);
-  void stop(void) { _period.detach(); _pulse.detach(); digitalWrite(_port, !_turnOn); }
+  void stop(void);
+  bool isActive(void) const { return _active; }  /**< The flicker signal is being output */
   void onPeriod(Callback_ft cb) { _callback = cb ;}
 
  protected:
@@ -45,8 +49,14 @@ class AutoConnectTicker {
  private:
   static void _onPeriod(AutoConnectTicker* t);
   static void _onPulse(AutoConnectTicker* t);
+#ifdef AUTOCONNECT_USE_HWTICKER
+  bool  _startHardware(void);
+  void  _stopHardware(void);
+#endif // !AUTOCONNECT_USE_HWTICKER
   uint8_t     _port;        /**< Port to output signal */
   uint8_t     _turnOn;      /**< Signal to turn on */
+  bool        _active;      /**< Started and not stopped */
+  bool        _hardware;    /**< The signal is generated by the peripheral */
   Callback_ft _callback;    /**< An exit by every cycle */
 };
 
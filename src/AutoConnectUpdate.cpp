@@ -15,7 +15,15 @@
 #include <type_traits>
 #include "AutoConnectUpdate.h"
 #include "AutoConnectUpdatePage.h"
-#include "AutoConnectJsonDefs.h"
+#include "AutoConnectCatalog.h"
+#if defined(ARDUINO_ARCH_ESP8266)
+#include <WiFiUdp.h>
+#include <Updater.h>
+#define AC_UPDATE_ARCH  "ESP8266"
+#elif defined(ARDUINO_ARCH_ESP32)
+#include <Update.h>
+#define AC_UPDATE_ARCH  "ESP32"
+#endif
 
 /**
  * The AutoConnectUpdateAct class inherits from the HTTPupdate class. The
@@ -63,11 +71,29 @@
  *   - path:
  *     A path parameter specifies the path on the server storing
  *     available sketch binaries.
+ *   - type, match:
+ *     Filter the entries of the list by the type and by the pattern of
+ *     the file name as the shell wildcard.
+ *   - offset, limit:
+ *     Respond the entries from the offset up to the limit number after
+ *     filtered. The AutoConnectUpdateAct class queries a page of
+ *     AUTOCONNECT_UPDATE_CATALOG_LIMIT entries. An update server that
+ *     ignores these parameters is also acceptable, the rest of the list
+ *     beyond a page is discarded.
  *
  * Access to the path on the server:
  *   It should have access to the bin file. The update server needs to
  *   send a bin file with a content type of application/octet-stream via
  *   HTTP and also needs to attach an MD5 hash value to the x-MD5 header.
+ *
+ * Compressed updater:
+ *   The bin type entry can be a gzip compressed sketch binary such as
+ *   update.bin.gz, and the catalog indicates it with the compression
+ *   key as "gzip". The ESP8266 Updater accepts the gzip image as it is.
+ *   On the ESP32, the file with the .gz suffix is inflated while being
+ *   downloaded and the x-MD5 header is the hash of the compressed file.
+ *   The update server can attach an uncompressed size to the
+ *   x-Inflated-Size header to allow the progress meter.
  */
 
 /**
@@ -101,6 +127,29 @@ typename std::enable_if<!AutoConnectUtil::has_func_onProgress<T>::value, AutoCon
   (void)(fn);
   return AutoConnectUpdateAct::UPDATEDIALOG_LOADER;
 }
+
+/**
+ * Percent-encode a string to be a parameter of the query string. The
+ * unreserved characters and the path separator remain as they are.
+ * @param  s  A string to be encoded.
+ * @return Encoded string.
+ */
+static String encodeQuery(const String& s) {
+  static const char hex[] PROGMEM = "0123456789ABCDEF";
+  String  encoded;
+  encoded.reserve(s.length());
+  for (unsigned int i = 0; i < s.length(); i++) {
+    const char  c = s[i];
+    if (isalnum(static_cast<unsigned char>(c)) || strchr("-_.~/", c))
+      encoded += c;
+    else {
+      encoded += '%';
+      encoded += static_cast<char>(pgm_read_byte(hex + ((c >> 4) & 0x0f)));
+      encoded += static_cast<char>(pgm_read_byte(hex + (c & 0x0f)));
+    }
+  }
+  return encoded;
+}
 }
 
 /**
@@ -117,6 +166,8 @@ typename std::enable_if<!AutoConnectUtil::has_func_onProgress<T>::value, AutoCon
  * as AutoConnectAux.
  */
 AutoConnectUpdateAct::~AutoConnectUpdateAct() {
+  if (_resume.offset)
+    _resetDownload(true);
   _auxCatalog.reset(nullptr);
   _auxProgress.reset(nullptr);
   _auxResult.reset(nullptr);
@@ -231,7 +282,8 @@ void AutoConnectUpdateAct::handleUpdate(void) {
       // Evaluate the processing status of AutoConnectUpdateAct and
       // execute it accordingly. It is only this process point that
       // requests update processing.
-      if (_status == UPDATE_START) {
+      // The suspended download resumes after the interval.
+      if (_status == UPDATE_START && (!_resume.offset || millis() - _resume.suspended >= AUTOCONNECT_UPDATE_RESUME_INTERVAL)) {
         _status = UPDATE_PROGRESS;
         update();
       }
@@ -248,21 +300,34 @@ void AutoConnectUpdateAct::handleUpdate(void) {
 }
 
 /**
- * Run the update function of HTTPUpdate that is the base class and
- * fetch the result.
+ * Download the updater and fetch the result. The download interrupted
+ * by the connection loss is suspended with the received offset and
+ * will be resumed by the next handleUpdate cycle.
  * @return  AC_UPDATESTATUS_t
  */
 AC_UPDATESTATUS_t AutoConnectUpdateAct::update(void) {
   // Start update
   String  uriBin = uri + '/' + _binName;
   if (_binName.length()) {
+    // The suspended download of the other updater is no longer valid.
+    if (_resume.offset && _resume.uri != uriBin)
+      _resetDownload(true);
     WiFiClient  wifiClient;
     AC_DBG("%s:%d/%s update in progress...", host.c_str(), port, uriBin.c_str());
-    t_httpUpdate_return ret = HTTPUpdateClass::update(wifiClient, host, port, uriBin);
+    t_httpUpdate_return ret = _download(wifiClient, uriBin);
     switch (ret) {
     case HTTP_UPDATE_FAILED:
-      _status = UPDATE_FAIL;
       AC_DBG_DUMB(" %s\n", getLastErrorString().c_str());
+      if (_resume.offset && _resume.resumed < AUTOCONNECT_UPDATE_RESUME) {
+        // Keep the Update session and try again from the offset.
+        _resume.resumed++;
+        _resume.suspended = millis();
+        _status = UPDATE_START;
+        AC_DBG("update suspended at %u/%u\n", (unsigned int)_resume.offset, (unsigned int)_resume.total);
+        break;
+      }
+      _resetDownload(true);
+      _status = UPDATE_FAIL;
       AC_DBG("update returns HTTP_UPDATE_FAILED\n");
       break;
     case HTTP_UPDATE_NO_UPDATES:
@@ -270,6 +335,7 @@ AC_UPDATESTATUS_t AutoConnectUpdateAct::update(void) {
       AC_DBG_DUMB(" No available update\n");
       break;
     case HTTP_UPDATE_OK:
+      _resetDownload(false);
       _status = UPDATE_SUCCESS;
       AC_DBG_DUMB(" completed\n");
       break;
@@ -282,6 +348,236 @@ AC_UPDATESTATUS_t AutoConnectUpdateAct::update(void) {
   return _status;
 }
 
+/**
+ * Download the updater and write it to the flash. It takes over
+ * HTTPUpdate::update with the same request headers that the update
+ * server verifies, and continues the suspended download with the Range
+ * request. The Update session, the received offset and the ETag of the
+ * updater are kept in memory while suspended, so the image is resumed
+ * unless the update server has replaced it.
+ * On the ESP32, the gzip compressed updater is inflated while being
+ * downloaded, and its x-MD5 is verified against the compressed stream.
+ * @param  client WiFiClient for the download.
+ * @param  uriBin The path of the updater on the update server.
+ * @return t_httpUpdate_return
+ */
+t_httpUpdate_return AutoConnectUpdateAct::_download(WiFiClient& client, const String& uriBin) {
+  HTTPClient  httpClient;
+  const char* headerKeys[] = { "x-MD5", "x-Inflated-Size", "ETag", "Content-Range" };
+
+  if (!httpClient.begin(client, host, port, uriBin)) {
+    _lastError = HTTPC_ERROR_CONNECTION_REFUSED;
+    return HTTP_UPDATE_FAILED;
+  }
+  httpClient.setTimeout(AUTOCONNECT_UPDATE_TIMEOUT);
+  httpClient.setUserAgent(F(AC_UPDATE_ARCH "-http-Update"));
+  httpClient.addHeader(F("x-" AC_UPDATE_ARCH "-STA-MAC"), WiFi.macAddress());
+  httpClient.addHeader(F("x-" AC_UPDATE_ARCH "-AP-MAC"), WiFi.softAPmacAddress());
+  httpClient.addHeader(F("x-" AC_UPDATE_ARCH "-free-space"), String(ESP.getFreeSketchSpace()));
+  httpClient.addHeader(F("x-" AC_UPDATE_ARCH "-sketch-size"), String(ESP.getSketchSize()));
+  httpClient.addHeader(F("x-" AC_UPDATE_ARCH "-sketch-md5"), ESP.getSketchMD5());
+  httpClient.addHeader(F("x-" AC_UPDATE_ARCH "-chip-size"), String(ESP.getFlashChipSize()));
+  httpClient.addHeader(F("x-" AC_UPDATE_ARCH "-sdk-version"), ESP.getSdkVersion());
+  httpClient.addHeader(F("x-" AC_UPDATE_ARCH "-mode"), F("sketch"));
+  if (_resume.offset) {
+    httpClient.addHeader(F("Range"), String(F("bytes=")) + String(_resume.offset) + '-');
+    if (_resume.etag.length())
+      httpClient.addHeader(F("If-Range"), _resume.etag);
+  }
+  httpClient.collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
+
+  int code = httpClient.GET();
+  if (code == HTTP_CODE_PARTIAL_CONTENT && _resume.offset) {
+    // The resumed content must begin from the offset.
+    String  range = httpClient.header(headerKeys[3]);
+    int     sep = range.indexOf('-');
+    if (sep < 0 || static_cast<size_t>(range.substring(range.indexOf(' ') + 1, sep).toInt()) != _resume.offset) {
+      AC_DBG_DUMB(" Unexpected range %s", range.c_str());
+      httpClient.end();
+      _resetDownload(true);
+      _lastError = HTTP_UE_SERVER_WRONG_HTTP_CODE;
+      return HTTP_UPDATE_FAILED;
+    }
+    AC_DBG_DUMB(" resume from %u", (unsigned int)_resume.offset);
+  }
+  else if (code == HTTP_CODE_OK) {
+    // The update server ignored the Range or has replaced the updater,
+    // the download starts over.
+    if (_resume.offset) {
+      AC_DBG_DUMB(" restart");
+      _resetDownload(true);
+    }
+    int size = httpClient.getSize();
+    if (size <= 0) {
+      httpClient.end();
+      _lastError = HTTP_UE_SERVER_NOT_REPORT_SIZE;
+      return HTTP_UPDATE_FAILED;
+    }
+    if (!_beginDownload(uriBin, static_cast<size_t>(size), httpClient.header(headerKeys[0]), httpClient.header(headerKeys[1]).toInt(), httpClient.header(headerKeys[2]))) {
+      httpClient.end();
+      return HTTP_UPDATE_FAILED;
+    }
+  }
+  else {
+    AC_DBG_DUMB(" HTTP %d", code);
+    httpClient.end();
+    if (code < 0) {
+      // The connection failure can be resumed with the next cycle.
+      _lastError = code;
+      return HTTP_UPDATE_FAILED;
+    }
+    _resetDownload(true);
+    _lastError = code == HTTP_CODE_NOT_FOUND ? HTTP_UE_SERVER_FILE_NOT_FOUND : code == HTTP_CODE_FORBIDDEN ? HTTP_UE_SERVER_FORBIDDEN : HTTP_UE_SERVER_WRONG_HTTP_CODE;
+    return HTTP_UPDATE_FAILED;
+  }
+
+  WiFiClient* stream = httpClient.getStreamPtr();
+  uint8_t buf[AUTOCONNECT_UPDATE_CHUNKSIZE];
+  bool    written = true;
+  unsigned long tm = millis();
+  while (written && _resume.offset < _resume.total && httpClient.connected()) {
+    size_t  avail = stream->available();
+    if (avail) {
+      if (avail > sizeof(buf))
+        avail = sizeof(buf);
+      if (avail > _resume.total - _resume.offset)
+        avail = _resume.total - _resume.offset;
+      int rd = stream->read(buf, avail);
+      if (rd > 0) {
+#if defined(ARDUINO_ARCH_ESP32)
+        if (_inflate) {
+          _md5.add(buf, rd);
+          written = _inflate->write(buf, rd);
+        }
+        else
+#endif
+          written = Update.write(buf, rd) == static_cast<size_t>(rd);
+        if (written)
+          _resume.offset += rd;
+        tm = millis();
+      }
+    }
+    else if (millis() - tm > AUTOCONNECT_UPDATE_TIMEOUT)
+      break;
+    else
+      delay(1);
+  }
+  httpClient.end();
+
+  if (!written) {
+    _lastError = Update.hasError() ? Update.getError() : HTTP_UE_BIN_VERIFY_HEADER_FAILED;
+    _resetDownload(true);
+    return HTTP_UPDATE_FAILED;
+  }
+  if (_resume.offset < _resume.total) {
+    // Interrupted, it remains the received offset to resume.
+    _lastError = HTTPC_ERROR_CONNECTION_LOST;
+    return HTTP_UPDATE_FAILED;
+  }
+
+#if defined(ARDUINO_ARCH_ESP32)
+  if (_inflate) {
+    _md5.calculate();
+    if (_resume.md5.length() && !_resume.md5.equalsIgnoreCase(_md5.toString())) {
+      AC_DBG_DUMB(" MD5 mismatch");
+      _resetDownload(true);
+      _lastError = HTTP_UE_SERVER_FAULTY_MD5;
+      return HTTP_UPDATE_FAILED;
+    }
+    if (!_inflate->end()) {
+      _resetDownload(true);
+      _lastError = HTTP_UE_BIN_VERIFY_HEADER_FAILED;
+      return HTTP_UPDATE_FAILED;
+    }
+    AC_DBG_DUMB(" inflated %u bytes", (unsigned int)_inflate->inflated());
+  }
+#endif
+  if (!Update.end(true)) {
+    _lastError = Update.getError();
+    _resetDownload(false);
+    return HTTP_UPDATE_FAILED;
+  }
+  _lastError = 0;
+  return HTTP_UPDATE_OK;
+}
+
+/**
+ * Start the Update session for the downloading updater and memorize
+ * it to be resumed.
+ * @param  uriBin   The path of the updater on the update server.
+ * @param  size     Size of the updater content.
+ * @param  md5      x-MD5 of the updater.
+ * @param  inflated Uncompressed size of the gzip updater, 0 if unknown.
+ * @param  etag     ETag of the updater to validate the resume.
+ * @return true     The Update session has started.
+ */
+bool AutoConnectUpdateAct::_beginDownload(const String& uriBin, const size_t size, const String& md5, const long inflated, const String& etag) {
+  size_t  imageSize = size;
+#if defined(ARDUINO_ARCH_ESP32)
+  if (_binName.endsWith(F(".gz"))) {
+    _inflate.reset(new AutoConnectInflate([](const uint8_t* buf, size_t len) {
+      return Update.write(const_cast<uint8_t*>(buf), len) == len;
+    }));
+    if (!*_inflate) {
+      _inflate.reset();
+      _lastError = HTTP_UE_TOO_LESS_SPACE;
+      return false;
+    }
+    _md5.begin();
+    imageSize = inflated > 0 ? static_cast<size_t>(inflated) : UPDATE_SIZE_UNKNOWN;
+  }
+#else
+  AC_UNUSED(inflated);
+  WiFiUDP::stopAll();
+#endif
+  // The Updater flickers the LED that is set by setLedPin.
+  if (!Update.begin(imageSize, U_FLASH, _ledPin, _ledOn)) {
+    _lastError = Update.getError();
+#if defined(ARDUINO_ARCH_ESP32)
+    _inflate.reset();
+#endif
+    return false;
+  }
+#if defined(ARDUINO_ARCH_ESP32)
+  // The x-MD5 of the gzip updater is verified for the compressed stream.
+  if (!_inflate && md5.length())
+#else
+  if (md5.length())
+#endif
+    Update.setMD5(md5.c_str());
+  _resume.uri = uriBin;
+  _resume.md5 = md5;
+  _resume.etag = etag;
+  _resume.offset = 0;
+  _resume.total = size;
+  _resume.resumed = 0;
+  return true;
+}
+
+/**
+ * Discard the download state to be resumed.
+ * @param  abort  Abort the Update session in progress.
+ */
+void AutoConnectUpdateAct::_resetDownload(const bool abort) {
+  if (abort && Update.isRunning()) {
+#if defined(ARDUINO_ARCH_ESP32)
+    Update.abort();
+#else
+    // The Updater of ESP8266 resets the session that is not finished.
+    Update.end(false);
+#endif
+  }
+#if defined(ARDUINO_ARCH_ESP32)
+  _inflate.reset();
+#endif
+  _resume.uri = String("");
+  _resume.md5 = String("");
+  _resume.etag = String("");
+  _resume.offset = 0;
+  _resume.total = 0;
+  _resume.resumed = 0;
+}
+
 /**
  * Create the update operation pages using a predefined page structure
  * with two structures as ACPage_t and ACElementProp_t which describe
@@ -297,6 +593,7 @@ void AutoConnectUpdateAct::_buildAux(AutoConnectAux* aux, const AutoConnectUpdat
   for (size_t n = 0; n < elementNum; n++) {
     if (page->element[n].type == AC_Element) {
       AutoConnectElement* element = new AutoConnectElement;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
       if (page->element[n].value)
         element->value = String(FPSTR(page->element[n].value));
@@ -304,25 +601,28 @@ void AutoConnectUpdateAct::_buildAux(AutoConnectAux* aux, const AutoConnectUpdat
     }
     else if (page->element[n].type == AC_Radio) {
       AutoConnectRadio* element = new AutoConnectRadio;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
       aux->add(reinterpret_cast<AutoConnectElement&>(*element));
     }
     else if (page->element[n].type == AC_Submit) {
       AutoConnectSubmit* element = new AutoConnectSubmit;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
       if (page->element[n].value)
         element->value = String(FPSTR(page->element[n].value));
       if (page->element[n].peculiar)
-        element->uri = String(FPSTR(page->element[n].peculiar));
+        element->uri = FPSTR(page->element[n].peculiar);
       aux->add(reinterpret_cast<AutoConnectElement&>(*element));
     }
     else if (page->element[n].type == AC_Text) {
       AutoConnectText* element = new AutoConnectText;
+      element->_native = true;
       element->name = String(FPSTR(page->element[n].name));
       if (page->element[n].value)
         element->value = String(FPSTR(page->element[n].value));
       if (page->element[n].peculiar)
-        element->format = String(FPSTR(page->element[n].peculiar));
+        element->format = FPSTR(page->element[n].peculiar);
       aux->add(reinterpret_cast<AutoConnectText&>(*element));
     }
   }
@@ -339,7 +639,11 @@ void AutoConnectUpdateAct::_buildAux(AutoConnectAux* aux, const AutoConnectUpdat
 void AutoConnectUpdateAct::_inProgress(size_t amount, size_t size) {
   _amount = amount;
   _binSize = size;
-  _webServer->handleClient();
+  // Only the update by this class pumps the web server. The progress
+  // notified by the other updater such as AutoConnectOTA may come from
+  // the outside of the loop task or inside the request handling.
+  if (_status == UPDATE_PROGRESS)
+    _webServer->handleClient();
 }
 
 /**
@@ -353,7 +657,6 @@ void AutoConnectUpdateAct::_inProgress(size_t amount, size_t size) {
  * @return         Additional string to the page but it always null.
  */
 String AutoConnectUpdateAct::_onCatalog(AutoConnectAux& catalog, PageArgument& args) {
-  AC_UNUSED(args);
   WiFiClient  wifiClient;
   HTTPClient  httpClient;
 
@@ -361,12 +664,21 @@ String AutoConnectUpdateAct::_onCatalog(AutoConnectAux& catalog, PageArgument& a
   _binName = String("");
   AutoConnectText&  caption = catalog.getElement<AutoConnectText>(String(F("caption")));
   AutoConnectRadio& firmwares = catalog.getElement<AutoConnectRadio>(String(F("firmwares")));
+  AutoConnectElement& pager = catalog.getElement<AutoConnectElement>(String(F("pager")));
   AutoConnectSubmit&  submit = catalog.getElement<AutoConnectSubmit>(String(F("update")));
   firmwares.empty();
   firmwares.tags.clear();
+  pager.value = String("");
   submit.enable = false;
 
-  String  qs = String(F(AUTOCONNECT_UPDATE_CATALOG)) + '?' + String(F("op=list&path=")) + uri;
+  // The catalog is fetched page by page. The query asks the update
+  // server one more entry than a page to know the next page exists.
+  unsigned int  offset = 0;
+  if (args.hasArg(String(F("offset"))))
+    offset = args.arg(String(F("offset"))).toInt();
+  String  qs = String(F(AUTOCONNECT_UPDATE_CATALOG "?op=list&type=bin&path=")) + AutoConnectUtil::encodeQuery(uri) + String(F("&offset=")) + String(offset) + String(F("&limit=")) + String(AUTOCONNECT_UPDATE_CATALOG_LIMIT + 1);
+  if (match.length())
+    qs += String(F("&match=")) + AutoConnectUtil::encodeQuery(match);
   AC_DBG("Query %s:%d%s\n", host.c_str(), port, qs.c_str());
 
   // Throw a query to the update server and parse the response JSON
@@ -375,67 +687,57 @@ String AutoConnectUpdateAct::_onCatalog(AutoConnectAux& catalog, PageArgument& a
   if (httpClient.begin(wifiClient, host, port, qs)) {
     int responseCode = httpClient.GET();
     if (responseCode == HTTP_CODE_OK) {
+      // The catalog is parsed entry by entry from the responded http
+      // stream, so the size of the catalog does not matter with the
+      // memory. Each entry is stored into the AutoConnectRadio as it is
+      // parsed.
+      AutoConnectCatalog  list(httpClient.getStream());
+      AutoConnectCatalog::AutoConnectCatalogST  entry;
+      static const char _binTag[] PROGMEM = "<span>%s</span><span>%.5s</span><span>%ld</span>";
+      char  tag[sizeof(_binTag) + sizeof(entry.date) + sizeof(entry.time) + 12];
+      bool  more = false;
 
-      // JsonVariant jb;
-      bool  parse;
-      char  beginOfList[] = "[";
-      char  endOfEntry[] = ",";
-      char  endOfList[] = "]";
-      WiFiClient& responseBody = httpClient.getStream();
-
-      // Read partially and repeatedly the responded http stream that is
-      // including the JSON array to reduce the buffer size for parsing
-      // of the firmware catalog list.
       AC_DBG("Update server responded:");
-      responseBody.find(beginOfList);
-      do {
-        // The size of the JSON buffer is a fixed. It can be a problem
-        // when parsing with ArduinoJson V6. If memory insufficient has
-        // occurred during the parsing, increase this buffer size.
-        ArduinoJsonStaticBuffer<AUTOCONNECT_UPDATE_CATALOG_JSONBUFFER_SIZE> jb;
-
-#if ARDUINOJSON_VERSION_MAJOR<=5
-        ArduinoJsonObject json = jb.parseObject(responseBody);
-        parse = json.success();
-#else
-        DeserializationError err = deserializeJson(jb, responseBody);
-        ArduinoJsonObject json = jb.as<JsonObject>();
-        parse = (err == DeserializationError::Ok);
-#endif
-        if (parse) {
-#ifdef AC_DEBUG
-          AC_DBG_DUMB("\n");
-          ARDUINOJSON_PRINT(json, AC_DEBUG_PORT);
-#endif
+      firmwares.order = AC_Horizontal;
+      if (list.begin()) {
+        while (list.next(entry)) {
           // Register only bin type file name as available sketch binary to
           // AutoConnectRadio value based on the response from the update server.
-          firmwares.order = AC_Horizontal;
-          if (json["type"].as<String>().equalsIgnoreCase("bin")) {
-            firmwares.add(json[F("name")].as<String>());
-            String  attr = String(F("<span>")) + json[F("date")].as<String>() + String(F("</span><span>")) + json[F("time")].as<String>().substring(0, 5) + String(F("</span><span>")) + String(json[F("size")].as<int>()) + String(F("</span>"));
-            firmwares.tags.push_back(attr);
+          if (entry.truncated || strcmp_P(entry.type, PSTR("bin")))
+            continue;
+          if (firmwares.size() >= AUTOCONNECT_UPDATE_CATALOG_LIMIT) {
+            // Leave the rest of the catalog to the next page.
+            more = true;
+            break;
           }
+          AC_DBG_DUMB(" %s", entry.name);
+          firmwares.add(String(entry.name));
+          snprintf_P(tag, sizeof(tag), _binTag, entry.date, entry.time, entry.size);
+          firmwares.tags.push_back(String(tag));
         }
-        else {
-#if ARDUINOJSON_VERSION_MAJOR<=5
-          String  errCaption = String(F("JSON parse error"));
-#else
-          String  errCaption = String(err.c_str());
-#endif
-          caption.value = String(F("Invalid catalog list:")) + errCaption;
-          AC_DBG("JSON:%s\n", errCaption.c_str());
-          break;
-        }
-      } while (responseBody.findUntil(endOfEntry, endOfList));
-
+      }
       AC_DBG_DUMB("\n");
-      if (parse) {
+
+      if (list.hasError())
+        caption.value = String(F("Invalid catalog list"));
+      else {
         if (firmwares.size()) {
           caption.value = String(F("<h4>Available firmwares</h4>"));
           submit.enable = true;
         }
         else
           caption.value = String(F("<h4>No available firmwares</h4>"));
+        // Navigate the pages of the catalog.
+        static const char _binPage[] PROGMEM = "<a href=\"" AUTOCONNECT_URI_UPDATE "?offset=%u\">%s</a>&emsp;";
+        char  link[sizeof(_binPage) + 16];
+        if (offset) {
+          snprintf_P(link, sizeof(link), _binPage, offset > AUTOCONNECT_UPDATE_CATALOG_LIMIT ? offset - AUTOCONNECT_UPDATE_CATALOG_LIMIT : 0, PSTR("Prev."));
+          pager.value += String(link);
+        }
+        if (more) {
+          snprintf_P(link, sizeof(link), _binPage, offset + AUTOCONNECT_UPDATE_CATALOG_LIMIT, PSTR("Next"));
+          pager.value += String(link);
+        }
       }
     }
     else {
@@ -560,6 +862,7 @@ void AutoConnectUpdateAct::_progress(void) {
 
   case HTTP_GET:
     switch (_status) {
+    case UPDATE_START:
     case UPDATE_PROGRESS:
       payload = String(UPDATE_NOTIFY_PROGRESS) + ',' + String(_amount) + ':' + String(_binSize); 
       httpCode = 200;
@@ -43,6 +43,8 @@ using HTTPUpdateClass = ESP8266HTTPUpdate;
 #elif defined(ARDUINO_ARCH_ESP32)
 #include <HTTPClient.h>
 #include <HTTPUpdate.h>
+#include <MD5Builder.h>
+#include "AutoConnectInflate.h"
 using HTTPUpdateClass = HTTPUpdate;
 #endif
 // #include <WebSocketsServer.h>
@@ -103,12 +105,12 @@ class AutoConnectUpdateVoid {
 class AutoConnectUpdateAct : public AutoConnectUpdateVoid, public HTTPUpdateClass {
  public:
   explicit AutoConnectUpdateAct(const String& host = String(""), const uint16_t port = AUTOCONNECT_UPDATE_PORT, const String& uri = String("."), const int timeout = AUTOCONNECT_UPDATE_TIMEOUT, const uint8_t ledOn = AUTOCONNECT_UPDATE_LEDON)
-    : HTTPUpdateClass(timeout), host(host), port(port), uri(uri), _amount(0), _binSize(0), _enable(false), _dialog(UPDATEDIALOG_LOADER), _status(UPDATE_IDLE), _binName(String()), _webServer(nullptr) {
+    : HTTPUpdateClass(timeout), host(host), port(port), uri(uri), match(String()), _amount(0), _binSize(0), _enable(false), _dialog(UPDATEDIALOG_LOADER), _status(UPDATE_IDLE), _binName(String()), _webServer(nullptr) {
     AC_SETLED(ledOn);       /**< LED blinking during the update that is the default. */
     rebootOnUpdate(false);  /**< Default reboot mode */
   }
   AutoConnectUpdateAct(AutoConnect& portal, const String& host = String(""), const uint16_t port = AUTOCONNECT_UPDATE_PORT, const String& uri = String("."), const int timeout = AUTOCONNECT_UPDATE_TIMEOUT, const uint8_t ledOn = AUTOCONNECT_UPDATE_LEDON)
-    : HTTPUpdateClass(timeout), host(host), port(port), uri(uri), _amount(0), _binSize(0), _enable(false), _dialog(UPDATEDIALOG_LOADER), _status(UPDATE_IDLE), _binName(String()), _webServer(nullptr) {
+    : HTTPUpdateClass(timeout), host(host), port(port), uri(uri), match(String()), _amount(0), _binSize(0), _enable(false), _dialog(UPDATEDIALOG_LOADER), _status(UPDATE_IDLE), _binName(String()), _webServer(nullptr) {
     AC_SETLED(ledOn);
     rebootOnUpdate(false);
     attach(portal);
@@ -125,6 +127,7 @@ class AutoConnectUpdateAct : public AutoConnectUpdateVoid, public HTTPUpdateClas
   String    host;           /**< Available URL of Update Server */
   uint16_t  port;           /**< Port number of the update server */
   String    uri;            /**< The path on the update server that contains the sketch binary to be updated */
+  String    match;          /**< A pattern of the file name to filter the catalog on the update server */
 
   // Indicate the type of progress dialog
   typedef enum {
@@ -156,6 +159,20 @@ class AutoConnectUpdateAct : public AutoConnectUpdateVoid, public HTTPUpdateClas
   String  _onUpdate(AutoConnectAux& update, PageArgument& args);
   String  _onResult(AutoConnectAux& result, PageArgument& args);
   void    _inProgress(size_t amount, size_t size);  /**< UpdateClass::THandlerFunction_Progress */
+  t_httpUpdate_return _download(WiFiClient& client, const String& uriBin);  /**< Download the updater to the flash */
+  bool    _beginDownload(const String& uriBin, const size_t size, const String& md5, const long inflated, const String& etag);
+  void    _resetDownload(const bool abort);  /**< Discard the suspended download */
+
+  // The state of the download to be resumed
+  typedef struct {
+    String  uri;                /**< The updater being downloaded */
+    String  md5;                /**< x-MD5 of the updater */
+    String  etag;               /**< ETag to validate the resume */
+    size_t  offset = 0;         /**< Received bytes */
+    size_t  total = 0;          /**< Size of the updater content */
+    uint8_t resumed = 0;        /**< Number of times resumed */
+    unsigned long suspended = 0;  /**< millis when suspended */
+  } AC_UPDATERESUME_t;
 
   std::unique_ptr<AutoConnectAux> _auxCatalog;   /**< A catalog page for internally generated update binaries */
   std::unique_ptr<AutoConnectAux> _auxProgress;  /**< An update in-progress page */  
@@ -163,6 +180,11 @@ class AutoConnectUpdateAct : public AutoConnectUpdateVoid, public HTTPUpdateClas
 
   size_t  _amount;              /**< Received amount bytes */
   size_t  _binSize;             /**< Updater binary size */
+  AC_UPDATERESUME_t _resume;    /**< Suspended download */
+#if defined(ARDUINO_ARCH_ESP32)
+  std::unique_ptr<AutoConnectInflate> _inflate; /**< Decoder for the gzip updater */
+  MD5Builder  _md5;             /**< MD5 of the compressed stream */
+#endif
 
  private:
   void    _progress(void);      /**< A Handler that returns progress status to the web client */
@@ -22,17 +22,28 @@
 /**
  * Uploader base class. This class is a wrapper for the AutoConnectUpload
  * class, and only the upload member function is implemented.
+ * It also measures the amount and the elapsed time of each upload.
  */
 class AutoConnectUploadHandler {
  public:
-  explicit AutoConnectUploadHandler() {}
+  explicit AutoConnectUploadHandler() : _amount(0), _startTime(0), _elapsed(0) {}
   virtual ~AutoConnectUploadHandler() {}
   virtual void upload(const String& requestUri, const HTTPUpload& upload);
+  size_t  amount(void) const { return _amount; }  /**< Received size of the upload */
+  unsigned long elapsed(void) const { return _elapsed ? _elapsed : (_startTime ? millis() - _startTime : 0); }  /**< Elapsed time of the upload [ms] */
+  uint32_t  throughput(void) const {              /**< Throughput of the upload [KB/s] */
+    unsigned long tm = elapsed();
+    return tm ? static_cast<uint32_t>((static_cast<uint64_t>(_amount) * 1000) / (1024 * tm)) : 0;
+  }
 
 protected:
   virtual bool   _open(const char* filename, const char* mode) = 0;
   virtual size_t _write(const uint8_t *buf, const size_t size) = 0;
   virtual void   _close(const HTTPUploadStatus status) = 0;
+
+  size_t  _amount;              /**< Received size of the upload */
+  unsigned long _startTime;     /**< millis at the upload started */
+  unsigned long _elapsed;       /**< Elapsed time of the upload completed */
 };
 
 #endif // !_AUTOCONNECTUPLOAD_H_
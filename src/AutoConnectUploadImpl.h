@@ -17,6 +17,9 @@
 #include <WiFi.h>
 #include <SPIFFS.h>
 #endif
+#include <algorithm>
+#include <memory>
+#include <new>
 #include <SPI.h>
 #include <SD.h>
 #define FS_NO_GLOBALS
@@ -66,23 +69,110 @@ void AutoConnectUploadHandler::upload(const String& requestUri, const HTTPUpload
   switch (upload.status) {
   case UPLOAD_FILE_START: {
     String  absFilename = "/" + upload.filename;
+    _amount = 0;
+    _elapsed = 0;
+    _startTime = millis();
     (void)_open(absFilename.c_str(), "w");
     break;
   }
   case UPLOAD_FILE_WRITE:
     (void)_write(upload.buf, (const size_t)upload.currentSize);
+    _amount += upload.currentSize;
     break;
   case UPLOAD_FILE_ABORTED:
   case UPLOAD_FILE_END:
     _close(upload.status);
+    _elapsed = millis() - _startTime;
+    if (!_elapsed)
+      _elapsed = 1;
+    AC_DBG("%s %u bytes in %lums, %uKB/s\n", upload.filename.c_str(), (unsigned int)_amount, _elapsed, (unsigned int)throughput());
     break;
   }
 }
 
+/**
+ * The intermediate upload handler that saves the upload to the file
+ * through the write-behind buffer. The small chunks of HTTPUpload are
+ * accumulated and written to the file in units of the buffer whose
+ * size is a multiple of the block size of the media, so that each
+ * write fills up the pages or the sectors without partial programming
+ * and read-modify-write cycles. If the buffer cannot be allocated, it
+ * writes each chunk directly.
+ * The derived class opens _file and calls _begin on the success of
+ * _open, and calls _end before closing _file.
+ */
+template<typename T>
+class AutoConnectUploadBuffer : public AutoConnectUploadHandler {
+ public:
+  explicit AutoConnectUploadBuffer(const size_t bufferSize, const size_t blockSize) : _bufferSize(((bufferSize + blockSize - 1) / blockSize) * blockSize), _fill(0) {}
+  virtual ~AutoConnectUploadBuffer() {}
+
+ protected:
+  /**
+   * Allocate the buffer for the file opened.
+   */
+  void  _begin(void) {
+    _fill = 0;
+    if (_bufferSize && !_buffer) {
+      _buffer.reset(new (std::nothrow) uint8_t[_bufferSize]);
+      if (!_buffer)
+        AC_DBG("Upload buffer %u bytes unavailable, unbuffered\n", (unsigned int)_bufferSize);
+    }
+  }
+
+  /**
+   * Flush the buffer and release it.
+   */
+  void  _end(void) {
+    (void)_flush();
+    _buffer.reset();
+  }
+
+  /**
+   * Write out the accumulated content of the buffer to the file.
+   * @return true  The buffer has been written out.
+   */
+  bool  _flush(void) {
+    bool  rc = true;
+    if (_fill && _file) {
+      size_t  wsz = _file.write(_buffer.get(), _fill);
+      rc = wsz == _fill;
+      if (!rc)
+        AC_DBG("Upload write %u/%u bytes\n", (unsigned int)wsz, (unsigned int)_fill);
+    }
+    _fill = 0;
+    return rc;
+  }
+
+  size_t  _write(const uint8_t* buf, const size_t size) override {
+    if (!_file)
+      return -1;
+    if (!_buffer)
+      return _file.write(buf, size);
+
+    size_t  wsz = 0;
+    while (wsz < size) {
+      size_t  len = std::min(size - wsz, _bufferSize - _fill);
+      memcpy(_buffer.get() + _fill, buf + wsz, len);
+      _fill += len;
+      wsz += len;
+      if (_fill >= _bufferSize && !_flush())
+        break;
+    }
+    return wsz;
+  }
+
+  T       _file;                        /**< Destination file */
+  size_t  _bufferSize;                  /**< Size of the buffer aligned to the block */
+  size_t  _fill;                        /**< Filled size of the buffer */
+  std::unique_ptr<uint8_t[]>  _buffer;  /**< Write-behind buffer */
+};
+
 // Default handler for uploading to the standard SPIFFS class embedded in the core.
-class AutoConnectUploadFS : public AutoConnectUploadHandler {
+// The buffer is aligned to the flash page of 256 bytes.
+class AutoConnectUploadFS : public AutoConnectUploadBuffer<SPIFileT> {
  public:
-  explicit AutoConnectUploadFS(SPIFFST& media) : _media(&media) {}
+  explicit AutoConnectUploadFS(SPIFFST& media, const size_t bufferSize = AUTOCONNECT_UPLOAD_FS_BUFFERSIZE) : AutoConnectUploadBuffer<SPIFileT>(bufferSize, 256), _media(&media) {}
   ~AutoConnectUploadFS() { _close(HTTPUploadStatus::UPLOAD_FILE_END); }
 
  protected:
@@ -93,21 +183,17 @@ class AutoConnectUploadFS : public AutoConnectUploadHandler {
     if (_media->begin(true)) {
 #endif
       _file = _media->open(filename, mode);
-      return _file != false;      
+      if (_file)
+        _begin();
+      return _file != false;
     }
     AC_DBG("SPIFFS mount failed\n");
     return false;
   }
 
-  size_t  _write(const uint8_t* buf, const size_t size) override {
-    if (_file)
-      return _file.write(buf, size);
-    else
-      return -1;
-  }
-
   void  _close(const HTTPUploadStatus status) override {
     AC_UNUSED(status);
+    _end();
     if (_file)
       _file.close();
     _media->end();
@@ -115,7 +201,6 @@ class AutoConnectUploadFS : public AutoConnectUploadHandler {
 
  private:
   SPIFFST*  _media;
-  SPIFileT  _file; 
 };
 
 // Fix to be compatibility with backward for ESP8266 core 2.5.1 or later
@@ -140,16 +225,25 @@ class AutoConnectUploadFS : public AutoConnectUploadHandler {
 #endif
 
 // Default handler for uploading to the standard SD class embedded in the core.
-class AutoConnectUploadSD : public AutoConnectUploadHandler {
+// The buffer is aligned to the sector of 512 bytes.
+class AutoConnectUploadSD : public AutoConnectUploadBuffer<SDFileT> {
  public:
-  explicit AutoConnectUploadSD(SDClassT& media, const uint8_t cs = AUTOCONNECT_SD_CS, const uint32_t speed = AUTOCONNECT_SD_SPEED) : _media(&media), _cs(cs), _speed(speed) {}
+  explicit AutoConnectUploadSD(SDClassT& media, const uint8_t cs = AUTOCONNECT_SD_CS, const uint32_t speed = AUTOCONNECT_SD_SPEED, const size_t bufferSize = AUTOCONNECT_UPLOAD_SD_BUFFERSIZE) : AutoConnectUploadBuffer<SDFileT>(bufferSize, 512), _media(&media), _cs(cs), _speed(speed) {}
   ~AutoConnectUploadSD() { _close(HTTPUploadStatus::UPLOAD_FILE_END); }
 
  protected:
   bool  _open(const char* filename, const char* mode) override {
     const char* sdVerify;
+    bool  mounted = _mount(_speed);
+    // The card which does not follow the higher clock is retried at
+    // the fallback speed.
+    if (!mounted && _speed > AUTOCONNECT_SD_FALLBACKSPEED) {
+      AC_DBG("SD mount failed at %uHz, retry\n", (unsigned int)_speed);
+      AutoConnectUtil::end<SDClassT>(_media);
+      mounted = _mount(AUTOCONNECT_SD_FALLBACKSPEED);
+    }
 #if defined(ARDUINO_ARCH_ESP8266)
-    if (_media->begin(_cs, AC_SD_SPEED(_speed))) {
+    if (mounted) {
       uint8_t oflag = *mode == 'w' ? FILE_WRITE : FILE_READ;
       uint8_t sdType = _media->type();      
       switch (sdType) {
@@ -167,7 +261,7 @@ class AutoConnectUploadSD : public AutoConnectUploadHandler {
         break;
       }
 #elif defined(ARDUINO_ARCH_ESP32)
-    if (_media->begin(_cs, SPI, _speed)) {
+    if (mounted) {
       const char* oflag = mode;
       uint8_t sdType = _media->cardType();
       switch (sdType) {
@@ -193,29 +287,37 @@ class AutoConnectUploadSD : public AutoConnectUploadHandler {
 #endif
       AC_DBG("%s mounted\n", sdVerify);
       _file = _media->open(filename, oflag);
+      if (_file)
+        _begin();
       return _file != false;
     }
     AC_DBG("SD mount failed\n");
     return false;
   }
 
-  size_t  _write(const uint8_t* buf, const size_t size) override {
-    if (_file)
-      return _file.write(buf, size);
-    else
-      return -1;
-  }
-
   void  _close(const HTTPUploadStatus status) override {
     AC_UNUSED(status);
+    _end();
     if (_file)
       _file.close();
     AutoConnectUtil::end<SDClassT>(_media);
   }
 
+  /**
+   * Mount the SD at the specified SPI clock.
+   * @param  speed  SPI clock [Hz]
+   * @return true   SD mounted.
+   */
+  bool  _mount(const uint32_t speed) {
+#if defined(ARDUINO_ARCH_ESP8266)
+    return _media->begin(_cs, AC_SD_SPEED(speed));
+#elif defined(ARDUINO_ARCH_ESP32)
+    return _media->begin(_cs, SPI, speed);
+#endif
+  }
+
  private:
   SDClassT* _media;
-  SDFileT   _file;
   uint8_t   _cs;
   uint32_t  _speed;
 };
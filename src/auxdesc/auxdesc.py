@@ -0,0 +1,233 @@
+#!python3.*
+
+"""Converts the AutoConnectAux JSON document into the descriptors.
+"""
+
+from __future__ import print_function
+
+import argparse
+import io
+import json
+import os
+import re
+import sys
+
+# C symbols for the type of AutoConnectElements, case-insensitive
+ELEMENT_TYPES = {
+    'acbutton': 'AC_Button',
+    'accheckbox': 'AC_Checkbox',
+    'acelement': 'AC_Element',
+    'acfile': 'AC_File',
+    'acinput': 'AC_Input',
+    'acradio': 'AC_Radio',
+    'acselect': 'AC_Select',
+    'acstyle': 'AC_Style',
+    'acsubmit': 'AC_Submit',
+    'actext': 'AC_Text'
+}
+
+# The element types which generate <br> as the default posterior
+POSTERIOR_BR = ('AC_Checkbox', 'AC_File', 'AC_Input', 'AC_Radio', 'AC_Select')
+
+POSTERIOR = {'none': 'AC_Tag_None', 'br': 'AC_Tag_BR', 'par': 'AC_Tag_P'}
+ARRANGE = {'horizontal': 'AC_Horizontal', 'vertical': 'AC_Vertical'}
+LABELPOSITION = {'infront': 'AC_Infront', 'behind': 'AC_Behind'}
+STORE = {'fs': 'AC_File_FS', 'sd': 'AC_File_SD', 'extern': 'AC_File_Extern'}
+
+
+class AuxDescError(Exception):
+    pass
+
+
+class StringPool:
+    # Places each distinct string in PROGMEM only once.
+    def __init__(self, prefix):
+        self.prefix = prefix
+        self.strings = []
+        self.index = {}
+
+    def ref(self, s):
+        if s is None:
+            return 'nullptr'
+        if s not in self.index:
+            self.index[s] = '{0}_s{1}'.format(self.prefix, len(self.strings))
+            self.strings.append(s)
+        return self.index[s]
+
+    def declare(self):
+        return ['static const char {0}[] PROGMEM = {1};'.format(self.index[s], c_string(s)) for s in self.strings]
+
+
+def c_string(s):
+    # Escapes the string as the C literal. The non-ASCII characters are
+    # written in the octal of UTF-8 not to be joined to the followings.
+    out = ['"']
+    for b in bytearray(s.encode('utf-8')):
+        c = chr(b)
+        if c in '"\\':
+            out.append('\\' + c)
+        elif c == '\n':
+            out.append('\\n')
+        elif c == '\r':
+            out.append('\\r')
+        elif c == '\t':
+            out.append('\\t')
+        elif 0x20 <= b < 0x7f:
+            out.append(c)
+        else:
+            out.append('\\{0:03o}'.format(b))
+    out.append('"')
+    return ''.join(out)
+
+
+def lookup(table, value, key, name):
+    try:
+        return table[str(value).lower()]
+    except KeyError:
+        raise AuxDescError('{0}: unknown {1} "{2}"'.format(name, key, value))
+
+
+def text(value):
+    if value is None:
+        return None
+    if isinstance(value, bool):
+        return 'true' if value else 'false'
+    return u'{0}'.format(value)
+
+
+def items(element, key, name):
+    values = element.get(key)
+    if values is None:
+        return None
+    if not isinstance(values, list):
+        values = [values]
+    values = [text(v) for v in values]
+    for v in values:
+        if '\n' in v:
+            raise AuxDescError('{0}: {1} must not contain the newline'.format(name, key))
+    return '\n'.join(values)
+
+
+def element_desc(element, pool):
+    # Returns the initializer of ACElementDesc_t according to AutoConnectAux::_loadElement.
+    name = element.get('name')
+    if not name:
+        raise AuxDescError('element name missing')
+    # The unknown type is loaded as ACElement as well as AutoConnectAux::_createElement.
+    etype = ELEMENT_TYPES.get(str(element.get('type', 'ACElement')).lower())
+    if not etype:
+        print('{0}: unknown element type "{1}", as ACElement'.format(name, element.get('type')), file=sys.stderr)
+        etype = 'AC_Element'
+
+    value = text(element.get('value'))
+    label = text(element.get('label'))
+    pattern = None
+    placeholder = None
+    checked = '0'
+    arrange = '0'
+    if etype == 'AC_Button':
+        label = text(element.get('action'))
+    elif etype == 'AC_Checkbox':
+        checked = 'true' if element.get('checked', False) else 'false'
+        arrange = lookup(LABELPOSITION, element.get('labelposition', 'behind'), 'labelposition', name)
+    elif etype == 'AC_File':
+        arrange = lookup(STORE, element.get('store', 'fs'), 'store', name)
+    elif etype == 'AC_Input':
+        pattern = text(element.get('pattern'))
+        placeholder = text(element.get('placeholder'))
+    elif etype == 'AC_Radio':
+        value = items(element, 'value', name)
+        checked = str(int(element.get('checked', 0)))
+        arrange = lookup(ARRANGE, element.get('arrange', 'vertical'), 'arrange', name)
+    elif etype == 'AC_Select':
+        value = items(element, 'option', name)
+        checked = str(int(element.get('selected', 0)))
+    elif etype == 'AC_Submit':
+        label = text(element.get('uri'))
+    elif etype == 'AC_Text':
+        label = text(element.get('style'))
+        pattern = text(element.get('format'))
+    elif etype in ('AC_Element', 'AC_Style'):
+        label = None
+
+    post = lookup(POSTERIOR, element['posterior'], 'posterior', name) if 'posterior' in element else ('AC_Tag_BR' if etype in POSTERIOR_BR else 'AC_Tag_None')
+    if etype == 'AC_Style':
+        post = 'AC_Tag_None'
+    glob = 'true' if element.get('global', False) else 'false'
+    return '{{ {0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9} }}'.format(
+        etype, pool.ref(text(name)), pool.ref(value), pool.ref(label), pool.ref(pattern), pool.ref(placeholder), checked, arrange, post, glob)
+
+
+def symbol(s):
+    sym = re.sub(r'[^0-9A-Za-z_]', '_', s).strip('_')
+    if not sym or sym[0].isdigit():
+        sym = 'aux_' + sym
+    return sym
+
+
+def convert(pages, prefix, source):
+    if isinstance(pages, dict):
+        pages = [pages]
+    pool = StringPool(prefix)
+    body = []
+    names = []
+    for n, page in enumerate(pages):
+        if not isinstance(page, dict) or 'uri' not in page:
+            raise AuxDescError('page {0}: uri missing'.format(n))
+        sym = prefix if len(pages) == 1 else '{0}_{1}'.format(prefix, symbol(page['uri']))
+        elements = page.get('element', [])
+        if isinstance(elements, dict):
+            elements = [elements]
+        if not elements:
+            raise AuxDescError('{0}: no element'.format(page['uri']))
+        body.append('static const ACElementDesc_t {0}_elements[] PROGMEM = {{'.format(sym))
+        body.append(',\n'.join('  ' + element_desc(e, pool) for e in elements))
+        body.append('};')
+        body.append('static const ACPageDesc_t {0} PROGMEM = ACPageDesc({1}, {2}, {3}, {0}_elements);'.format(
+            sym, pool.ref(text(page['uri'])), pool.ref(text(page.get('title', ''))), 'true' if page.get('menu', True) else 'false', sym))
+        body.append('')
+        names.append(sym)
+    guard = '_{0}_H_'.format(prefix.upper())
+    out = ['// Generated by auxdesc.py from {0}, do not edit.'.format(os.path.basename(source)),
+           '#ifndef {0}'.format(guard),
+           '#define {0}'.format(guard),
+           '',
+           '#include <AutoConnect.h>',
+           '']
+    out += pool.declare()
+    out.append('')
+    out += body
+    if len(names) > 1:
+        out.append('static const ACPageDesc_t {0}_pages[] PROGMEM = {{'.format(prefix))
+        out.append(',\n'.join('  ACPageDesc({0}, {1}, {2}, {3}_elements)'.format(
+            pool.ref(text(p['uri'])), pool.ref(text(p.get('title', ''))), 'true' if p.get('menu', True) else 'false', s) for p, s in zip(pages, names)))
+        out.append('};')
+        out.append('')
+    out.append('#endif // !{0}'.format(guard))
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Converts the AutoConnectAux JSON document into the descriptors.')
+    parser.add_argument('json', help='JSON document of AutoConnectAux')
+    parser.add_argument('--output', '-o', help='Output header file (Default: standard output)')
+    parser.add_argument('--prefix', '-p', help='Prefix of the generated symbols (Default: the JSON file name)')
+    args = parser.parse_args()
+
+    prefix = symbol(args.prefix or os.path.splitext(os.path.basename(args.json))[0])
+    try:
+        with io.open(args.json, encoding='utf-8') as f:
+            pages = json.load(f)
+        header = convert(pages, prefix, args.json)
+    except (IOError, ValueError, AuxDescError) as ex:
+        print('{0}: {1}'.format(args.json, ex), file=sys.stderr)
+        sys.exit(1)
+    if args.output:
+        with io.open(args.output, 'w', encoding='utf-8') as f:
+            f.write(header if isinstance(header, type(u'')) else header.decode('utf-8'))
+    else:
+        sys.stdout.write(header)
+
+
+if __name__ == '__main__':
+    main()
@@ -4,6 +4,8 @@
 """
 
 import argparse
+import fnmatch
+import gzip
 import hashlib
 import http.server
 import json
@@ -11,14 +13,28 @@ import logging
 import os
 import re
 import socket
+import socketserver
+import struct
+import threading
 import time
 import urllib.parse
 
+# Size of the chunk to send the binary sketch file
+CHUNK_SIZE = 64 * 1024
+
+
+class ThreadingHTTPServer(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    # Serves each request with its own thread so that the devices updating
+    # at once do not wait for each other. Python 3.7 or later has it as
+    # http.server.ThreadingHTTPServer.
+    daemon_threads = True
+
+
 class UpdateHttpServer:
     def __init__(self, port, bind, catalog_dir):
         def handler(*args):
             UpdateHTTPRequestHandler(catalog_dir, *args)
-        httpd = http.server.HTTPServer((bind, port), handler)
+        httpd = ThreadingHTTPServer((bind, port), handler)
         sa = httpd.socket.getsockname()
         logger.info('http server starting {0}:{1} {2}'.format(sa[0], sa[1], catalog_dir))
         try:
@@ -39,17 +55,22 @@ class UpdateHTTPRequestHandler(http.server.BaseHTTPRequestHandler):
             err = ''
             query = urllib.parse.urlparse(self.path).query
             try:
-                op = urllib.parse.parse_qs(query)['op'][0]
+                qs = urllib.parse.parse_qs(query)
+                op = qs['op'][0]
                 if op == 'list':
-                    try:
-                        path = urllib.parse.parse_qs(query)['path'][0]
-                    except KeyError:
-                        path = '.'
-                    self.__send_dir(path)
+                    path = qs.get('path', ['.'])[0]
+                    offset = max(0, int(qs.get('offset', ['0'])[0]))
+                    limit = int(qs.get('limit', ['0'])[0])
+                    match = qs.get('match', [None])[0]
+                    ftype = qs.get('type', [None])[0]
+                    self.__send_dir(path, offset, limit, match, ftype)
                     result = True
                 else:
                     err = '{0} unknown operation'.format(op)
                     result = False
+            except ValueError:
+                err = '{0} invalid paging'.format(self.path)
+                result = False
             except KeyError:
                 err = '{0} invaid catalog request'.format(self.path)
                 result = False
@@ -58,17 +79,17 @@ class UpdateHTTPRequestHandler(http.server.BaseHTTPRequestHandler):
                 self.send_response(http.HTTPStatus.FORBIDDEN, err)
                 self.end_headers()
         else:
-            self.__send_file(self.path)
+            self.__send_file(request_path.path)
 
     def __check_header(self):
         ex_headers_templ = ['x-*-STA-MAC', 'x-*-AP-MAC', 'x-*-FREE-SPACE', 'x-*-SKETCH-SIZE', 'x-*-SKETCH-MD5', 'x-*-CHIP-SIZE', 'x-*-SDK-VERSION']
         ex_headers = []
-        ua = re.match('(ESP8266|ESP32)-http-Update', self.headers.get('User-Agent'))
+        ua = re.match('(ESP8266|ESP32)-http-Update', self.headers.get('User-Agent', ''))
         if ua:
             arch = ua.group().split('-')[0]
             ex_headers = list(map(lambda x: x.replace('*', arch), ex_headers_templ))
         else:
-            logger.info('User-Agent {0} is not HTTPUpdate'.format(ua))
+            logger.info('User-Agent {0} is not HTTPUpdate'.format(self.headers.get('User-Agent')))
             return False
         for ex_header in ex_headers:
             if ex_header not in self.headers:
@@ -76,81 +97,252 @@ class UpdateHTTPRequestHandler(http.server.BaseHTTPRequestHandler):
                 return False
         return True
 
+    def __resolve(self, path):
+        # Confine the requested path within the catalog directory.
+        root = os.path.realpath(self.catalog_dir)
+        resolved = os.path.realpath(os.path.join(root, path.lstrip('/')))
+        if resolved != root and not resolved.startswith(root + os.sep):
+            return None
+        return resolved
+
     def __send_file(self, path):
         if not self.__check_header():
             self.send_response(http.HTTPStatus.FORBIDDEN, 'The request available only from ESP8266 or ESP32 http updater.')
             self.end_headers()
             return
 
-        filename = os.path.join(self.catalog_dir, path.lstrip('/'))
+        filename = self.__resolve(path)
         logger.debug('Request file:{0}'.format(filename))
+        if not filename or not os.path.isfile(filename):
+            self.send_response(http.HTTPStatus.NOT_FOUND)
+            self.end_headers()
+            return
         try:
-            fsize = os.path.getsize(filename)
-            self.send_response(http.HTTPStatus.OK)
+            info = catalog_cache.file(filename)
+            fsize = info['size']
+            etag = '"{0}"'.format(info['md5'])
+            start, end = 0, fsize - 1
+            partial = False
+            # The Range request resumes the interrupted transfer, unless
+            # the file has been replaced since then.
+            byte_range = self.headers.get('Range')
+            if_range = self.headers.get('If-Range')
+            if byte_range and (not if_range or if_range == etag):
+                r = parse_range(byte_range, fsize)
+                if r is False:
+                    self.send_response(http.HTTPStatus.REQUESTED_RANGE_NOT_SATISFIABLE)
+                    self.send_header('Content-Range', 'bytes */{0}'.format(fsize))
+                    self.end_headers()
+                    return
+                if r:
+                    start, end = r
+                    partial = True
+            if partial:
+                self.send_response(http.HTTPStatus.PARTIAL_CONTENT)
+                self.send_header('Content-Range', 'bytes {0}-{1}/{2}'.format(start, end, fsize))
+            else:
+                self.send_response(http.HTTPStatus.OK)
             self.send_header('Content-Type', 'application/octet-stream')
             self.send_header('Content-Disposition', 'attachment; filename=' + os.path.basename(filename))
-            self.send_header('Content-Length', fsize)
-            self.send_header('x-MD5', get_MD5(filename))
+            self.send_header('Content-Length', end - start + 1)
+            self.send_header('Accept-Ranges', 'bytes')
+            self.send_header('ETag', etag)
+            self.send_header('x-MD5', info['md5'])
+            image = info['image']
+            if image and image[0]:
+                self.send_header('x-Inflated-Size', image[1])
             self.end_headers()
-            f = open(filename, 'rb')
-            self.wfile.write(f.read())
-            f.close()
+            with open(filename, 'rb') as f:
+                f.seek(start)
+                remain = end - start + 1
+                while remain > 0:
+                    chunk = f.read(min(CHUNK_SIZE, remain))
+                    if not chunk:
+                        break
+                    self.wfile.write(chunk)
+                    remain -= len(chunk)
+        except (ConnectionError, socket.timeout) as e:
+            logger.info('{0} transfer interrupted: {1}'.format(filename, str(e)))
         except Exception as e:
             err = str(e)
             logger.error(err)
             self.send_response(http.HTTPStatus.INTERNAL_SERVER_ERROR, err)
             self.end_headers()
 
-    def __send_dir(self, path):
-        content = dir_json(path)
+    def __send_dir(self, path, offset=0, limit=0, match=None, ftype=None):
+        dirname = self.__resolve(path)
+        if not dirname or not os.path.isdir(dirname):
+            self.send_response(http.HTTPStatus.NOT_FOUND)
+            self.end_headers()
+            return
+        content = catalog_cache.listing(dirname)
+        if match:
+            content = [e for e in content if fnmatch.fnmatch(e['name'], match)]
+        if ftype:
+            content = [e for e in content if e['type'] == ftype]
+        # Paging applies after filtered, 0 of the limit means no limit.
+        content = content[offset:offset + limit] if limit > 0 else content[offset:]
         d = json.dumps(content).encode('UTF-8', 'replace')
         logger.debug(d)
+        # The unchanged catalog is answered with 304 to the client that
+        # holds the same ETag.
+        etag = '"{0}"'.format(hashlib.md5(d).hexdigest())
+        if etag_match(self.headers.get('If-None-Match'), etag):
+            self.send_response(http.HTTPStatus.NOT_MODIFIED)
+            self.send_header('ETag', etag)
+            self.end_headers()
+            return
         self.send_response(http.HTTPStatus.OK)
         self.send_header('Content-Type', 'application/json')
         self.send_header('Content-Length', str(len(d)))
+        self.send_header('ETag', etag)
         self.end_headers()
         self.wfile.write(d)
 
 
-def dir_json(path):
+class CatalogCache:
+    # Caches the directory listing, the examination of the sketch binary
+    # and the MD5 digest of each file. A cached item is invalidated as the
+    # mtime or the size of the file changes, and the listing is rebuilt
+    # when any entry of the directory is added, removed or replaced.
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.dirs = {}
+        self.files = {}
+
+    def file(self, filename):
+        st = os.stat(filename)
+        stamp = (st.st_mtime, st.st_size)
+        with self.lock:
+            cached = self.files.get(filename)
+        if cached and cached['stamp'] == stamp:
+            return cached
+        info = {'stamp': stamp, 'mtime': st.st_mtime, 'size': st.st_size, 'image': get_image(filename), 'md5': get_MD5(filename)}
+        with self.lock:
+            self.files[filename] = info
+        return info
+
+    def listing(self, path):
+        names = sorted(os.listdir(path))
+        signature = []
+        for name in names:
+            try:
+                st = os.stat(os.path.join(path, name))
+                signature.append((name, st.st_mtime, st.st_size))
+            except OSError:
+                pass
+        signature = tuple(signature)
+        with self.lock:
+            cached = self.dirs.get(path)
+        if cached and cached[0] == signature:
+            return cached[1]
+        content = dir_json(path, self)
+        with self.lock:
+            self.dirs[path] = (signature, content)
+        logger.debug('Catalog {0} rebuilt'.format(path))
+        return content
+
+
+def dir_json(path, cache=None):
+    # The entries are sorted by name to keep the order across the pages.
     d = list()
-    for entry in os.listdir(path):
+    for entry in sorted(os.listdir(path)):
         e = {'name': entry}
-        if os.path.isdir(entry):
+        fn = os.path.join(path, entry)
+        if os.path.isdir(fn):
             e['type'] = "directory"
         else:
             e['type'] = "file"
-            if os.path.splitext(entry)[1] == '.bin':
-                fn = os.path.join(path, entry)
+            if entry.endswith('.bin') or entry.endswith('.bin.gz'):
                 try:
-                    f = open(fn, 'rb')
-                    c = f.read(1)
-                    f.close()
-                except Exception as e:
-                    logger.info(str(e))
-                    c = b'\x00'
-                if c == b'\xe9':
+                    image = cache.file(fn)['image'] if cache else get_image(fn)
+                except OSError as ex:
+                    logger.info(str(ex))
+                    image = None
+                if image:
                     e['type'] = "bin"
                     mtime = os.path.getmtime(fn);
                     e['date'] = time.strftime('%x', time.localtime(mtime))
                     e['time'] = time.strftime('%X', time.localtime(mtime))
                     e['size'] = os.path.getsize(fn)
+                    if image[0]:
+                        e['compression'] = image[0]
+                        e['original'] = image[1]
         d.append(e)
     return d
 
 
-def get_MD5(filename):
+def etag_match(if_none_match, etag):
+    if not if_none_match:
+        return False
+    if if_none_match.strip() == '*':
+        return True
+    tags = [t.strip() for t in if_none_match.split(',')]
+    return etag in tags or 'W/' + etag in tags
+
+
+def parse_range(byte_range, fsize):
+    # Parse a single range of the Range header. Returns a tuple of the
+    # first and the last byte position, False if unsatisfiable, None if
+    # the header should be ignored such as the multiple ranges.
+    m = re.match(r'^\s*bytes\s*=\s*(\d*)\s*-\s*(\d*)\s*$', byte_range)
+    if not m or (not m.group(1) and not m.group(2)):
+        return None
+    if m.group(1):
+        start = int(m.group(1))
+        end = int(m.group(2)) if m.group(2) else fsize - 1
+        if start >= fsize or end < start:
+            return False
+        return (start, min(end, fsize - 1))
+    # The suffix range means the last bytes.
+    suffix = int(m.group(2))
+    if suffix == 0:
+        return False
+    return (max(0, fsize - suffix), fsize - 1)
+
+
+def get_image(filename):
+    # Examine the file is a sketch binary, which begins with the magic
+    # 0xe9 as it is or inside the gzip. Returns a tuple of the compression
+    # and the uncompressed size, None if it is not a sketch binary.
     try:
         f = open(filename, 'rb')
-        bin_file = f.read()
+        c = f.read(2)
+        if c[:1] == b'\xe9':
+            f.close()
+            return ('', os.path.getsize(filename))
+        if c != b'\x1f\x8b':
+            f.close()
+            return None
+        # ISIZE of the gzip trailer holds the uncompressed size.
+        f.seek(-4, os.SEEK_END)
+        isize = struct.unpack('<I', f.read(4))[0]
+        f.close()
+        f = gzip.open(filename, 'rb')
+        c = f.read(1)
         f.close()
-        md5 = hashlib.md5(bin_file).hexdigest()
-        return md5
+        if c == b'\xe9':
+            return ('gzip', isize)
+    except Exception as e:
+        logger.info(str(e))
+    return None
+
+
+def get_MD5(filename):
+    try:
+        md5 = hashlib.md5()
+        with open(filename, 'rb') as f:
+            for chunk in iter(lambda: f.read(CHUNK_SIZE), b''):
+                md5.update(chunk)
+        return md5.hexdigest()
     except Exception as e:
         logger.error(str(e))
         return None
 
 
+catalog_cache = CatalogCache()
+
+
 def run(port=8000, bind='127.0.0.1', catalog_dir='', log_level=logging.INFO):
     logging.basicConfig(level=log_level)
     UpdateHttpServer(port, bind, catalog_dir)